@@ -0,0 +1,187 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "filter_bank.h"
+
+
+#define BIQUAD_COEFFICIENTS_NUMBER 5
+
+enum { FILTER_FIR, FILTER_BIQUAD };
+
+struct _FilterBankData
+{
+  int type;
+  size_t channelsNumber;
+  double* coefficientsList;
+  size_t coefficientsNumber;        // Taps number (FIR) or sections number (biquad)
+  double* stateArray;               // Past inputs (FIR) or section delays (biquad), each state slot contiguous over channels
+  size_t stateHead;                 // Slot of the most recent input, on FIR circular history
+  double* inputArray;               // Current sample of all channels
+  double* outputArray;
+};
+
+
+static FilterBank CreateFilterBank( int type, size_t channelsNumber, double* coefficientsList, size_t coefficientsNumber, size_t statesNumber )
+{
+  if( coefficientsList == NULL || coefficientsNumber == 0 || channelsNumber == 0 || channelsNumber > MATRIX_SIZE_MAX ) return NULL;
+  
+  FilterBank newFilterBank = (FilterBank) calloc( 1, sizeof(FilterBankData) );
+  if( newFilterBank == NULL ) return NULL;
+  
+  newFilterBank->type = type;
+  newFilterBank->channelsNumber = channelsNumber;
+  newFilterBank->coefficientsNumber = ( type == FILTER_BIQUAD ) ? coefficientsNumber / BIQUAD_COEFFICIENTS_NUMBER : coefficientsNumber;
+  newFilterBank->coefficientsList = (double*) malloc( coefficientsNumber * sizeof(double) );
+  newFilterBank->stateArray = (double*) calloc( statesNumber * channelsNumber + 1, sizeof(double) );
+  newFilterBank->inputArray = (double*) malloc( channelsNumber * sizeof(double) );
+  newFilterBank->outputArray = (double*) malloc( channelsNumber * sizeof(double) );
+  
+  if( newFilterBank->coefficientsList == NULL || newFilterBank->stateArray == NULL || newFilterBank->inputArray == NULL || newFilterBank->outputArray == NULL )
+  {
+    FilterBank_Discard( newFilterBank );
+    return NULL;
+  }
+  
+  memcpy( newFilterBank->coefficientsList, coefficientsList, coefficientsNumber * sizeof(double) );
+  
+  return newFilterBank;
+}
+
+FilterBank FilterBank_CreateFIR( size_t channelsNumber, double* coefficientsList, size_t coefficientsNumber )
+{
+  // History of previous inputs, for all taps except the current one
+  return CreateFilterBank( FILTER_FIR, channelsNumber, coefficientsList, coefficientsNumber, ( coefficientsNumber > 0 ) ? coefficientsNumber - 1 : 0 );
+}
+
+FilterBank FilterBank_CreateBiquad( size_t channelsNumber, double* coefficientsList, size_t sectionsNumber )
+{
+  // 2 delay elements for each (transposed direct form II) section
+  return CreateFilterBank( FILTER_BIQUAD, channelsNumber, coefficientsList, sectionsNumber * BIQUAD_COEFFICIENTS_NUMBER, 2 * sectionsNumber );
+}
+
+void FilterBank_Discard( FilterBank filterBank )
+{
+  if( filterBank == NULL ) return;
+  
+  free( filterBank->coefficientsList );
+  free( filterBank->stateArray );
+  free( filterBank->inputArray );
+  free( filterBank->outputArray );
+  
+  free( filterBank );
+}
+
+void FilterBank_Reset( FilterBank filterBank )
+{
+  if( filterBank == NULL ) return;
+  
+  size_t statesNumber = ( filterBank->type == FILTER_BIQUAD ) ? 2 * filterBank->coefficientsNumber : filterBank->coefficientsNumber - 1;
+  memset( filterBank->stateArray, 0, statesNumber * filterBank->channelsNumber * sizeof(double) );
+  filterBank->stateHead = 0;
+}
+
+// All kernels process one sample of every channel at a time, with inner loops over (contiguous) channels
+
+static void FilterSampleFIR( FilterBank filterBank )
+{
+  size_t channelsNumber = filterBank->channelsNumber;
+  size_t historyLength = filterBank->coefficientsNumber - 1;
+  const double* input = filterBank->inputArray;
+  double* output = filterBank->outputArray;
+  
+  double currentCoefficient = filterBank->coefficientsList[ 0 ];
+  for( size_t channel = 0; channel < channelsNumber; channel++ )
+    output[ channel ] = currentCoefficient * input[ channel ];
+  
+  // Circular history: slot for delay k is ( head + k - 1 ) mod length, avoiding shifting of past samples
+  for( size_t delay = 1; delay <= historyLength; delay++ )
+  {
+    double coefficient = filterBank->coefficientsList[ delay ];
+    const double* delayedInput = filterBank->stateArray + ( ( filterBank->stateHead + delay - 1 ) % historyLength ) * channelsNumber;
+    for( size_t channel = 0; channel < channelsNumber; channel++ )
+      output[ channel ] += coefficient * delayedInput[ channel ];
+  }
+  
+  if( historyLength > 0 )
+  {
+    // Current input becomes delay 1, overwriting the oldest one
+    filterBank->stateHead = ( filterBank->stateHead + historyLength - 1 ) % historyLength;
+    memcpy( filterBank->stateArray + filterBank->stateHead * channelsNumber, input, channelsNumber * sizeof(double) );
+  }
+}
+
+static void FilterSampleBiquad( FilterBank filterBank )
+{
+  size_t channelsNumber = filterBank->channelsNumber;
+  double* signal = filterBank->outputArray;
+  
+  memcpy( signal, filterBank->inputArray, channelsNumber * sizeof(double) );
+  
+  // Transposed direct form II sections, each one filtering the previous section output in place
+  for( size_t section = 0; section < filterBank->coefficientsNumber; section++ )
+  {
+    const double* coefficients = filterBank->coefficientsList + section * BIQUAD_COEFFICIENTS_NUMBER;
+    double b0 = coefficients[ 0 ], b1 = coefficients[ 1 ], b2 = coefficients[ 2 ], a1 = coefficients[ 3 ], a2 = coefficients[ 4 ];
+    double* delay_1 = filterBank->stateArray + 2 * section * channelsNumber;
+    double* delay_2 = delay_1 + channelsNumber;
+    for( size_t channel = 0; channel < channelsNumber; channel++ )
+    {
+      double input = signal[ channel ];
+      double output = b0 * input + delay_1[ channel ];
+      delay_1[ channel ] = b1 * input - a1 * output + delay_2[ channel ];
+      delay_2[ channel ] = b2 * input - a2 * output;
+      signal[ channel ] = output;
+    }
+  }
+}
+
+Matrix FilterBank_Process( FilterBank filterBank, Matrix input, char axis, Matrix output )
+{
+  if( filterBank == NULL || input == NULL || output == NULL ) return NULL;
+  
+  bool isRowChannels = ( axis == MATRIX_ALONG_ROWS );
+  if( !isRowChannels && axis != MATRIX_ALONG_COLUMNS ) return NULL;
+  
+  size_t channelsNumber = isRowChannels ? Mat_GetHeight( input ) : Mat_GetWidth( input );
+  size_t samplesNumber = isRowChannels ? Mat_GetWidth( input ) : Mat_GetHeight( input );
+  if( channelsNumber != filterBank->channelsNumber ) return NULL;
+  
+  if( output != input && ( Mat_GetHeight( output ) != Mat_GetHeight( input ) || Mat_GetWidth( output ) != Mat_GetWidth( input ) ) ) return NULL;
+  
+  // Samples of channels stored in rows are contiguous columns of the internal column-major storage
+  for( size_t sample = 0; sample < samplesNumber; sample++ )
+  {
+    if( isRowChannels ) Mat_GetColumn( input, sample, filterBank->inputArray );
+    else Mat_GetRow( input, sample, filterBank->inputArray );
+    
+    if( filterBank->type == FILTER_FIR ) FilterSampleFIR( filterBank );
+    else FilterSampleBiquad( filterBank );
+    
+    if( isRowChannels ) Mat_SetColumn( output, sample, filterBank->outputArray );
+    else Mat_SetRow( output, sample, filterBank->outputArray );
+  }
+  
+  return output;
+}
@@ -0,0 +1,65 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file filter_bank.h
+/// @brief Bank of identical digital (FIR or IIR biquad cascade) filters applied independently to each channel of a signals matrix
+
+#ifndef FILTER_BANK_H
+#define FILTER_BANK_H
+
+#include "matrix.h"
+
+typedef struct _FilterBankData FilterBankData;    ///< Filter bank internal data structure
+typedef FilterBankData* FilterBank;               ///< Opaque reference to filter bank data structure
+
+
+/// @brief Creates bank of finite impulse response (FIR) filters, y[ n ] = sum_k b[ k ] x x[ n - k ], with zeroed state
+/// @param[in] channelsNumber number of independently filtered channels
+/// @param[in] coefficientsList array of filter coefficients b[ k ], in increasing delay order
+/// @param[in] coefficientsNumber number of filter coefficients (taps)
+/// @return reference/pointer to allocated filter bank (NULL on errors or if channels number is greater than MATRIX_SIZE_MAX)
+FilterBank FilterBank_CreateFIR( size_t channelsNumber, double* coefficientsList, size_t coefficientsNumber );
+
+/// @brief Creates bank of infinite impulse response (IIR) filters, as cascades of second order sections (biquads), with zeroed state
+/// @param[in] channelsNumber number of independently filtered channels
+/// @param[in] coefficientsList array of normalized coefficients { b0, b1, b2, a1, a2 } of each section, for H(z) = ( b0 + b1 z^-1 + b2 z^-2 ) / ( 1 + a1 z^-1 + a2 z^-2 )
+/// @param[in] sectionsNumber number of cascaded sections (5 coefficients each)
+/// @return reference/pointer to allocated filter bank (NULL on errors or if channels number is greater than MATRIX_SIZE_MAX)
+FilterBank FilterBank_CreateBiquad( size_t channelsNumber, double* coefficientsList, size_t sectionsNumber );
+
+/// @brief Destroys/deallocates memory of filter bank
+/// @param[in] filterBank reference to filter bank to be destroyed/deallocated
+void FilterBank_Discard( FilterBank filterBank );
+
+/// @brief Clears internal state (past inputs/outputs) of all filter channels
+/// @param[in] filterBank reference to filter bank
+void FilterBank_Reset( FilterBank filterBank );
+
+/// @brief Filters block of samples of all channels, keeping state for the next call (no allocations)
+/// @param[in] filterBank reference to filter bank
+/// @param[in] input reference to signals matrix (channels x samples for MATRIX_ALONG_ROWS, samples x channels for MATRIX_ALONG_COLUMNS)
+/// @param[in] axis direction of time in the signals matrix (MATRIX_ALONG_ROWS: each row is a channel, MATRIX_ALONG_COLUMNS: each column is a channel)
+/// @param[in] output preallocated matrix to store the filtered signals (can be the same as the input one)
+/// @return reference/pointer to filtered @a output matrix (NULL on errors or channels number mismatch)
+Matrix FilterBank_Process( FilterBank filterBank, Matrix input, char axis, Matrix output );
+
+#endif // FILTER_BANK_H
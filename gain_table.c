@@ -0,0 +1,217 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "gain_table.h"
+
+
+struct _GainTableData
+{
+  size_t rowsNumber, columnsNumber;
+  size_t dimensionsNumber;
+  size_t pointsNumbersList[ GAIN_TABLE_DIMENSIONS_MAX ];
+  size_t gainStridesList[ GAIN_TABLE_DIMENSIONS_MAX ];    // Distance (in gains) between consecutive grid points along each dimension
+  double* breakpointsLists[ GAIN_TABLE_DIMENSIONS_MAX ];
+  double* gainsList;                                       // All gains, in internal column-major order, contiguous in grid order (first dimension fastest)
+  double* resultArray;
+};
+
+
+GainTable GainTable_Create( size_t rowsNumber, size_t columnsNumber, size_t dimensionsNumber, size_t* pointsNumbersList )
+{
+  if( rowsNumber == 0 || columnsNumber == 0 || rowsNumber * columnsNumber > MATRIX_SIZE_MAX ) return NULL;
+  if( dimensionsNumber == 0 || dimensionsNumber > GAIN_TABLE_DIMENSIONS_MAX || pointsNumbersList == NULL ) return NULL;
+  
+  GainTable newTable = (GainTable) calloc( 1, sizeof(GainTableData) );
+  if( newTable == NULL ) return NULL;
+  
+  newTable->rowsNumber = rowsNumber;
+  newTable->columnsNumber = columnsNumber;
+  newTable->dimensionsNumber = dimensionsNumber;
+  
+  size_t gainsNumber = 1;
+  for( size_t dimension = 0; dimension < dimensionsNumber; dimension++ )
+  {
+    newTable->pointsNumbersList[ dimension ] = pointsNumbersList[ dimension ];
+    newTable->gainStridesList[ dimension ] = gainsNumber;
+    gainsNumber *= pointsNumbersList[ dimension ];
+    newTable->breakpointsLists[ dimension ] = (double*) malloc( pointsNumbersList[ dimension ] * sizeof(double) );
+    if( newTable->breakpointsLists[ dimension ] == NULL ) gainsNumber = 0;
+  }
+  
+  if( gainsNumber > 0 ) newTable->gainsList = (double*) calloc( gainsNumber * rowsNumber * columnsNumber, sizeof(double) );
+  newTable->resultArray = (double*) malloc( rowsNumber * columnsNumber * sizeof(double) );
+  
+  if( newTable->gainsList == NULL || newTable->resultArray == NULL )
+  {
+    GainTable_Discard( newTable );
+    return NULL;
+  }
+  
+  for( size_t dimension = 0; dimension < dimensionsNumber; dimension++ )
+  {
+    for( size_t point = 0; point < pointsNumbersList[ dimension ]; point++ )
+      newTable->breakpointsLists[ dimension ][ point ] = (double) point;
+  }
+  
+  return newTable;
+}
+
+void GainTable_Discard( GainTable table )
+{
+  if( table == NULL ) return;
+  
+  for( size_t dimension = 0; dimension < GAIN_TABLE_DIMENSIONS_MAX; dimension++ )
+    free( table->breakpointsLists[ dimension ] );
+  free( table->gainsList );
+  free( table->resultArray );
+  
+  free( table );
+}
+
+bool GainTable_SetBreakpoints( GainTable table, size_t dimension, double* breakpointsList )
+{
+  if( table == NULL || breakpointsList == NULL ) return false;
+  
+  if( dimension >= table->dimensionsNumber ) return false;
+  
+  for( size_t point = 1; point < table->pointsNumbersList[ dimension ]; point++ )
+  {
+    if( !( breakpointsList[ point ] > breakpointsList[ point - 1 ] ) ) return false;
+  }
+  
+  memcpy( table->breakpointsLists[ dimension ], breakpointsList, table->pointsNumbersList[ dimension ] * sizeof(double) );
+  
+  return true;
+}
+
+bool GainTable_SetGain( GainTable table, size_t* indexesList, Matrix gain )
+{
+  if( table == NULL || indexesList == NULL || gain == NULL ) return false;
+  
+  if( Mat_GetHeight( gain ) != table->rowsNumber || Mat_GetWidth( gain ) != table->columnsNumber ) return false;
+  
+  size_t gainIndex = 0;
+  for( size_t dimension = 0; dimension < table->dimensionsNumber; dimension++ )
+  {
+    if( indexesList[ dimension ] >= table->pointsNumbersList[ dimension ] ) return false;
+    gainIndex += indexesList[ dimension ] * table->gainStridesList[ dimension ];
+  }
+  
+  // Column-major storage, so that gains are read and written with single contiguous copies
+  Mat_GetColumnMajorData( gain, table->gainsList + gainIndex * table->rowsNumber * table->columnsNumber );
+  
+  return true;
+}
+
+// Lower grid point of the cell containing value (binary search) and normalized position inside it, clamped to [ 0, 1 ]
+static size_t FindCell( const double* breakpointsList, size_t pointsNumber, double value, double* fraction )
+{
+  *fraction = 0.0;
+  
+  if( pointsNumber < 2 || value <= breakpointsList[ 0 ] ) return 0;
+  
+  if( value >= breakpointsList[ pointsNumber - 1 ] )
+  {
+    *fraction = 1.0;
+    return pointsNumber - 2;
+  }
+  
+  size_t lowerPoint = 0, upperPoint = pointsNumber - 1;
+  while( upperPoint - lowerPoint > 1 )
+  {
+    size_t middlePoint = ( lowerPoint + upperPoint ) / 2;
+    if( value < breakpointsList[ middlePoint ] ) upperPoint = middlePoint;
+    else lowerPoint = middlePoint;
+  }
+  
+  *fraction = ( value - breakpointsList[ lowerPoint ] ) / ( breakpointsList[ upperPoint ] - breakpointsList[ lowerPoint ] );
+  
+  return lowerPoint;
+}
+
+Matrix GainTable_GetGain( GainTable table, double* operatingPoint, Matrix result )
+{
+  const double* cornersList[ 1 << GAIN_TABLE_DIMENSIONS_MAX ];
+  double weightsList[ 1 << GAIN_TABLE_DIMENSIONS_MAX ];
+  
+  if( table == NULL || operatingPoint == NULL || result == NULL ) return NULL;
+  
+  if( Mat_GetHeight( result ) != table->rowsNumber || Mat_GetWidth( result ) != table->columnsNumber ) return NULL;
+  
+  size_t gainSize = table->rowsNumber * table->columnsNumber;
+  
+  // Corner c of the cell has offset bit k set when it is the upper point along dimension k, with weight product of ( 1 - f ) or f terms
+  size_t cornersNumber = (size_t) 1 << table->dimensionsNumber;
+  for( size_t corner = 0; corner < cornersNumber; corner++ )
+  {
+    cornersList[ corner ] = table->gainsList;
+    weightsList[ corner ] = 1.0;
+  }
+  
+  for( size_t dimension = 0; dimension < table->dimensionsNumber; dimension++ )
+  {
+    double fraction;
+    size_t pointsNumber = table->pointsNumbersList[ dimension ];
+    size_t lowerPoint = FindCell( table->breakpointsLists[ dimension ], pointsNumber, operatingPoint[ dimension ], &fraction );
+    size_t lowerOffset = lowerPoint * table->gainStridesList[ dimension ] * gainSize;
+    size_t upperOffset = ( pointsNumber > 1 ) ? lowerOffset + table->gainStridesList[ dimension ] * gainSize : lowerOffset;
+    
+    for( size_t corner = 0; corner < cornersNumber; corner++ )
+    {
+      bool isUpper = ( corner >> dimension ) & 1;
+      cornersList[ corner ] += isUpper ? upperOffset : lowerOffset;
+      weightsList[ corner ] *= isUpper ? fraction : 1.0 - fraction;
+    }
+  }
+  
+  // Fused weighted sum of all corner gains, with one independent loop per interpolation order (unrolled over corners)
+  double* resultArray = table->resultArray;
+  const double* const* gain = cornersList;
+  const double* weight = weightsList;
+  if( cornersNumber == 2 )
+  {
+    for( size_t index = 0; index < gainSize; index++ )
+      resultArray[ index ] = weight[ 0 ] * gain[ 0 ][ index ] + weight[ 1 ] * gain[ 1 ][ index ];
+  }
+  else if( cornersNumber == 4 )
+  {
+    for( size_t index = 0; index < gainSize; index++ )
+      resultArray[ index ] = weight[ 0 ] * gain[ 0 ][ index ] + weight[ 1 ] * gain[ 1 ][ index ] 
+                           + weight[ 2 ] * gain[ 2 ][ index ] + weight[ 3 ] * gain[ 3 ][ index ];
+  }
+  else
+  {
+    for( size_t index = 0; index < gainSize; index++ )
+      resultArray[ index ] = weight[ 0 ] * gain[ 0 ][ index ] + weight[ 1 ] * gain[ 1 ][ index ] 
+                           + weight[ 2 ] * gain[ 2 ][ index ] + weight[ 3 ] * gain[ 3 ][ index ]
+                           + weight[ 4 ] * gain[ 4 ][ index ] + weight[ 5 ] * gain[ 5 ][ index ] 
+                           + weight[ 6 ] * gain[ 6 ][ index ] + weight[ 7 ] * gain[ 7 ][ index ];
+  }
+  
+  Mat_SetColumnMajorData( result, resultArray );
+  
+  return result;
+}
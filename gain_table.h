@@ -0,0 +1,72 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+
+/// @file gain_table.h
+/// @brief Table of (gain) matrices scheduled over a 1 to 3 dimensional grid of operating points, with interpolated lookup
+
+#ifndef GAIN_TABLE_H
+#define GAIN_TABLE_H
+
+#include "matrix.h"
+
+#define GAIN_TABLE_DIMENSIONS_MAX 3     ///< Maximum number of scheduling variables (grid dimensions)
+
+typedef struct _GainTableData GainTableData;    ///< Gain table internal data structure
+typedef GainTableData* GainTable;               ///< Opaque reference to gain table data structure
+
+
+/// @brief Creates table of matrices with given dimensions over a rectangular grid, with zeroed gains and breakpoints equal to grid indexes
+/// @param[in] rowsNumber number of rows of each table matrix
+/// @param[in] columnsNumber number of columns of each table matrix
+/// @param[in] dimensionsNumber number of scheduling variables (1 to GAIN_TABLE_DIMENSIONS_MAX)
+/// @param[in] pointsNumbersList array with number of grid points (breakpoints) along each dimension
+/// @return reference/pointer to allocated gain table (NULL on errors or if matrix size is greater than MATRIX_SIZE_MAX)
+GainTable GainTable_Create( size_t rowsNumber, size_t columnsNumber, size_t dimensionsNumber, size_t* pointsNumbersList );
+
+/// @brief Destroys/deallocates memory of gain table
+/// @param[in] table reference to gain table to be destroyed/deallocated
+void GainTable_Discard( GainTable table );
+
+/// @brief Sets grid breakpoints (scheduling variable values) along one dimension
+/// @param[in] table reference to gain table
+/// @param[in] dimension index of grid dimension
+/// @param[in] breakpointsList array with strictly increasing breakpoints (grid points number of that dimension elements)
+/// @return true on success, false on errors or unordered breakpoints
+bool GainTable_SetBreakpoints( GainTable table, size_t dimension, double* breakpointsList );
+
+/// @brief Stores matrix (copy) at given grid point
+/// @param[in] table reference to gain table
+/// @param[in] indexesList array with grid point index along each dimension
+/// @param[in] gain reference to matrix with table matrices dimensions
+/// @return true on success, false on errors
+bool GainTable_SetGain( GainTable table, size_t* indexesList, Matrix gain );
+
+/// @brief Gets matrix interpolated (linearly, bilinearly or trilinearly) from the grid cell containing given operating point, 
+/// in a single pass over its corner matrices and with no allocations (scheduling variables are clamped to grid limits)
+/// @param[in] table reference to gain table
+/// @param[in] operatingPoint array with scheduling variable value along each dimension
+/// @param[out] result reference to matrix with table matrices dimensions, to hold interpolated gain
+/// @return reference/pointer to @a result matrix (NULL on errors)
+Matrix GainTable_GetGain( GainTable table, double* operatingPoint, Matrix result );
+
+#endif // GAIN_TABLE_H
@@ -0,0 +1,352 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "gaussian_process.h"
+
+
+#define KERNEL_JITTER_RATIO 1e-8    // Regularization of noiseless kernel matrices, relative to signal variance
+
+struct _GaussianProcessData
+{
+  size_t inputsNumber, pointsNumberMax;
+  char kernelType;
+  double lengthScale, variance, noiseVariance;
+  size_t pointsNumber;
+  bool isSparse;
+  Matrix inputsList;              // Stored training points (inducing points in sparse mode)
+  Matrix outputsList;
+  Matrix factor;                  // Exact: Cholesky factor of K + s²I. Sparse: Cholesky factor of Kzz
+  Matrix weightsList;             // Exact: L^-1 y. Sparse: Kzx y / s²
+  Matrix sparseFactor;            // Sparse: Cholesky factor of Kzz + Kzx Kxz / s²
+  Matrix point;
+  Matrix kernelVector;
+  Matrix crossKernel, crossKernelAux;
+  Matrix meansList, variancesList;  // Predictions as column vectors, copied to caller vectors of any orientation
+  double* bufferArray;
+  double* predictionsArray;
+};
+
+
+GaussianProcess GaussianProcess_Create( size_t inputsNumber, size_t pointsNumberMax, char kernelType, double lengthScale, double variance, double noiseVariance )
+{
+  if( inputsNumber == 0 || pointsNumberMax == 0 ) return NULL;
+  
+  if( inputsNumber * pointsNumberMax > MATRIX_SIZE_MAX || pointsNumberMax * pointsNumberMax > MATRIX_SIZE_MAX ) return NULL;
+  
+  if( kernelType != MATRIX_KERNEL_GAUSSIAN && kernelType != MATRIX_KERNEL_MATERN_3_2 && kernelType != MATRIX_KERNEL_MATERN_5_2 ) return NULL;
+  
+  if( lengthScale <= 0.0 || variance <= 0.0 || noiseVariance <= 0.0 ) return NULL;
+  
+  GaussianProcess newModel = (GaussianProcess) calloc( 1, sizeof(GaussianProcessData) );
+  if( newModel == NULL ) return NULL;
+  
+  newModel->inputsNumber = inputsNumber;
+  newModel->pointsNumberMax = pointsNumberMax;
+  newModel->kernelType = kernelType;
+  newModel->lengthScale = lengthScale;
+  newModel->variance = variance;
+  newModel->noiseVariance = noiseVariance;
+  
+  // Storage is allocated for maximum sizes: growing matrices with Mat_Resize afterwards reuses it
+  newModel->inputsList = Mat_Create( NULL, inputsNumber, pointsNumberMax );
+  newModel->outputsList = Mat_Create( NULL, pointsNumberMax, 1 );
+  newModel->factor = Mat_Create( NULL, pointsNumberMax, pointsNumberMax );
+  newModel->weightsList = Mat_Create( NULL, pointsNumberMax, 1 );
+  newModel->sparseFactor = Mat_Create( NULL, pointsNumberMax, pointsNumberMax );
+  newModel->point = Mat_Create( NULL, inputsNumber, 1 );
+  newModel->kernelVector = Mat_Create( NULL, pointsNumberMax, 1 );
+  newModel->crossKernel = Mat_Create( NULL, MATRIX_SIZE_MAX, 1 );
+  newModel->crossKernelAux = Mat_Create( NULL, MATRIX_SIZE_MAX, 1 );
+  newModel->meansList = Mat_Create( NULL, MATRIX_SIZE_MAX, 1 );
+  newModel->variancesList = Mat_Create( NULL, MATRIX_SIZE_MAX, 1 );
+  newModel->bufferArray = (double*) calloc( ( inputsNumber > pointsNumberMax ) ? inputsNumber : pointsNumberMax, sizeof(double) );
+  newModel->predictionsArray = (double*) calloc( MATRIX_SIZE_MAX, sizeof(double) );
+  
+  if( newModel->inputsList == NULL || newModel->outputsList == NULL || newModel->factor == NULL || newModel->weightsList == NULL 
+      || newModel->sparseFactor == NULL || newModel->point == NULL || newModel->kernelVector == NULL 
+      || newModel->crossKernel == NULL || newModel->crossKernelAux == NULL || newModel->meansList == NULL || newModel->variancesList == NULL 
+      || newModel->bufferArray == NULL || newModel->predictionsArray == NULL )
+  {
+    GaussianProcess_Discard( newModel );
+    return NULL;
+  }
+  
+  GaussianProcess_Reset( newModel );
+  
+  return newModel;
+}
+
+void GaussianProcess_Discard( GaussianProcess model )
+{
+  if( model == NULL ) return;
+  
+  Mat_Discard( model->inputsList );
+  Mat_Discard( model->outputsList );
+  Mat_Discard( model->factor );
+  Mat_Discard( model->weightsList );
+  Mat_Discard( model->sparseFactor );
+  Mat_Discard( model->point );
+  Mat_Discard( model->kernelVector );
+  Mat_Discard( model->crossKernel );
+  Mat_Discard( model->crossKernelAux );
+  Mat_Discard( model->meansList );
+  Mat_Discard( model->variancesList );
+  free( model->bufferArray );
+  free( model->predictionsArray );
+  
+  free( model );
+}
+
+static void SetPointsNumber( GaussianProcess model, size_t pointsNumber )
+{
+  Mat_Resize( model->inputsList, model->inputsNumber, pointsNumber );
+  Mat_Resize( model->outputsList, pointsNumber, 1 );
+  Mat_Resize( model->factor, pointsNumber, pointsNumber );
+  Mat_Resize( model->weightsList, pointsNumber, 1 );
+  model->pointsNumber = pointsNumber;
+}
+
+void GaussianProcess_Reset( GaussianProcess model )
+{
+  if( model == NULL ) return;
+  
+  SetPointsNumber( model, 0 );
+  model->isSparse = false;
+}
+
+static void AddDiagonal( Matrix matrix, double value )
+{
+  for( size_t index = 0; index < Mat_GetHeight( matrix ); index++ )
+    Mat_SetElement( matrix, index, index, Mat_GetElement( matrix, index, index ) + value );
+}
+
+// Sum of squares of each column, for variances from solved (whitened) kernel columns
+static void SubtractSquaredNorms( Matrix matrix, double* buffer, double weight, Matrix variances )
+{
+  for( size_t column = 0; column < Mat_GetWidth( matrix ); column++ )
+  {
+    Mat_GetColumn( matrix, column, buffer );
+    double squaredNorm = 0.0;
+    for( size_t row = 0; row < Mat_GetHeight( matrix ); row++ )
+      squaredNorm += buffer[ row ] * buffer[ row ];
+    Mat_SetElement( variances, column, 0, Mat_GetElement( variances, column, 0 ) - weight * squaredNorm );
+  }
+}
+
+// Turns stored points into inducing ones, summarizing their data in the sparse (deterministic training conditional) form
+static bool MakeSparse( GaussianProcess model )
+{
+  double jitter = KERNEL_JITTER_RATIO * model->variance;
+  
+  // Kzz (kept on the auxiliary matrix while products are formed)
+  Mat_Kernel( model->inputsList, model->inputsList, model->kernelType, model->lengthScale, model->variance, model->crossKernelAux );
+  
+  Mat_Dot( model->crossKernelAux, MATRIX_KEEP, model->outputsList, MATRIX_KEEP, model->weightsList );
+  Mat_Scale( model->weightsList, 1.0 / model->noiseVariance, model->weightsList );
+  
+  Mat_Dot( model->crossKernelAux, MATRIX_KEEP, model->crossKernelAux, MATRIX_KEEP, model->sparseFactor );
+  Mat_Sum( model->crossKernelAux, 1.0, model->sparseFactor, 1.0 / model->noiseVariance, model->sparseFactor );
+  AddDiagonal( model->sparseFactor, jitter );
+  if( Mat_DecomposeCholesky( model->sparseFactor, model->sparseFactor ) == NULL ) return false;
+  
+  AddDiagonal( model->crossKernelAux, jitter );
+  if( Mat_DecomposeCholesky( model->crossKernelAux, model->factor ) == NULL ) return false;
+  
+  model->isSparse = true;
+  
+  return true;
+}
+
+bool GaussianProcess_Fit( GaussianProcess model, Matrix inputs, Matrix outputs )
+{
+  if( model == NULL || inputs == NULL || outputs == NULL ) return false;
+  
+  size_t pointsNumber = Mat_GetWidth( inputs );
+  if( Mat_GetHeight( inputs ) != model->inputsNumber || Mat_GetHeight( outputs ) * Mat_GetWidth( outputs ) != pointsNumber ) return false;
+  
+  GaussianProcess_Reset( model );
+  
+  size_t batchLength = ( pointsNumber < model->pointsNumberMax ) ? pointsNumber : model->pointsNumberMax;
+  SetPointsNumber( model, batchLength );
+  for( size_t point = 0; point < batchLength; point++ )
+  {
+    Mat_SetColumn( model->inputsList, point, Mat_GetColumn( inputs, point, model->bufferArray ) );
+    Mat_SetElement( model->outputsList, point, 0, Mat_GetElement( outputs, point % Mat_GetHeight( outputs ), point / Mat_GetHeight( outputs ) ) );
+  }
+  
+  if( batchLength > 0 )
+  {
+    Mat_Kernel( model->inputsList, model->inputsList, model->kernelType, model->lengthScale, model->variance, model->factor );
+    AddDiagonal( model->factor, model->noiseVariance );
+    if( Mat_DecomposeCholesky( model->factor, model->factor ) == NULL )
+    {
+      GaussianProcess_Reset( model );
+      return false;
+    }
+    
+    Mat_Copy( model->outputsList, model->weightsList );
+    Mat_TriangularSolve( model->factor, MATRIX_LOWER, MATRIX_KEEP, MATRIX_NON_UNIT_DIAGONAL, model->weightsList );
+  }
+  
+  for( size_t point = batchLength; point < pointsNumber; point++ )
+  {
+    double output = Mat_GetElement( outputs, point % Mat_GetHeight( outputs ), point / Mat_GetHeight( outputs ) );
+    if( !GaussianProcess_AddPoint( model, Mat_GetColumn( inputs, point, model->bufferArray ), output ) ) return false;
+  }
+  
+  return true;
+}
+
+bool GaussianProcess_AddPoint( GaussianProcess model, double* input, double output )
+{
+  if( model == NULL || input == NULL ) return false;
+  
+  Mat_SetData( model->point, input );
+  
+  if( !model->isSparse && model->pointsNumber == model->pointsNumberMax )
+  {
+    if( !MakeSparse( model ) ) return false;
+  }
+  
+  if( model->isSparse )
+  {
+    // Rank-1 update of the summarized data: Kzz + Kzx Kxz / s² and Kzx y / s²
+    Mat_Kernel( model->inputsList, model->point, model->kernelType, model->lengthScale, model->variance, model->kernelVector );
+    Mat_Sum( model->weightsList, 1.0, model->kernelVector, output / model->noiseVariance, model->weightsList );
+    Mat_Scale( model->kernelVector, 1.0 / sqrt( model->noiseVariance ), model->kernelVector );
+    Mat_UpdateCholesky( model->sparseFactor, model->kernelVector );
+    model->pointsNumber++;
+    return true;
+  }
+  
+  size_t pointsNumber = model->pointsNumber;
+  
+  // Appended factor row: l = L^-1 k, with diagonal sqrt( k(x,x) + s² - l^T l )
+  double pivot = model->variance + model->noiseVariance;
+  double projectedOutput = 0.0;
+  if( pointsNumber > 0 )
+  {
+    Mat_Kernel( model->inputsList, model->point, model->kernelType, model->lengthScale, model->variance, model->kernelVector );
+    Mat_TriangularSolve( model->factor, MATRIX_LOWER, MATRIX_KEEP, MATRIX_NON_UNIT_DIAGONAL, model->kernelVector );
+    pivot -= Mat_InnerProduct( model->kernelVector, model->kernelVector );
+    projectedOutput = Mat_InnerProduct( model->kernelVector, model->weightsList );
+  }
+  
+  if( !( pivot > 0.0 ) ) return false;
+  
+  double diagonal = sqrt( pivot );
+  
+  SetPointsNumber( model, pointsNumber + 1 );
+  
+  for( size_t column = 0; column < pointsNumber; column++ )
+    Mat_SetElement( model->factor, pointsNumber, column, Mat_GetElement( model->kernelVector, column, 0 ) );
+  Mat_SetElement( model->factor, pointsNumber, pointsNumber, diagonal );
+  
+  Mat_SetElement( model->weightsList, pointsNumber, 0, ( output - projectedOutput ) / diagonal );
+  Mat_SetColumn( model->inputsList, pointsNumber, input );
+  Mat_SetElement( model->outputsList, pointsNumber, 0, output );
+  
+  return true;
+}
+
+size_t GaussianProcess_GetPointsNumber( GaussianProcess model )
+{
+  if( model == NULL ) return 0;
+  
+  return model->pointsNumber;
+}
+
+bool GaussianProcess_IsSparse( GaussianProcess model )
+{
+  if( model == NULL ) return false;
+  
+  return model->isSparse;
+}
+
+// Predictions for all queries, stored in internal column vectors
+static bool PredictPoints( GaussianProcess model, Matrix queries, bool hasVariances )
+{
+  size_t queriesNumber = Mat_GetWidth( queries );
+  Matrix means = model->meansList, variances = model->variancesList;
+  
+  Mat_Resize( means, queriesNumber, 1 );
+  if( hasVariances ) 
+  {
+    Mat_Resize( variances, queriesNumber, 1 );
+    for( size_t query = 0; query < queriesNumber; query++ )
+      Mat_SetElement( variances, query, 0, model->variance );
+  }
+  
+  size_t storedNumber = Mat_GetWidth( model->inputsList );
+  if( storedNumber == 0 )
+  {
+    Mat_Clear( means );
+    return true;
+  }
+  
+  if( Mat_Kernel( model->inputsList, queries, model->kernelType, model->lengthScale, model->variance, model->crossKernel ) == NULL ) return false;
+  
+  if( !model->isSparse )
+  {
+    // mean = k^T (K + s²I)^-1 y = ( L^-1 k )^T ( L^-1 y ), variance = k(x,x) - || L^-1 k ||²
+    Mat_TriangularSolve( model->factor, MATRIX_LOWER, MATRIX_KEEP, MATRIX_NON_UNIT_DIAGONAL, model->crossKernel );
+    Mat_Dot( model->crossKernel, MATRIX_TRANSPOSE, model->weightsList, MATRIX_KEEP, means );
+    if( hasVariances ) SubtractSquaredNorms( model->crossKernel, model->bufferArray, 1.0, variances );
+    return true;
+  }
+  
+  // mean = k^T S^-1 b = ( Ls^-1 k )^T ( Ls^-1 b ), variance = k(x,x) - || Lz^-1 k ||² + || Ls^-1 k ||²
+  Mat_Copy( model->crossKernel, model->crossKernelAux );
+  Mat_TriangularSolve( model->sparseFactor, MATRIX_LOWER, MATRIX_KEEP, MATRIX_NON_UNIT_DIAGONAL, model->crossKernel );
+  Mat_Copy( model->weightsList, model->kernelVector );
+  Mat_TriangularSolve( model->sparseFactor, MATRIX_LOWER, MATRIX_KEEP, MATRIX_NON_UNIT_DIAGONAL, model->kernelVector );
+  Mat_Dot( model->crossKernel, MATRIX_TRANSPOSE, model->kernelVector, MATRIX_KEEP, means );
+  if( hasVariances )
+  {
+    SubtractSquaredNorms( model->crossKernel, model->bufferArray, -1.0, variances );
+    Mat_TriangularSolve( model->factor, MATRIX_LOWER, MATRIX_KEEP, MATRIX_NON_UNIT_DIAGONAL, model->crossKernelAux );
+    SubtractSquaredNorms( model->crossKernelAux, model->bufferArray, 1.0, variances );
+  }
+  
+  return true;
+}
+
+bool GaussianProcess_Predict( GaussianProcess model, Matrix queries, Matrix means, Matrix variances )
+{
+  if( model == NULL || queries == NULL || means == NULL ) return false;
+  
+  size_t queriesNumber = Mat_GetWidth( queries );
+  if( Mat_GetHeight( queries ) != model->inputsNumber || queriesNumber > MATRIX_SIZE_MAX ) return false;
+  if( Mat_GetHeight( means ) * Mat_GetWidth( means ) != queriesNumber ) return false;
+  if( variances != NULL && Mat_GetHeight( variances ) * Mat_GetWidth( variances ) != queriesNumber ) return false;
+  
+  if( !PredictPoints( model, queries, ( variances != NULL ) ) ) return false;
+  
+  // Row and column vectors share the same raw data order, so caller vectors are written without being reshaped
+  Mat_SetData( means, Mat_GetData( model->meansList, model->predictionsArray ) );
+  if( variances != NULL ) Mat_SetData( variances, Mat_GetData( model->variancesList, model->predictionsArray ) );
+  
+  return true;
+}
@@ -0,0 +1,85 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file gaussian_process.h
+/// @brief Online Gaussian process regression, with incremental (Cholesky factor append) training and bounded sparse (inducing points) approximation
+
+#ifndef GAUSSIAN_PROCESS_H
+#define GAUSSIAN_PROCESS_H
+
+#include "matrix.h"
+
+typedef struct _GaussianProcessData GaussianProcessData;    ///< Gaussian process internal data structure
+typedef GaussianProcessData* GaussianProcess;               ///< Opaque reference to Gaussian process data structure
+
+
+/// @brief Creates Gaussian process regressor (zero prior mean) with no training points, preallocating all storage
+/// @param[in] inputsNumber dimension of input points
+/// @param[in] pointsNumberMax maximum number of exactly stored training points. When exceeded, stored points become fixed inducing points of a sparse (DTC) approximation
+/// @param[in] kernelType stationary covariance function (MATRIX_KERNEL_GAUSSIAN, MATRIX_KERNEL_MATERN_3_2 or MATRIX_KERNEL_MATERN_5_2)
+/// @param[in] lengthScale (positive) kernel length scale
+/// @param[in] variance (positive) kernel signal variance
+/// @param[in] noiseVariance (positive) variance of output measurement noise
+/// @return reference/pointer to allocated Gaussian process (NULL on errors or if stored points/kernel matrices exceed MATRIX_SIZE_MAX)
+GaussianProcess GaussianProcess_Create( size_t inputsNumber, size_t pointsNumberMax, char kernelType, double lengthScale, double variance, double noiseVariance );
+
+/// @brief Destroys/deallocates memory of Gaussian process
+/// @param[in] model reference to Gaussian process to be destroyed/deallocated
+void GaussianProcess_Discard( GaussianProcess model );
+
+/// @brief Removes all training points, returning to the exact (non sparse) prior model
+/// @param[in] model reference to Gaussian process
+void GaussianProcess_Reset( GaussianProcess model );
+
+/// @brief Trains Gaussian process from scratch with a batch of points (single Cholesky decomposition, plus incremental additions beyond the maximum number of stored points)
+/// @param[in] model reference to Gaussian process
+/// @param[in] inputs reference to training inputs matrix (inputs number x n, one point per column)
+/// @param[in] outputs reference to training outputs vector (n elements)
+/// @return true on success, false on errors or numerically non positive definite covariance
+bool GaussianProcess_Fit( GaussianProcess model, Matrix inputs, Matrix outputs );
+
+/// @brief Adds single training point, updating the model in O(n²) operations (without allocations or refactorization)
+/// @param[in] model reference to Gaussian process
+/// @param[in] input array of input point coordinates (inputs number elements)
+/// @param[in] output measured output value
+/// @return true on success, false on errors or numerically non positive definite covariance (point is not added)
+bool GaussianProcess_AddPoint( GaussianProcess model, double* input, double output );
+
+/// @brief Gets number of training points used by the model
+/// @param[in] model reference to Gaussian process
+/// @return number of added points (0 on errors)
+size_t GaussianProcess_GetPointsNumber( GaussianProcess model );
+
+/// @brief Tells if the model has switched to sparse approximation over fixed inducing points
+/// @param[in] model reference to Gaussian process
+/// @return true if sparse, false otherwise or on errors
+bool GaussianProcess_IsSparse( GaussianProcess model );
+
+/// @brief Predicts posterior mean and variance of the (noiseless) latent function for a batch of query points, through triangular solves
+/// @param[in] model reference to Gaussian process
+/// @param[in] queries reference to query inputs matrix (inputs number x q, one point per column. Stored points x q must not exceed MATRIX_SIZE_MAX)
+/// @param[out] means preallocated vector to store predicted means (q elements)
+/// @param[out] variances preallocated vector to store predicted variances (q elements. NULL if not needed)
+/// @return true on success, false on errors
+bool GaussianProcess_Predict( GaussianProcess model, Matrix queries, Matrix means, Matrix variances );
+
+#endif // GAUSSIAN_PROCESS_H
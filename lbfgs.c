@@ -0,0 +1,338 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include "lbfgs.h"
+
+
+#define ITERATIONS_MAX_DEFAULT 1000
+#define GRADIENT_TOLERANCE_DEFAULT 1e-6
+#define VALUE_TOLERANCE_DEFAULT 1e-12
+#define SUFFICIENT_DECREASE 1e-4        // Armijo condition constant
+#define CURVATURE_CONDITION 0.9         // (weak) Wolfe curvature condition constant
+#define LINE_SEARCH_EVALUATIONS_MAX 40
+
+struct _LBFGSData
+{
+  size_t parametersNumber, memoryLength;
+  LBFGSObjectiveFunction objectiveFunction;
+  void* userData;
+  double* correctionsArray;             // Ring buffer of steps s = x[k+1] - x[k], one per column
+  double* differencesArray;             // Ring buffer of gradient differences y = g[k+1] - g[k], one per column
+  double* curvaturesList;               // 1 / ( y^T s ) of each stored pair
+  double* weightsList;                  // Two-loop recursion coefficients
+  size_t pairsHead, pairsNumber;        // Next ring position to be written and number of valid pairs
+  double* pointArray;
+  double* gradientArray;
+  double* directionArray;
+  double* trialPointArray;
+  double* trialGradientArray;
+  size_t iterationsMax, iterationsNumber;
+  double gradientTolerance, valueTolerance;
+  double value;
+};
+
+
+LBFGS LBFGS_Create( size_t parametersNumber, size_t memoryLength, LBFGSObjectiveFunction objectiveFunction, void* userData )
+{
+  if( parametersNumber == 0 || memoryLength == 0 || objectiveFunction == NULL ) return NULL;
+  
+  LBFGS newMinimizer = (LBFGS) calloc( 1, sizeof(LBFGSData) );
+  if( newMinimizer == NULL ) return NULL;
+  
+  newMinimizer->parametersNumber = parametersNumber;
+  newMinimizer->memoryLength = memoryLength;
+  newMinimizer->objectiveFunction = objectiveFunction;
+  newMinimizer->userData = userData;
+  
+  newMinimizer->correctionsArray = (double*) calloc( parametersNumber * memoryLength, sizeof(double) );
+  newMinimizer->differencesArray = (double*) calloc( parametersNumber * memoryLength, sizeof(double) );
+  newMinimizer->curvaturesList = (double*) calloc( memoryLength, sizeof(double) );
+  newMinimizer->weightsList = (double*) calloc( memoryLength, sizeof(double) );
+  newMinimizer->pointArray = (double*) calloc( parametersNumber, sizeof(double) );
+  newMinimizer->gradientArray = (double*) calloc( parametersNumber, sizeof(double) );
+  newMinimizer->directionArray = (double*) calloc( parametersNumber, sizeof(double) );
+  newMinimizer->trialPointArray = (double*) calloc( parametersNumber, sizeof(double) );
+  newMinimizer->trialGradientArray = (double*) calloc( parametersNumber, sizeof(double) );
+  
+  if( newMinimizer->correctionsArray == NULL || newMinimizer->differencesArray == NULL || newMinimizer->curvaturesList == NULL 
+      || newMinimizer->weightsList == NULL || newMinimizer->pointArray == NULL || newMinimizer->gradientArray == NULL 
+      || newMinimizer->directionArray == NULL || newMinimizer->trialPointArray == NULL || newMinimizer->trialGradientArray == NULL )
+  {
+    LBFGS_Discard( newMinimizer );
+    return NULL;
+  }
+  
+  LBFGS_SetSettings( newMinimizer, ITERATIONS_MAX_DEFAULT, GRADIENT_TOLERANCE_DEFAULT, VALUE_TOLERANCE_DEFAULT );
+  
+  return newMinimizer;
+}
+
+void LBFGS_Discard( LBFGS minimizer )
+{
+  if( minimizer == NULL ) return;
+  
+  free( minimizer->correctionsArray );
+  free( minimizer->differencesArray );
+  free( minimizer->curvaturesList );
+  free( minimizer->weightsList );
+  free( minimizer->pointArray );
+  free( minimizer->gradientArray );
+  free( minimizer->directionArray );
+  free( minimizer->trialPointArray );
+  free( minimizer->trialGradientArray );
+  
+  free( minimizer );
+}
+
+bool LBFGS_SetSettings( LBFGS minimizer, size_t iterationsMax, double gradientTolerance, double valueTolerance )
+{
+  if( minimizer == NULL ) return false;
+  
+  if( iterationsMax == 0 || gradientTolerance < 0.0 || valueTolerance < 0.0 ) return false;
+  
+  minimizer->iterationsMax = iterationsMax;
+  minimizer->gradientTolerance = gradientTolerance;
+  minimizer->valueTolerance = valueTolerance;
+  
+  return true;
+}
+
+// Vector kernels: independent partial sums and plain contiguous loops, left for compiler vectorization
+
+static double DotProduct( const double* data_1, const double* data_2, size_t length )
+{
+  double lanesList[ 4 ] = { 0.0, 0.0, 0.0, 0.0 };
+  size_t index = 0;
+  for( ; index + 4 <= length; index += 4 )
+  {
+    lanesList[ 0 ] += data_1[ index ] * data_2[ index ];
+    lanesList[ 1 ] += data_1[ index + 1 ] * data_2[ index + 1 ];
+    lanesList[ 2 ] += data_1[ index + 2 ] * data_2[ index + 2 ];
+    lanesList[ 3 ] += data_1[ index + 3 ] * data_2[ index + 3 ];
+  }
+  for( ; index < length; index++ )
+    lanesList[ 0 ] += data_1[ index ] * data_2[ index ];
+  
+  return ( lanesList[ 0 ] + lanesList[ 1 ] ) + ( lanesList[ 2 ] + lanesList[ 3 ] );
+}
+
+// y = y + a x
+static void AddScaled( double* data, double factor, const double* addedData, size_t length )
+{
+  for( size_t index = 0; index < length; index++ )
+    data[ index ] += factor * addedData[ index ];
+}
+
+static double GetMaxAbsolute( const double* data, size_t length )
+{
+  double maxAbsolute = 0.0;
+  for( size_t index = 0; index < length; index++ )
+    maxAbsolute = fmax( maxAbsolute, fabs( data[ index ] ) );
+  return maxAbsolute;
+}
+
+static bool EvaluateObjective( LBFGS minimizer, double* pointArray, double* gradientArray, double* value )
+{
+  if( !minimizer->objectiveFunction( pointArray, gradientArray, value, minimizer->userData ) ) return false;
+  
+  return isfinite( *value );
+}
+
+// Two-loop recursion: direction = -H g, with implicit inverse Hessian approximation H from stored pairs
+static void GetSearchDirection( LBFGS minimizer )
+{
+  size_t parametersNumber = minimizer->parametersNumber, memoryLength = minimizer->memoryLength;
+  double* direction = minimizer->directionArray;
+  
+  memcpy( direction, minimizer->gradientArray, parametersNumber * sizeof(double) );
+  
+  if( minimizer->pairsNumber == 0 )
+  {
+    // No curvature information: steepest descent step with unit length
+    double scale = -1.0 / fmax( sqrt( DotProduct( direction, direction, parametersNumber ) ), DBL_MIN );
+    for( size_t index = 0; index < parametersNumber; index++ )
+      direction[ index ] *= scale;
+    return;
+  }
+  
+  // Newest to oldest pairs
+  for( size_t pairIndex = 0; pairIndex < minimizer->pairsNumber; pairIndex++ )
+  {
+    size_t position = ( minimizer->pairsHead + memoryLength - 1 - pairIndex ) % memoryLength;
+    const double* correction = minimizer->correctionsArray + position * parametersNumber;
+    const double* difference = minimizer->differencesArray + position * parametersNumber;
+    double weight = minimizer->curvaturesList[ position ] * DotProduct( correction, direction, parametersNumber );
+    minimizer->weightsList[ position ] = weight;
+    AddScaled( direction, -weight, difference, parametersNumber );
+  }
+  
+  // Initial Hessian approximation scaled by newest pair: s^T y / y^T y
+  size_t newestPosition = ( minimizer->pairsHead + memoryLength - 1 ) % memoryLength;
+  const double* newestDifference = minimizer->differencesArray + newestPosition * parametersNumber;
+  double scale = 1.0 / ( minimizer->curvaturesList[ newestPosition ] * DotProduct( newestDifference, newestDifference, parametersNumber ) );
+  for( size_t index = 0; index < parametersNumber; index++ )
+    direction[ index ] *= scale;
+  
+  // Oldest to newest pairs
+  for( size_t pairIndex = 0; pairIndex < minimizer->pairsNumber; pairIndex++ )
+  {
+    size_t position = ( minimizer->pairsHead + memoryLength - minimizer->pairsNumber + pairIndex ) % memoryLength;
+    const double* correction = minimizer->correctionsArray + position * parametersNumber;
+    const double* difference = minimizer->differencesArray + position * parametersNumber;
+    double beta = minimizer->curvaturesList[ position ] * DotProduct( difference, direction, parametersNumber );
+    AddScaled( direction, minimizer->weightsList[ position ] - beta, correction, parametersNumber );
+  }
+  
+  for( size_t index = 0; index < parametersNumber; index++ )
+    direction[ index ] = -direction[ index ];
+}
+
+// Bisection/expansion search for a step satisfying weak Wolfe conditions (sufficient decrease and curvature), 
+// which ensures y^T s > 0 for the stored pair. Trial point, gradient and value hold the accepted step
+static bool SearchLine( LBFGS minimizer, double* trialValue )
+{
+  size_t parametersNumber = minimizer->parametersNumber;
+  double initialSlope = DotProduct( minimizer->gradientArray, minimizer->directionArray, parametersNumber );
+  double lowerStep = 0.0, upperStep = INFINITY, step = 1.0;
+  
+  for( size_t evaluation = 0; evaluation < LINE_SEARCH_EVALUATIONS_MAX; evaluation++ )
+  {
+    memcpy( minimizer->trialPointArray, minimizer->pointArray, parametersNumber * sizeof(double) );
+    AddScaled( minimizer->trialPointArray, step, minimizer->directionArray, parametersNumber );
+    
+    bool isEvaluated = EvaluateObjective( minimizer, minimizer->trialPointArray, minimizer->trialGradientArray, trialValue );
+    if( !isEvaluated || *trialValue > minimizer->value + SUFFICIENT_DECREASE * step * initialSlope ) upperStep = step;
+    else if( DotProduct( minimizer->trialGradientArray, minimizer->directionArray, parametersNumber ) < CURVATURE_CONDITION * initialSlope ) lowerStep = step;
+    else return true;
+    
+    step = isinf( upperStep ) ? 2.0 * lowerStep : 0.5 * ( lowerStep + upperStep );
+  }
+  
+  // Fall back to the last point satisfying sufficient decrease, if any
+  if( lowerStep == 0.0 ) return false;
+  
+  memcpy( minimizer->trialPointArray, minimizer->pointArray, parametersNumber * sizeof(double) );
+  AddScaled( minimizer->trialPointArray, lowerStep, minimizer->directionArray, parametersNumber );
+  
+  return EvaluateObjective( minimizer, minimizer->trialPointArray, minimizer->trialGradientArray, trialValue );
+}
+
+static void StorePair( LBFGS minimizer )
+{
+  size_t parametersNumber = minimizer->parametersNumber;
+  
+  // Pairs without positive curvature would break H positive definiteness. 
+  // They are tested before being written, as the head ring position still holds the oldest valid pair
+  double curvature = 0.0, differenceSquaredNorm = 0.0;
+  for( size_t index = 0; index < parametersNumber; index++ )
+  {
+    double correctionElement = minimizer->trialPointArray[ index ] - minimizer->pointArray[ index ];
+    double differenceElement = minimizer->trialGradientArray[ index ] - minimizer->gradientArray[ index ];
+    curvature += differenceElement * correctionElement;
+    differenceSquaredNorm += differenceElement * differenceElement;
+  }
+  if( curvature <= DBL_EPSILON * differenceSquaredNorm ) return;
+  
+  double* correction = minimizer->correctionsArray + minimizer->pairsHead * parametersNumber;
+  double* difference = minimizer->differencesArray + minimizer->pairsHead * parametersNumber;
+  for( size_t index = 0; index < parametersNumber; index++ )
+  {
+    correction[ index ] = minimizer->trialPointArray[ index ] - minimizer->pointArray[ index ];
+    difference[ index ] = minimizer->trialGradientArray[ index ] - minimizer->gradientArray[ index ];
+  }
+  
+  minimizer->curvaturesList[ minimizer->pairsHead ] = 1.0 / curvature;
+  minimizer->pairsHead = ( minimizer->pairsHead + 1 ) % minimizer->memoryLength;
+  if( minimizer->pairsNumber < minimizer->memoryLength ) minimizer->pairsNumber++;
+}
+
+bool LBFGS_Minimize( LBFGS minimizer, double* parametersList )
+{
+  if( minimizer == NULL || parametersList == NULL ) return false;
+  
+  size_t parametersNumber = minimizer->parametersNumber;
+  
+  memcpy( minimizer->pointArray, parametersList, parametersNumber * sizeof(double) );
+  minimizer->pairsHead = minimizer->pairsNumber = 0;
+  minimizer->iterationsNumber = 0;
+  
+  if( !EvaluateObjective( minimizer, minimizer->pointArray, minimizer->gradientArray, &(minimizer->value) ) ) return false;
+  
+  bool isConverged = false;
+  while( minimizer->iterationsNumber < minimizer->iterationsMax )
+  {
+    if( GetMaxAbsolute( minimizer->gradientArray, parametersNumber ) <= minimizer->gradientTolerance )
+    {
+      isConverged = true;
+      break;
+    }
+    
+    minimizer->iterationsNumber++;
+    
+    GetSearchDirection( minimizer );
+    // Safeguard against loss of descent by numerical errors: restart from steepest descent
+    if( DotProduct( minimizer->gradientArray, minimizer->directionArray, parametersNumber ) >= 0.0 )
+    {
+      minimizer->pairsNumber = 0;
+      GetSearchDirection( minimizer );
+    }
+    
+    double trialValue;
+    if( !SearchLine( minimizer, &trialValue ) ) break;
+    
+    StorePair( minimizer );
+    
+    double valueDecrease = minimizer->value - trialValue;
+    memcpy( minimizer->pointArray, minimizer->trialPointArray, parametersNumber * sizeof(double) );
+    memcpy( minimizer->gradientArray, minimizer->trialGradientArray, parametersNumber * sizeof(double) );
+    minimizer->value = trialValue;
+    
+    if( valueDecrease <= minimizer->valueTolerance * fmax( fmax( fabs( minimizer->value ), fabs( trialValue + valueDecrease ) ), 1.0 ) )
+    {
+      isConverged = true;
+      break;
+    }
+  }
+  
+  memcpy( parametersList, minimizer->pointArray, parametersNumber * sizeof(double) );
+  
+  return isConverged;
+}
+
+double LBFGS_GetValue( LBFGS minimizer )
+{
+  if( minimizer == NULL ) return 0.0;
+  
+  return minimizer->value;
+}
+
+size_t LBFGS_GetIterationsNumber( LBFGS minimizer )
+{
+  if( minimizer == NULL ) return 0;
+  
+  return minimizer->iterationsNumber;
+}
@@ -0,0 +1,79 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file lbfgs.h
+/// @brief Limited-memory BFGS unconstrained minimizer, never forming n x n matrices (two-loop recursion over stored correction pairs)
+
+#ifndef LBFGS_H
+#define LBFGS_H
+
+#include "matrix.h"
+
+typedef struct _LBFGSData LBFGSData;    ///< L-BFGS minimizer internal data structure
+typedef LBFGSData* LBFGS;               ///< Opaque reference to L-BFGS minimizer data structure
+
+/// @brief User function evaluating objective value and gradient (plain arrays, so that problem size is not bound to MATRIX_SIZE_MAX)
+/// @param[in] parametersList array of parameters x (n elements. Must not be modified)
+/// @param[out] gradientList array to be filled with objective gradient at x (n elements)
+/// @param[out] value pointer to objective value at x
+/// @param[in] userData pointer given on minimizer creation
+/// @return true on success, false if objective can't be evaluated at given parameters (line search step is reduced)
+typedef bool (*LBFGSObjectiveFunction)( double* parametersList, double* gradientList, double* value, void* userData );
+
+
+/// @brief Creates L-BFGS minimizer, allocating all workspace (including m correction pairs ring buffer)
+/// @param[in] parametersNumber number of optimized parameters n (not limited by MATRIX_SIZE_MAX)
+/// @param[in] memoryLength number m of stored (s, y) correction pairs (usually 3 to 20)
+/// @param[in] objectiveFunction objective value and gradient evaluation callback
+/// @param[in] userData pointer passed to callback (may be NULL)
+/// @return reference/pointer to allocated minimizer (NULL on errors)
+LBFGS LBFGS_Create( size_t parametersNumber, size_t memoryLength, LBFGSObjectiveFunction objectiveFunction, void* userData );
+
+/// @brief Destroys/deallocates memory of minimizer
+/// @param[in] minimizer reference to minimizer to be destroyed/deallocated
+void LBFGS_Discard( LBFGS minimizer );
+
+/// @brief Defines minimizer parameters (defaults: 1000 iterations, 1e-6 gradient tolerance, 1e-12 value tolerance)
+/// @param[in] minimizer reference to minimizer
+/// @param[in] iterationsMax maximum number of iterations
+/// @param[in] gradientTolerance convergence threshold for gradient maximum absolute value
+/// @param[in] valueTolerance convergence threshold for objective decrease, relative to its magnitude
+/// @return true on success, false on errors or invalid parameters
+bool LBFGS_SetSettings( LBFGS minimizer, size_t iterationsMax, double gradientTolerance, double valueTolerance );
+
+/// @brief Minimizes objective from given initial guess, with weak Wolfe line search and without allocations (stored pairs are cleared)
+/// @param[in] minimizer reference to minimizer
+/// @param[in,out] parametersList array of parameters (n elements), with initial guess as input and best found point as output
+/// @return true if converged within the iterations limit, false otherwise or on errors
+bool LBFGS_Minimize( LBFGS minimizer, double* parametersList );
+
+/// @brief Gets objective value at the point found on last minimization
+/// @param[in] minimizer reference to minimizer
+/// @return objective value (0.0 on errors)
+double LBFGS_GetValue( LBFGS minimizer );
+
+/// @brief Gets number of iterations performed on last minimization
+/// @param[in] minimizer reference to minimizer
+/// @return iterations number (0 on errors)
+size_t LBFGS_GetIterationsNumber( LBFGS minimizer );
+
+#endif // LBFGS_H
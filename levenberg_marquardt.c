@@ -0,0 +1,320 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+
+#include "levenberg_marquardt.h"
+
+
+#define ITERATIONS_MAX_DEFAULT 100
+#define TOLERANCE_DEFAULT 1e-10
+#define DAMPING_DEFAULT 1e-3
+#define DAMPING_MAX 1e16                // Beyond it, no step is able to reduce the cost
+#define DIAGONAL_MIN 1e-12              // Floor for Marquardt scaling of parameters with vanishing derivatives
+
+struct _LevenbergMarquardtData
+{
+  size_t parametersNumber, residualsNumber;
+  LevenbergMarquardtResidualFunction residualFunction;
+  LevenbergMarquardtJacobianFunction jacobianFunction;
+  void* userData;
+  Matrix parameters, trialParameters;
+  Matrix residuals, trialResiduals;
+  Matrix jacobian;
+  Matrix normalMatrix;                  // J^T J
+  Matrix gradient;                      // J^T r
+  Matrix factor;                        // Cholesky factor of J^T J + mu diag( J^T J )
+  Matrix step;
+  // Raw copies for element-wise work, filled a whole column at a time
+  double* columnArray, * residualsArray;
+  double* parametersArray, * gradientArray, * stepArray;
+  double* diagonalArray;                // diag( J^T J )
+  double* normalColumnArray;
+  size_t iterationsMax, iterationsNumber;
+  double gradientTolerance, stepTolerance, initialDamping;
+  double cost;
+};
+
+
+LevenbergMarquardt LevenbergMarquardt_Create( size_t parametersNumber, size_t residualsNumber, 
+                                              LevenbergMarquardtResidualFunction residualFunction, LevenbergMarquardtJacobianFunction jacobianFunction, void* userData )
+{
+  if( parametersNumber == 0 || residualsNumber == 0 || residualFunction == NULL ) return NULL;
+  
+  if( parametersNumber * residualsNumber > MATRIX_SIZE_MAX || parametersNumber * parametersNumber > MATRIX_SIZE_MAX ) return NULL;
+  
+  LevenbergMarquardt newSolver = (LevenbergMarquardt) calloc( 1, sizeof(LevenbergMarquardtData) );
+  if( newSolver == NULL ) return NULL;
+  
+  newSolver->parametersNumber = parametersNumber;
+  newSolver->residualsNumber = residualsNumber;
+  newSolver->residualFunction = residualFunction;
+  newSolver->jacobianFunction = jacobianFunction;
+  newSolver->userData = userData;
+  
+  newSolver->parameters = Mat_Create( NULL, parametersNumber, 1 );
+  newSolver->trialParameters = Mat_Create( NULL, parametersNumber, 1 );
+  newSolver->residuals = Mat_Create( NULL, residualsNumber, 1 );
+  newSolver->trialResiduals = Mat_Create( NULL, residualsNumber, 1 );
+  newSolver->jacobian = Mat_Create( NULL, residualsNumber, parametersNumber );
+  newSolver->normalMatrix = Mat_Create( NULL, parametersNumber, parametersNumber );
+  newSolver->gradient = Mat_Create( NULL, parametersNumber, 1 );
+  newSolver->factor = Mat_Create( NULL, parametersNumber, parametersNumber );
+  newSolver->step = Mat_Create( NULL, parametersNumber, 1 );
+  newSolver->columnArray = (double*) calloc( residualsNumber, sizeof(double) );
+  newSolver->residualsArray = (double*) calloc( residualsNumber, sizeof(double) );
+  newSolver->parametersArray = (double*) calloc( parametersNumber, sizeof(double) );
+  newSolver->gradientArray = (double*) calloc( parametersNumber, sizeof(double) );
+  newSolver->stepArray = (double*) calloc( parametersNumber, sizeof(double) );
+  newSolver->diagonalArray = (double*) calloc( parametersNumber, sizeof(double) );
+  newSolver->normalColumnArray = (double*) calloc( parametersNumber, sizeof(double) );
+  
+  if( newSolver->parameters == NULL || newSolver->trialParameters == NULL || newSolver->residuals == NULL || newSolver->trialResiduals == NULL 
+      || newSolver->jacobian == NULL || newSolver->normalMatrix == NULL || newSolver->gradient == NULL || newSolver->factor == NULL 
+      || newSolver->step == NULL || newSolver->columnArray == NULL || newSolver->residualsArray == NULL || newSolver->parametersArray == NULL 
+      || newSolver->gradientArray == NULL || newSolver->stepArray == NULL || newSolver->diagonalArray == NULL || newSolver->normalColumnArray == NULL )
+  {
+    LevenbergMarquardt_Discard( newSolver );
+    return NULL;
+  }
+  
+  LevenbergMarquardt_SetSettings( newSolver, ITERATIONS_MAX_DEFAULT, TOLERANCE_DEFAULT, TOLERANCE_DEFAULT, DAMPING_DEFAULT );
+  
+  return newSolver;
+}
+
+void LevenbergMarquardt_Discard( LevenbergMarquardt solver )
+{
+  if( solver == NULL ) return;
+  
+  Mat_Discard( solver->parameters );
+  Mat_Discard( solver->trialParameters );
+  Mat_Discard( solver->residuals );
+  Mat_Discard( solver->trialResiduals );
+  Mat_Discard( solver->jacobian );
+  Mat_Discard( solver->normalMatrix );
+  Mat_Discard( solver->gradient );
+  Mat_Discard( solver->factor );
+  Mat_Discard( solver->step );
+  free( solver->columnArray );
+  free( solver->residualsArray );
+  free( solver->parametersArray );
+  free( solver->gradientArray );
+  free( solver->stepArray );
+  free( solver->diagonalArray );
+  free( solver->normalColumnArray );
+  
+  free( solver );
+}
+
+bool LevenbergMarquardt_SetSettings( LevenbergMarquardt solver, size_t iterationsMax, double gradientTolerance, double stepTolerance, double initialDamping )
+{
+  if( solver == NULL ) return false;
+  
+  if( iterationsMax == 0 || gradientTolerance < 0.0 || stepTolerance < 0.0 || initialDamping < 0.0 ) return false;
+  
+  solver->iterationsMax = iterationsMax;
+  solver->gradientTolerance = gradientTolerance;
+  solver->stepTolerance = stepTolerance;
+  solver->initialDamping = initialDamping;
+  
+  return true;
+}
+
+// Forward differences, one residuals evaluation per parameter
+static bool EvaluateJacobian( LevenbergMarquardt solver )
+{
+  if( solver->jacobianFunction != NULL ) return solver->jacobianFunction( solver->parameters, solver->jacobian, solver->userData );
+  
+  double* parametersArray = Mat_GetColumn( solver->parameters, 0, solver->parametersArray );
+  double* residualsArray = Mat_GetColumn( solver->residuals, 0, solver->residualsArray );
+  for( size_t parameter = 0; parameter < solver->parametersNumber; parameter++ )
+  {
+    double value = parametersArray[ parameter ];
+    double increment = sqrt( DBL_EPSILON ) * fmax( fabs( value ), 1.0 );
+    parametersArray[ parameter ] = value + increment;
+    Mat_SetColumn( solver->trialParameters, 0, parametersArray );
+    parametersArray[ parameter ] = value;
+    if( !solver->residualFunction( solver->trialParameters, solver->trialResiduals, solver->userData ) ) return false;
+    Mat_GetColumn( solver->trialResiduals, 0, solver->columnArray );
+    for( size_t row = 0; row < solver->residualsNumber; row++ )
+      solver->columnArray[ row ] = ( solver->columnArray[ row ] - residualsArray[ row ] ) / increment;
+    Mat_SetColumn( solver->jacobian, parameter, solver->columnArray );
+  }
+  
+  return true;
+}
+
+// Normal equations for current Jacobian: J^T J, J^T r and Marquardt scaling diag( J^T J ) (squared column norms of J)
+static void UpdateNormalEquations( LevenbergMarquardt solver )
+{
+  Mat_SymmetricRankUpdate( solver->jacobian, MATRIX_TRANSPOSE, 1.0, 0.0, solver->normalMatrix );
+  Mat_Dot( solver->jacobian, MATRIX_TRANSPOSE, solver->residuals, MATRIX_KEEP, solver->gradient );
+  Mat_GetColumn( solver->gradient, 0, solver->gradientArray );
+  
+  for( size_t parameter = 0; parameter < solver->parametersNumber; parameter++ )
+  {
+    Mat_GetColumn( solver->jacobian, parameter, solver->columnArray );
+    double squaredNorm = 0.0;
+    for( size_t row = 0; row < solver->residualsNumber; row++ )
+      squaredNorm += solver->columnArray[ row ] * solver->columnArray[ row ];
+    solver->diagonalArray[ parameter ] = squaredNorm;
+  }
+}
+
+static double GetMaxAbsolute( double* vectorArray, size_t length )
+{
+  double maxAbsolute = 0.0;
+  for( size_t index = 0; index < length; index++ )
+    maxAbsolute = fmax( maxAbsolute, fabs( vectorArray[ index ] ) );
+  return maxAbsolute;
+}
+
+// Solves ( J^T J + mu D ) h = -J^T r, with D = diag( J^T J ), reusing the normal equations formed for current Jacobian
+static bool GetDampedStep( LevenbergMarquardt solver, double damping )
+{
+  // Damped matrix is copied a whole column at a time, adding the diagonal term on the way
+  for( size_t parameter = 0; parameter < solver->parametersNumber; parameter++ )
+  {
+    Mat_GetColumn( solver->normalMatrix, parameter, solver->normalColumnArray );
+    solver->normalColumnArray[ parameter ] += damping * fmax( solver->diagonalArray[ parameter ], DIAGONAL_MIN );
+    Mat_SetColumn( solver->factor, parameter, solver->normalColumnArray );
+  }
+  
+  if( Mat_DecomposeCholesky( solver->factor, solver->factor ) == NULL ) return false;
+  
+  Mat_Scale( solver->gradient, -1.0, solver->step );
+  Mat_TriangularSolve( solver->factor, MATRIX_LOWER, MATRIX_KEEP, MATRIX_NON_UNIT_DIAGONAL, solver->step );
+  Mat_TriangularSolve( solver->factor, MATRIX_LOWER, MATRIX_TRANSPOSE, MATRIX_NON_UNIT_DIAGONAL, solver->step );
+  
+  return true;
+}
+
+// Cost reduction predicted by the damped linear model: 0.5 h^T ( mu D h - J^T r )
+static double GetPredictedReduction( LevenbergMarquardt solver, double damping )
+{
+  double* stepArray = Mat_GetColumn( solver->step, 0, solver->stepArray );
+  
+  double predictedReduction = 0.0;
+  for( size_t parameter = 0; parameter < solver->parametersNumber; parameter++ )
+  {
+    double diagonal = fmax( solver->diagonalArray[ parameter ], DIAGONAL_MIN );
+    predictedReduction += 0.5 * stepArray[ parameter ] * ( damping * diagonal * stepArray[ parameter ] - solver->gradientArray[ parameter ] );
+  }
+  return predictedReduction;
+}
+
+bool LevenbergMarquardt_Solve( LevenbergMarquardt solver, Matrix parameters )
+{
+  if( solver == NULL || parameters == NULL ) return false;
+  
+  if( Mat_GetHeight( parameters ) * Mat_GetWidth( parameters ) != solver->parametersNumber ) return false;
+  
+  // Row and column vectors share the same raw data order
+  Mat_SetColumn( solver->parameters, 0, Mat_GetData( parameters, solver->parametersArray ) );
+  
+  solver->iterationsNumber = 0;
+  if( !solver->residualFunction( solver->parameters, solver->residuals, solver->userData ) ) return false;
+  solver->cost = 0.5 * Mat_InnerProduct( solver->residuals, solver->residuals );
+  
+  double damping = solver->initialDamping, dampingGrowth = 2.0;
+  bool isConverged = false;
+  while( !isConverged && solver->iterationsNumber < solver->iterationsMax )
+  {
+    solver->iterationsNumber++;
+    
+    if( !EvaluateJacobian( solver ) ) break;
+    
+    UpdateNormalEquations( solver );
+    
+    if( GetMaxAbsolute( solver->gradientArray, solver->parametersNumber ) <= solver->gradientTolerance )
+    {
+      isConverged = true;
+      break;
+    }
+    
+    // Damping retries: Jacobian and normal equations are kept, only the damped system is refactored
+    bool isStepAccepted = false;
+    while( !isStepAccepted && damping <= DAMPING_MAX )
+    {
+      if( !GetDampedStep( solver, damping ) )
+      {
+        damping = ( damping > 0.0 ) ? damping * dampingGrowth : DAMPING_DEFAULT;
+        dampingGrowth *= 2.0;
+        continue;
+      }
+      
+      double stepNorm = Mat_Norm( solver->step );
+      if( stepNorm <= solver->stepTolerance * ( Mat_Norm( solver->parameters ) + solver->stepTolerance ) )
+      {
+        isConverged = true;
+        break;
+      }
+      
+      Mat_Sum( solver->parameters, 1.0, solver->step, 1.0, solver->trialParameters );
+      double trialCost = INFINITY;
+      if( solver->residualFunction( solver->trialParameters, solver->trialResiduals, solver->userData ) )
+        trialCost = 0.5 * Mat_InnerProduct( solver->trialResiduals, solver->trialResiduals );
+      
+      double gainRatio = ( solver->cost - trialCost ) / fmax( GetPredictedReduction( solver, damping ), DBL_MIN );
+      if( trialCost < solver->cost && gainRatio > 0.0 )
+      {
+        Mat_Copy( solver->trialParameters, solver->parameters );
+        Mat_Copy( solver->trialResiduals, solver->residuals );
+        solver->cost = trialCost;
+        // Nielsen's update: smooth damping decrease for good agreement with the linear model
+        double agreement = 2.0 * gainRatio - 1.0;
+        damping *= fmax( 1.0 / 3.0, 1.0 - agreement * agreement * agreement );
+        dampingGrowth = 2.0;
+        isStepAccepted = true;
+      }
+      else
+      {
+        damping = ( damping > 0.0 ) ? damping * dampingGrowth : DAMPING_DEFAULT;
+        dampingGrowth *= 2.0;
+      }
+    }
+    
+    if( !isStepAccepted && !isConverged ) break;
+  }
+  
+  // Keeps caller vector layout (row or column)
+  Mat_SetData( parameters, Mat_GetColumn( solver->parameters, 0, solver->parametersArray ) );
+  
+  return isConverged;
+}
+
+double LevenbergMarquardt_GetCost( LevenbergMarquardt solver )
+{
+  if( solver == NULL ) return 0.0;
+  
+  return solver->cost;
+}
+
+size_t LevenbergMarquardt_GetIterationsNumber( LevenbergMarquardt solver )
+{
+  if( solver == NULL ) return 0;
+  
+  return solver->iterationsNumber;
+}
@@ -0,0 +1,88 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file levenberg_marquardt.h
+/// @brief Nonlinear least squares (Levenberg-Marquardt/Gauss-Newton) solver, with preallocated storage for repeated fits
+
+#ifndef LEVENBERG_MARQUARDT_H
+#define LEVENBERG_MARQUARDT_H
+
+#include "matrix.h"
+
+typedef struct _LevenbergMarquardtData LevenbergMarquardtData;    ///< Levenberg-Marquardt solver internal data structure
+typedef LevenbergMarquardtData* LevenbergMarquardt;               ///< Opaque reference to Levenberg-Marquardt solver data structure
+
+/// @brief User function evaluating residuals vector r(x) to be minimized in the least squares sense
+/// @param[in] parameters reference to parameters vector x (p x 1 dimensions)
+/// @param[out] residuals reference to vector to be filled with residuals (n x 1 dimensions)
+/// @param[in] userData pointer given on solver creation
+/// @return true on success, false if residuals can't be evaluated at given parameters (trial step is rejected)
+typedef bool (*LevenbergMarquardtResidualFunction)( Matrix parameters, Matrix residuals, void* userData );
+
+/// @brief User function evaluating residuals Jacobian J(x) = dr/dx
+/// @param[in] parameters reference to parameters vector x (p x 1 dimensions)
+/// @param[out] jacobian reference to matrix to be filled with residual derivatives (n x p dimensions)
+/// @param[in] userData pointer given on solver creation
+/// @return true on success, false on errors (solve is aborted)
+typedef bool (*LevenbergMarquardtJacobianFunction)( Matrix parameters, Matrix jacobian, void* userData );
+
+
+/// @brief Creates nonlinear least squares solver, allocating all workspace
+/// @param[in] parametersNumber number of optimized parameters p
+/// @param[in] residualsNumber number of residuals n
+/// @param[in] residualFunction residuals evaluation callback
+/// @param[in] jacobianFunction Jacobian evaluation callback (NULL for forward finite differences)
+/// @param[in] userData pointer passed to callbacks (may be NULL)
+/// @return reference/pointer to allocated solver (NULL on errors or if n x p exceeds MATRIX_SIZE_MAX)
+LevenbergMarquardt LevenbergMarquardt_Create( size_t parametersNumber, size_t residualsNumber, 
+                                              LevenbergMarquardtResidualFunction residualFunction, LevenbergMarquardtJacobianFunction jacobianFunction, void* userData );
+
+/// @brief Destroys/deallocates memory of solver
+/// @param[in] solver reference to solver to be destroyed/deallocated
+void LevenbergMarquardt_Discard( LevenbergMarquardt solver );
+
+/// @brief Defines solver parameters (defaults: 100 iterations, 1e-10 tolerances, 1e-3 damping)
+/// @param[in] solver reference to solver
+/// @param[in] iterationsMax maximum number of (Jacobian evaluating) iterations
+/// @param[in] gradientTolerance convergence threshold for gradient J^T r maximum absolute value
+/// @param[in] stepTolerance convergence threshold for step norm, relative to parameters norm
+/// @param[in] initialDamping initial damping factor, relative to J^T J diagonal (0.0 for Gauss-Newton steps while they reduce the cost)
+/// @return true on success, false on errors or invalid parameters
+bool LevenbergMarquardt_SetSettings( LevenbergMarquardt solver, size_t iterationsMax, double gradientTolerance, double stepTolerance, double initialDamping );
+
+/// @brief Minimizes 0.5 ||r(x)||² from given initial guess, without allocations. Damping changes only refactor the stored normal equations
+/// @param[in] solver reference to solver
+/// @param[in,out] parameters reference to parameters vector (p elements), with initial guess as input and best found solution as output
+/// @return true if converged within the iterations limit, false otherwise or on errors
+bool LevenbergMarquardt_Solve( LevenbergMarquardt solver, Matrix parameters );
+
+/// @brief Gets final cost 0.5 ||r(x)||² of last solve
+/// @param[in] solver reference to solver
+/// @return cost value (0.0 on errors)
+double LevenbergMarquardt_GetCost( LevenbergMarquardt solver );
+
+/// @brief Gets number of iterations performed on last solve
+/// @param[in] solver reference to solver
+/// @return iterations number (0 on errors)
+size_t LevenbergMarquardt_GetIterationsNumber( LevenbergMarquardt solver );
+
+#endif // LEVENBERG_MARQUARDT_H
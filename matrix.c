@@ -24,6 +24,14 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdbool.h>
+#include <float.h>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <sys/mman.h>
+#include <unistd.h>
+#define MEMORY_LOCK_AVAILABLE
+#endif
 
 #include "matrix.h"
 
@@ -33,32 +41,473 @@
 
 // (BLAS) matrix-matrix product
 extern void dgemm_( char* tA, char* tB, int* m, int* n, int* k, double* alpha, double* A, int* ldA, double* B, int* ldB, double* beta, double* C, int* ldC );  
+// (BLAS) symmetric rank-k update
+extern void dsyrk_( char* uplo, char* trans, int* n, int* k, double* alpha, double* A, int* ldA, double* beta, double* C, int* ldC );
+// (BLAS) triangular matrix equations solve
+extern void dtrsm_( char* side, char* uplo, char* transA, char* diag, int* m, int* n, double* alpha, double* A, int* ldA, double* B, int* ldB );
+// (BLAS) triangular matrix-matrix product
+extern void dtrmm_( char* side, char* uplo, char* transA, char* diag, int* m, int* n, double* alpha, double* A, int* ldA, double* B, int* ldB );
 // (LAPACK) LU decomposition of a general matrix
 extern void dgetrf_( int* M, int *N, double* A, int* ldA, int* IPIV, int* INFO );
 // (LAPACK) generate inverse of a matrix given its LU decomposition
 extern void dgetri_( int* N, double* A, int* ldA, int* IPIV, double* WORK, int* lwork, int* INFO );
+// (LAPACK) Cholesky decomposition of a symmetric positive definite matrix
+extern void dpotrf_( char* uplo, int* N, double* A, int* ldA, int* INFO );
+// (LAPACK) reduce symmetric-definite generalized eigenproblem to standard form, given the Cholesky decomposition
+extern void dsygst_( int* itype, char* uplo, int* N, double* A, int* ldA, double* B, int* ldB, int* INFO );
+// (LAPACK) selected eigenvalues and eigenvectors of a symmetric matrix (relatively robust representations)
+extern void dsyevr_( char* jobz, char* range, char* uplo, int* N, double* A, int* ldA, double* vl, double* vu, int* il, int* iu, double* abstol, 
+                     int* M, double* W, double* Z, int* ldZ, int* ISUPPZ, double* WORK, int* lwork, int* IWORK, int* liwork, int* INFO );
+// (LAPACK) QR decomposition with column pivoting
+extern void dgeqp3_( int* M, int* N, double* A, int* ldA, int* JPVT, double* TAU, double* WORK, int* lwork, int* INFO );
+// (LAPACK) symmetric indefinite (Bunch-Kaufman) LDL^T decomposition
+extern void dsytrf_( char* uplo, int* N, double* A, int* ldA, int* IPIV, double* WORK, int* lwork, int* INFO );
+// (LAPACK) solve linear equations given a symmetric indefinite LDL^T decomposition
+extern void dsytrs_( char* uplo, int* N, int* NRHS, double* A, int* ldA, int* IPIV, double* B, int* ldB, int* INFO );
+// (LAPACK) generate elementary reflector
+extern void dlarfg_( int* N, double* alpha, double* X, int* incX, double* tau );
+// (LAPACK) apply elementary reflector
+extern void dlarf_( char* side, int* M, int* N, double* V, int* incV, double* tau, double* C, int* ldC, double* WORK );
+// (LAPACK) form triangular factor of a block reflector
+extern void dlarft_( char* direct, char* storeV, int* N, int* K, double* V, int* ldV, double* tau, double* T, int* ldT );
+// (LAPACK) apply block reflector
+extern void dlarfb_( char* side, char* trans, char* direct, char* storeV, int* M, int* N, int* K, double* V, int* ldV, 
+                     double* T, int* ldT, double* C, int* ldC, double* WORK, int* ldWORK );
+// (LAPACK) generate plane rotation
+extern void dlartg_( double* F, double* G, double* CS, double* SN, double* R );
+// (BLAS) apply plane rotation
+extern void drot_( int* N, double* X, int* incX, double* Y, int* incY, double* c, double* s );
+// (LAPACK) apply sequence of plane rotations
+extern void dlasr_( char* side, char* pivot, char* direct, int* M, int* N, double* C, double* S, double* A, int* ldA );
+
+
+#ifdef __GNUC__
+#define NO_INLINE __attribute__((noinline))
+#else
+#define NO_INLINE
+#endif
+
+#define CACHE_LINE_SIZE 64
+#define PAGE_SIZE_DEFAULT 4096
+// Elements summed sequentially into each leaf of the fixed reduction tree
+#define REDUCTION_BLOCK_LENGTH 64
+// Fixed tiling of reproducible products: op(A) tile dimensions and result register block size
+#define PRODUCT_TILE_ROWS 32
+#define PRODUCT_TILE_COUPLING 64
+#define PRODUCT_BLOCK_SIZE 4
+#define PRODUCT_PACK_LENGTH ( PRODUCT_TILE_ROWS * PRODUCT_TILE_COUPLING )
+// Elements processed between early exit checks of comparison loops (short enough inner loops for vectorization)
+#define COMPARISON_BLOCK_LENGTH 16
+// Maximum order of triangular matrices handled by in-tree kernels instead of BLAS
+#define TRIANGULAR_NATIVE_SIZE_MAX 8
+// Maximum order of symmetric indefinite matrices decomposed by in-tree kernel instead of LAPACK
+#define LDLT_NATIVE_SIZE_MAX 8
+// Maximum columns number of matrices decomposed by in-tree pivoted QR (when not stopping early) instead of LAPACK
+#define QR_NATIVE_SIZE_MAX 8
+// Fixed workspace lengths (real and integer) of generalized eigensolver (LAPACK dsyevr_), besides 2n support indexes
+#define EIGEN_WORK_LENGTH( size ) ( 26 * (size) )
+#define EIGEN_INDEXES_LENGTH( size ) ( 10 * (size) )
+// Maximum number of operands reported for a shadow verification mismatch
+#define SHADOW_INPUTS_MAX 4
+// Scratch space (in maximum size matrices) for storing precalculated powers on matrix polynomial evaluation
+#define POLYNOMIAL_POWERS_SPACE 4
+// Maximum number of powers precalculated on matrix polynomial evaluation (optimal up to degree POLYNOMIAL_STEP_MAX^2)
+#define POLYNOMIAL_STEP_MAX 32
+// Enough stack depth to cover the local scratch arrays of any matrix operation (plus the fixed size reproducible product tile)
+#define STACK_PREFAULT_SIZE ( ( 12 * MATRIX_SIZE_MAX + PRODUCT_PACK_LENGTH ) * sizeof(double) )
 
 
 struct _MatrixData
 {
   double* data;
   size_t rowsNumber, columnsNumber;
+  size_t dataLength;              // Number of elements actually allocated for data buffer
+  void* groupBlock;               // Memory block shared by co-allocated matrices (NULL for individually allocated ones)
+  bool isLocked;                  // Data buffer locked into RAM through Mat_Lock
 };
 
+// Shared state of co-allocated matrices, stored at the start of their memory block
+typedef struct _GroupData
+{
+  size_t blockSize;
+  size_t locksNumber;             // Locked members: pages are shared, so the whole block stays locked while there is any
+}
+GroupData;
 
-Matrix Mat_Create( double* data, size_t rowsNumber, size_t columnsNumber )
+struct _LDLTData
+{
+  double* factorData;             // L and D factors in LAPACK dsytrf_ lower triangle layout
+  int* pivotsList;                // LAPACK style (1-based) Bunch-Kaufman interchanges, negative for 2x2 blocks
+  double* workArray;              // Preallocated LAPACK workspace, reused on each decomposition
+  int workLength;
+  size_t size;
+  bool isDecomposed, isSingular;
+};
+
+struct _MassFactorizationData
+{
+  double* factorData;             // Cholesky factor L of M = L L^T, in lower triangle
+  double* workArray;              // Preallocated eigensolver (LAPACK dsyevr_) workspace
+  int* indexesArray;
+  size_t size;
+  bool isDecomposed;
+};
+
+struct _PermutationData
+{
+  size_t* indexesList;            // Element i holds the source position moved to position i
+  size_t size;
+};
+
+static size_t GetPageSize( void )
+{
+#ifdef MEMORY_LOCK_AVAILABLE
+  long pageSize = sysconf( _SC_PAGESIZE );
+  if( pageSize > 0 ) return (size_t) pageSize;
+#endif
+  return PAGE_SIZE_DEFAULT;
+}
+
+// Read and write back one byte of every page, forcing them to be mapped without changing contents
+static void TouchPages( void* buffer, size_t bufferSize )
+{
+  volatile char* bytesList = (volatile char*) buffer;
+  size_t pageSize = GetPageSize();
+  for( size_t byteIndex = 0; byteIndex < bufferSize; byteIndex += pageSize )
+    bytesList[ byteIndex ] = bytesList[ byteIndex ];
+  if( bufferSize > 0 ) bytesList[ bufferSize - 1 ] = bytesList[ bufferSize - 1 ];
+}
+
+// Memory locking works on whole pages, so buffers to be locked get pages of their own 
+// (otherwise unlocking one buffer would also unlock heap neighbours still locked by others)
+static size_t GetPagesSize( size_t bufferSize )
+{
+  size_t pageSize = GetPageSize();
+  return ( ( bufferSize + pageSize - 1 ) / pageSize ) * pageSize;
+}
+
+static void* AllocatePages( size_t bufferSize )
+{
+  void* buffer = NULL;
+#ifdef MEMORY_LOCK_AVAILABLE
+  if( posix_memalign( &buffer, GetPageSize(), GetPagesSize( bufferSize ) ) != 0 ) return NULL;
+#else
+  buffer = malloc( bufferSize );
+#endif
+  return buffer;
+}
+
+static bool LockBuffer( void* buffer, size_t bufferSize )
+{
+  if( bufferSize == 0 ) return true;
+#ifdef MEMORY_LOCK_AVAILABLE
+  if( mlock( buffer, bufferSize ) != 0 ) return false;
+  TouchPages( buffer, bufferSize );
+  return true;
+#else
+  return false;
+#endif
+}
+
+static void UnlockBuffer( void* buffer, size_t bufferSize )
+{
+#ifdef MEMORY_LOCK_AVAILABLE
+  if( bufferSize > 0 ) munlock( buffer, bufferSize );
+#endif
+}
+
+
+// Reproducible mode: results must not depend on external BLAS (possibly multithreaded) blocking choices
+static bool isReproducible = false;
+
+// Sum of element products (or of plain elements, if second list is NULL) with a fixed summation order,
+// defined only by elements number: fixed length blocks summed over 4 lanes, then partial sums combined pairwise,
+// so that any split of the blocks among threads would give bitwise identical results
+static double ReduceProducts( const double* data_1, const double* data_2, size_t elementsNumber )
+{
+  double partialsList[ MATRIX_SIZE_MAX / REDUCTION_BLOCK_LENGTH + 1 ];
+  
+  size_t blocksNumber = 0;
+  for( size_t blockStart = 0; blockStart < elementsNumber; blockStart += REDUCTION_BLOCK_LENGTH )
+  {
+    size_t blockLength = ( blockStart + REDUCTION_BLOCK_LENGTH < elementsNumber ) ? REDUCTION_BLOCK_LENGTH : elementsNumber - blockStart;
+    double lanesList[ 4 ] = { 0.0, 0.0, 0.0, 0.0 };
+    for( size_t elementIndex = 0; elementIndex < blockLength; elementIndex++ )
+    {
+      double factor = ( data_2 != NULL ) ? data_2[ blockStart + elementIndex ] : 1.0;
+      lanesList[ elementIndex % 4 ] += data_1[ blockStart + elementIndex ] * factor;
+    }
+    partialsList[ blocksNumber++ ] = ( lanesList[ 0 ] + lanesList[ 1 ] ) + ( lanesList[ 2 ] + lanesList[ 3 ] );
+  }
+  
+  if( blocksNumber == 0 ) return 0.0;
+  
+  while( blocksNumber > 1 )
+  {
+    size_t pairsNumber = blocksNumber / 2;
+    for( size_t pairIndex = 0; pairIndex < pairsNumber; pairIndex++ )
+      partialsList[ pairIndex ] = partialsList[ 2 * pairIndex ] + partialsList[ 2 * pairIndex + 1 ];
+    if( blocksNumber % 2 == 1 ) partialsList[ pairsNumber ] = partialsList[ blocksNumber - 1 ];
+    blocksNumber = ( blocksNumber + 1 ) / 2;
+  }
+  
+  return partialsList[ 0 ];
+}
+
+// Shadow verification: sampled calls of in-tree (fast path) kernels are cross-checked against reference BLAS/LAPACK ones
+static double shadowSampleRate = 0.0;
+static double shadowSampleCredit = 0.0;
+static double shadowTolerance = 0.0;
+static MatrixMismatchCallback shadowCallback = NULL;
+static size_t shadowChecksNumber = 0;
+static size_t shadowMismatchesNumber = 0;
+
+// Deterministic sampling: accumulate rate credit on each call and verify whenever it completes a unit
+static bool ShouldVerifyShadow( void )
+{
+  if( shadowSampleRate <= 0.0 ) return false;
+  
+  shadowSampleCredit += shadowSampleRate;
+  if( shadowSampleCredit < 1.0 ) return false;
+  
+  shadowSampleCredit -= 1.0;
+  return true;
+}
+
+// Non-owning header over existing data, only valid during the verification call
+static MatrixData WrapData( const double* data, size_t rowsNumber, size_t columnsNumber )
+{
+  MatrixData wrapper = { (double*) data, rowsNumber, columnsNumber, rowsNumber * columnsNumber, NULL, false };
+  return wrapper;
+}
+
+static void VerifyShadow( const char* operationName, MatrixData* inputsList, size_t inputsNumber, 
+                          const double* fastData, const double* referenceData, size_t rowsNumber, size_t columnsNumber )
+{
+  MatrixData fastResult = WrapData( fastData, rowsNumber, columnsNumber );
+  MatrixData referenceResult = WrapData( referenceData, rowsNumber, columnsNumber );
+  Matrix inputsReferences[ SHADOW_INPUTS_MAX ];
+  
+  shadowChecksNumber++;
+  
+  if( Mat_ApproxEqual( &fastResult, &referenceResult, shadowTolerance, shadowTolerance ) ) return;
+  
+  shadowMismatchesNumber++;
+  
+  if( shadowCallback == NULL ) return;
+  
+  // Only the first inputs are reported, and the callback gets the number of actually filled references
+  if( inputsNumber > SHADOW_INPUTS_MAX ) inputsNumber = SHADOW_INPUTS_MAX;
+  for( size_t inputIndex = 0; inputIndex < inputsNumber; inputIndex++ )
+    inputsReferences[ inputIndex ] = &(inputsList[ inputIndex ]);
+  
+  shadowCallback( operationName, inputsReferences, inputsNumber, &fastResult, &referenceResult, Mat_MaxAbsDiff( &fastResult, &referenceResult ) );
+}
+
+// Updates 4x4 block of result (or smaller, at edges) with products of packed op(A) tile rows and op(B) columns, with all accumulators in registers.
+// Edge blocks are computed in full, over zero padded rows and repeated columns, and only their valid elements are stored, 
+// so that every element gets the same operations, accumulated in ascending order of the coupling index
+static void MultiplyBlock( size_t blockRowsNumber, size_t blockColumnsNumber, size_t couplingLength, const double* packedData, size_t packedStride, 
+                           const double* data_2, size_t couplingStep_2, size_t columnStep_2, double* resultData, size_t resultStride )
+{
+  double blockArray[ PRODUCT_BLOCK_SIZE * PRODUCT_BLOCK_SIZE ] = { 0.0 };
+  size_t offsetsList[ PRODUCT_BLOCK_SIZE ];
+  
+  bool isFullBlock = ( blockRowsNumber == PRODUCT_BLOCK_SIZE && blockColumnsNumber == PRODUCT_BLOCK_SIZE );
+  double* blockData = isFullBlock ? resultData : blockArray;
+  size_t blockStride = isFullBlock ? resultStride : PRODUCT_BLOCK_SIZE;
+  for( size_t column = 0; column < PRODUCT_BLOCK_SIZE; column++ )
+    offsetsList[ column ] = ( column < blockColumnsNumber ) ? column * columnStep_2 : 0;
+  for( size_t column = 0; column < blockColumnsNumber && !isFullBlock; column++ )
+  {
+    for( size_t row = 0; row < blockRowsNumber; row++ )
+      blockArray[ column * PRODUCT_BLOCK_SIZE + row ] = resultData[ column * resultStride + row ];
+  }
+  
+  double* column_0 = blockData;
+  double* column_1 = blockData + blockStride;
+  double* column_2 = blockData + 2 * blockStride;
+  double* column_3 = blockData + 3 * blockStride;
+  double sum_00 = column_0[ 0 ], sum_10 = column_0[ 1 ], sum_20 = column_0[ 2 ], sum_30 = column_0[ 3 ];
+  double sum_01 = column_1[ 0 ], sum_11 = column_1[ 1 ], sum_21 = column_1[ 2 ], sum_31 = column_1[ 3 ];
+  double sum_02 = column_2[ 0 ], sum_12 = column_2[ 1 ], sum_22 = column_2[ 2 ], sum_32 = column_2[ 3 ];
+  double sum_03 = column_3[ 0 ], sum_13 = column_3[ 1 ], sum_23 = column_3[ 2 ], sum_33 = column_3[ 3 ];
+  size_t offset_0 = offsetsList[ 0 ], offset_1 = offsetsList[ 1 ], offset_2 = offsetsList[ 2 ], offset_3 = offsetsList[ 3 ];
+  for( size_t couplingIndex = 0; couplingIndex < couplingLength; couplingIndex++ )
+  {
+    const double* a = packedData + couplingIndex * packedStride;
+    const double* b = data_2 + couplingIndex * couplingStep_2;
+    double b_0 = b[ offset_0 ], b_1 = b[ offset_1 ], b_2 = b[ offset_2 ], b_3 = b[ offset_3 ];
+    sum_00 += a[ 0 ] * b_0; sum_10 += a[ 1 ] * b_0; sum_20 += a[ 2 ] * b_0; sum_30 += a[ 3 ] * b_0;
+    sum_01 += a[ 0 ] * b_1; sum_11 += a[ 1 ] * b_1; sum_21 += a[ 2 ] * b_1; sum_31 += a[ 3 ] * b_1;
+    sum_02 += a[ 0 ] * b_2; sum_12 += a[ 1 ] * b_2; sum_22 += a[ 2 ] * b_2; sum_32 += a[ 3 ] * b_2;
+    sum_03 += a[ 0 ] * b_3; sum_13 += a[ 1 ] * b_3; sum_23 += a[ 2 ] * b_3; sum_33 += a[ 3 ] * b_3;
+  }
+  column_0[ 0 ] = sum_00; column_0[ 1 ] = sum_10; column_0[ 2 ] = sum_20; column_0[ 3 ] = sum_30;
+  column_1[ 0 ] = sum_01; column_1[ 1 ] = sum_11; column_1[ 2 ] = sum_21; column_1[ 3 ] = sum_31;
+  column_2[ 0 ] = sum_02; column_2[ 1 ] = sum_12; column_2[ 2 ] = sum_22; column_2[ 3 ] = sum_32;
+  column_3[ 0 ] = sum_03; column_3[ 1 ] = sum_13; column_3[ 2 ] = sum_23; column_3[ 3 ] = sum_33;
+  
+  for( size_t column = 0; column < blockColumnsNumber && !isFullBlock; column++ )
+  {
+    for( size_t row = 0; row < blockRowsNumber; row++ )
+      resultData[ column * resultStride + row ] = blockArray[ column * PRODUCT_BLOCK_SIZE + row ];
+  }
+}
+
+// In-tree kernel with fixed blocking: op(A) is split into tiles of fixed size, packed into contiguous columns when needed (transposed storage 
+// or rows number not multiple of the block size), and each tile updates the result in register blocks. Coupling tiles are visited in ascending order 
+// and each element is accumulated in ascending order of the coupling index, so results do not depend on tiling, operands transposition/padding 
+// or on how tiles could be split among threads
+static void MultiplyNative( char transpose_1, char transpose_2, size_t rowsNumber, size_t columnsNumber, size_t couplingLength, 
+                            const double* data_1, size_t stride_1, const double* data_2, size_t stride_2, double* resultData )
+{
+  double packedArray[ PRODUCT_PACK_LENGTH ];
+  
+  size_t rowStep_1 = ( transpose_1 == MATRIX_TRANSPOSE ) ? stride_1 : 1;
+  size_t couplingStep_1 = ( transpose_1 == MATRIX_TRANSPOSE ) ? 1 : stride_1;
+  size_t couplingStep_2 = ( transpose_2 == MATRIX_TRANSPOSE ) ? stride_2 : 1;
+  size_t columnStep_2 = ( transpose_2 == MATRIX_TRANSPOSE ) ? 1 : stride_2;
+  
+  memset( resultData, 0, rowsNumber * columnsNumber * sizeof(double) );
+  
+  for( size_t tileRow = 0; tileRow < rowsNumber; tileRow += PRODUCT_TILE_ROWS )
+  {
+    size_t tileRowsNumber = ( rowsNumber - tileRow < PRODUCT_TILE_ROWS ) ? rowsNumber - tileRow : PRODUCT_TILE_ROWS;
+    size_t paddedRowsNumber = ( ( tileRowsNumber + PRODUCT_BLOCK_SIZE - 1 ) / PRODUCT_BLOCK_SIZE ) * PRODUCT_BLOCK_SIZE;
+    for( size_t tileCoupling = 0; tileCoupling < couplingLength; tileCoupling += PRODUCT_TILE_COUPLING )
+    {
+      size_t tileCouplingLength = ( couplingLength - tileCoupling < PRODUCT_TILE_COUPLING ) ? couplingLength - tileCoupling : PRODUCT_TILE_COUPLING;
+      const double* tileData_1 = data_1 + tileCoupling * couplingStep_1 + tileRow * rowStep_1;
+      size_t tileStride_1 = stride_1;
+      if( transpose_1 == MATRIX_TRANSPOSE || paddedRowsNumber > tileRowsNumber )
+      {
+        for( size_t couplingIndex = 0; couplingIndex < tileCouplingLength; couplingIndex++ )
+        {
+          double* packedColumn = packedArray + couplingIndex * paddedRowsNumber;
+          for( size_t row = 0; row < tileRowsNumber; row++ )
+            packedColumn[ row ] = tileData_1[ couplingIndex * couplingStep_1 + row * rowStep_1 ];
+          for( size_t row = tileRowsNumber; row < paddedRowsNumber; row++ )
+            packedColumn[ row ] = 0.0;
+        }
+        tileData_1 = packedArray;
+        tileStride_1 = paddedRowsNumber;
+      }
+      
+      const double* tileData_2 = data_2 + tileCoupling * couplingStep_2;
+      for( size_t column = 0; column < columnsNumber; column += PRODUCT_BLOCK_SIZE )
+      {
+        size_t blockColumnsNumber = ( columnsNumber - column < PRODUCT_BLOCK_SIZE ) ? columnsNumber - column : PRODUCT_BLOCK_SIZE;
+        for( size_t row = 0; row < tileRowsNumber; row += PRODUCT_BLOCK_SIZE )
+        {
+          size_t blockRowsNumber = ( tileRowsNumber - row < PRODUCT_BLOCK_SIZE ) ? tileRowsNumber - row : PRODUCT_BLOCK_SIZE;
+          MultiplyBlock( blockRowsNumber, blockColumnsNumber, tileCouplingLength, tileData_1 + row, tileStride_1, 
+                         tileData_2 + column * columnStep_2, couplingStep_2, columnStep_2, resultData + column * rowsNumber + tileRow + row, rowsNumber );
+        }
+      }
+    }
+  }
+}
+
+static void MultiplyReference( char transpose_1, char transpose_2, size_t rowsNumber, size_t columnsNumber, size_t couplingLength, 
+                               const double* data_1, size_t stride_1, const double* data_2, size_t stride_2, double* resultData )
+{
+  double alpha = 1.0, beta = 0.0;
+  char trans_1 = ( transpose_1 == MATRIX_TRANSPOSE ) ? 'T' : 'N';
+  char trans_2 = ( transpose_2 == MATRIX_TRANSPOSE ) ? 'T' : 'N';
+  int m = (int) rowsNumber, n = (int) columnsNumber, k = (int) couplingLength;
+  int ld_1 = (int) stride_1, ld_2 = (int) stride_2, ld = (int) rowsNumber;
+  dgemm_( &trans_1, &trans_2, &m, &n, &k, &alpha, (double*) data_1, &ld_1, (double*) data_2, &ld_2, &beta, resultData, &ld );
+}
+
+// Kept out of line, so that only sampled products pay for the reference result scratch array
+static void NO_INLINE VerifyMultiplyShadow( char transpose_1, char transpose_2, size_t rowsNumber, size_t columnsNumber, size_t couplingLength, 
+                                            const double* data_1, size_t stride_1, const double* data_2, size_t stride_2, const double* resultData )
+{
+  double referenceArray[ MATRIX_SIZE_MAX ];
+  
+  MultiplyReference( transpose_1, transpose_2, rowsNumber, columnsNumber, couplingLength, data_1, stride_1, data_2, stride_2, referenceArray );
+  MatrixData inputsList[ 2 ] = { WrapData( data_1, stride_1, ( transpose_1 == MATRIX_TRANSPOSE ) ? rowsNumber : couplingLength ),
+                                 WrapData( data_2, stride_2, ( transpose_2 == MATRIX_TRANSPOSE ) ? couplingLength : columnsNumber ) };
+  char operationName[ 16 ];
+  snprintf( operationName, sizeof(operationName), "Dot(%c,%c)", ( transpose_1 == MATRIX_TRANSPOSE ) ? 'T' : 'N', ( transpose_2 == MATRIX_TRANSPOSE ) ? 'T' : 'N' );
+  VerifyShadow( operationName, inputsList, 2, resultData, referenceArray, rowsNumber, columnsNumber );
+}
+
+// Column-major product C = op(A) * op(B), with given distances between columns of the stored (non transposed) arrays
+static void MultiplyData( char transpose_1, char transpose_2, size_t rowsNumber, size_t columnsNumber, size_t couplingLength, 
+                          const double* data_1, size_t stride_1, const double* data_2, size_t stride_2, double* resultData )
+{
+  if( rowsNumber == 0 || columnsNumber == 0 ) return;
+  
+  if( !isReproducible && couplingLength > 0 )
+  {
+    MultiplyReference( transpose_1, transpose_2, rowsNumber, columnsNumber, couplingLength, data_1, stride_1, data_2, stride_2, resultData );
+    return;
+  }
+  
+  MultiplyNative( transpose_1, transpose_2, rowsNumber, columnsNumber, couplingLength, data_1, stride_1, data_2, stride_2, resultData );
+  
+  if( couplingLength > 0 && ShouldVerifyShadow() )
+    VerifyMultiplyShadow( transpose_1, transpose_2, rowsNumber, columnsNumber, couplingLength, data_1, stride_1, data_2, stride_2, resultData );
+}
+
+static Matrix AllocateMatrix( size_t rowsNumber, size_t columnsNumber, bool zeroed )
 {
   if( rowsNumber * columnsNumber > MATRIX_SIZE_MAX ) return NULL;
 
   Matrix newMatrix = (Matrix) malloc( sizeof(MatrixData) );
+  if( newMatrix == NULL ) return NULL;
 
-  newMatrix->data = (double*) calloc( rowsNumber * columnsNumber, sizeof(double) );
+  // calloc'd memory is already zeroed (usually for free, on fresh pages), so there is no need for a further clearing pass
+  if( zeroed ) newMatrix->data = (double*) calloc( rowsNumber * columnsNumber, sizeof(double) );
+  else newMatrix->data = (double*) malloc( rowsNumber * columnsNumber * sizeof(double) );
+
+  if( newMatrix->data == NULL && rowsNumber * columnsNumber > 0 )
+  {
+    free( newMatrix );
+    return NULL;
+  }
 
   newMatrix->rowsNumber = rowsNumber;
   newMatrix->columnsNumber = columnsNumber;
+  newMatrix->dataLength = rowsNumber * columnsNumber;
+  newMatrix->groupBlock = NULL;
+  newMatrix->isLocked = false;
+
+  return newMatrix;
+}
+
+Matrix Mat_Create( double* data, size_t rowsNumber, size_t columnsNumber )
+{
+  Matrix newMatrix = AllocateMatrix( rowsNumber, columnsNumber, ( data == NULL ) );
+  if( newMatrix == NULL ) return NULL;
+
+  if( data != NULL ) Mat_SetData( newMatrix, data );
 
-  if( data == NULL ) Mat_Clear( newMatrix );
-  else Mat_SetData( newMatrix, data );
+  return newMatrix;
+}
+
+Matrix Mat_CreateUninitialized( size_t rowsNumber, size_t columnsNumber )
+{
+  return AllocateMatrix( rowsNumber, columnsNumber, false );
+}
+
+Matrix Mat_CreateLike( Matrix matrix )
+{
+  if( matrix == NULL ) return NULL;
+
+  return AllocateMatrix( matrix->rowsNumber, matrix->columnsNumber, false );
+}
+
+Matrix Mat_CreateFromColumnMajor( double* data, size_t rowsNumber, size_t columnsNumber )
+{
+  if( data == NULL ) return NULL;
+
+  Matrix newMatrix = AllocateMatrix( rowsNumber, columnsNumber, false );
+  if( newMatrix == NULL ) return NULL;
+
+  memcpy( newMatrix->data, data, rowsNumber * columnsNumber * sizeof(double) );
 
   return newMatrix;
 }
@@ -76,19 +525,176 @@ Matrix Mat_CreateSquare( size_t size, char type )
   return newSquareMatrix;
 }
 
+Matrix* Mat_CreateGroup( size_t count, MatrixShape* shapes, size_t* accessOrder, Matrix* groupList )
+{
+  if( shapes == NULL || groupList == NULL || count == 0 || count > MATRIX_SIZE_MAX ) return NULL;
+  
+  // Out of range indexes are rejected before allocation, repeated ones while laying out buffers
+  for( size_t orderIndex = 0; accessOrder != NULL && orderIndex < count; orderIndex++ )
+  {
+    if( accessOrder[ orderIndex ] >= count ) return NULL;
+  }
+
+  size_t headersSize = count * sizeof(MatrixData);
+  // Group state takes the first cache line
+  size_t blockSize = 2 * CACHE_LINE_SIZE + headersSize;
+  for( size_t matrixIndex = 0; matrixIndex < count; matrixIndex++ )
+  {
+    size_t elementsNumber = shapes[ matrixIndex ].rowsNumber * shapes[ matrixIndex ].columnsNumber;
+    if( elementsNumber > MATRIX_SIZE_MAX ) return NULL;
+    // Each buffer starts at its own cache line, so that no line is shared between 2 matrices
+    blockSize += CACHE_LINE_SIZE + elementsNumber * sizeof(double);
+  }
+
+  // Page aligned block, so that it can be locked without affecting other allocations
+  GroupData* groupBlock = (GroupData*) AllocatePages( blockSize );
+  if( groupBlock == NULL ) return NULL;
+  
+  groupBlock->blockSize = blockSize;
+  groupBlock->locksNumber = 0;
+  
+  uintptr_t blockAddress = ( (uintptr_t) groupBlock + sizeof(GroupData) + CACHE_LINE_SIZE - 1 ) & ~( (uintptr_t) CACHE_LINE_SIZE - 1 );
+  MatrixData* headersList = (MatrixData*) blockAddress;
+  uintptr_t dataAddress = blockAddress + headersSize;
+  for( size_t matrixIndex = 0; matrixIndex < count; matrixIndex++ )
+    headersList[ matrixIndex ].data = NULL;
+  // Buffers are laid out in given access order (or in list order, if none is provided), while headers follow list order
+  for( size_t orderIndex = 0; orderIndex < count; orderIndex++ )
+  {
+    size_t matrixIndex = ( accessOrder != NULL ) ? accessOrder[ orderIndex ] : orderIndex;
+    dataAddress = ( dataAddress + CACHE_LINE_SIZE - 1 ) & ~( (uintptr_t) CACHE_LINE_SIZE - 1 );
+    Matrix member = &(headersList[ matrixIndex ]);
+    // Every header must get a buffer: reject orders with repeated indexes (headers already laid out)
+    if( member->data != NULL )
+    {
+      free( groupBlock );
+      return NULL;
+    }
+    member->rowsNumber = shapes[ matrixIndex ].rowsNumber;
+    member->columnsNumber = shapes[ matrixIndex ].columnsNumber;
+    member->dataLength = member->rowsNumber * member->columnsNumber;
+    member->data = (double*) dataAddress;
+    member->groupBlock = groupBlock;
+    member->isLocked = false;
+    memset( member->data, 0, member->dataLength * sizeof(double) );
+    dataAddress += member->dataLength * sizeof(double);
+  }
+  
+  for( size_t matrixIndex = 0; matrixIndex < count; matrixIndex++ )
+    groupList[ matrixIndex ] = &(headersList[ matrixIndex ]);
+
+  return groupList;
+}
+
+void Mat_DiscardGroup( Matrix member )
+{
+  if( member == NULL ) return;
+  
+  GroupData* group = (GroupData*) member->groupBlock;
+  if( group == NULL ) return;
+  
+  // Block pages stay locked while any member is locked
+  if( group->locksNumber > 0 ) UnlockBuffer( group, GetPagesSize( group->blockSize ) );
+  
+  free( group );
+}
+
 void Mat_Discard( Matrix matrix )
 {
   if( matrix == NULL ) return;
+  // Group members are only released together, by Mat_DiscardGroup
+  if( matrix->groupBlock != NULL ) return;
+  
+  Mat_Unlock( matrix );
   
   free( matrix->data );
   
   free( matrix );
 }
 
+bool Mat_Lock( Matrix matrix )
+{
+  if( matrix == NULL ) return false;
+  
+  if( matrix->isLocked ) return true;
+  
+  if( matrix->groupBlock != NULL )
+  {
+    // Members share pages: the whole group block is locked by its first locked member and unlocked by its last one
+    GroupData* group = (GroupData*) matrix->groupBlock;
+    if( group->locksNumber == 0 && !LockBuffer( group, GetPagesSize( group->blockSize ) ) ) return false;
+    group->locksNumber++;
+  }
+  else if( matrix->dataLength > 0 )
+  {
+    // Data is moved to dedicated pages before locking
+    size_t bufferSize = matrix->dataLength * sizeof(double);
+    double* pagesData = (double*) AllocatePages( bufferSize );
+    if( pagesData == NULL ) return false;
+    
+    memcpy( pagesData, matrix->data, bufferSize );
+    if( !LockBuffer( pagesData, GetPagesSize( bufferSize ) ) )
+    {
+      free( pagesData );
+      return false;
+    }
+    
+    free( matrix->data );
+    matrix->data = pagesData;
+  }
+  
+  matrix->isLocked = true;
+  
+  return true;
+}
+
+void Mat_Unlock( Matrix matrix )
+{
+  if( matrix == NULL ) return;
+  
+  if( !matrix->isLocked ) return;
+  
+  if( matrix->groupBlock != NULL )
+  {
+    GroupData* group = (GroupData*) matrix->groupBlock;
+    if( --group->locksNumber == 0 ) UnlockBuffer( group, GetPagesSize( group->blockSize ) );
+  }
+  else UnlockBuffer( matrix->data, GetPagesSize( matrix->dataLength * sizeof(double) ) );
+  
+  matrix->isLocked = false;
+}
+
+// Kept out of line, so that the scratch array really extends the stack below the caller's frame
+static void NO_INLINE PrefaultStack( void )
+{
+  volatile char stackScratch[ STACK_PREFAULT_SIZE ];
+  size_t pageSize = GetPageSize();
+  for( size_t byteIndex = 0; byteIndex < STACK_PREFAULT_SIZE; byteIndex += pageSize )
+    stackScratch[ byteIndex ] = 0;
+  (void) stackScratch[ 0 ];
+}
+
+bool Mat_PrefaultAll( void )
+{
+  bool success = true;
+#ifdef MEMORY_LOCK_AVAILABLE
+  // Lock current and future mappings (including new matrices and resized buffers) into RAM
+  if( mlockall( MCL_CURRENT | MCL_FUTURE ) != 0 ) success = false;
+#else
+  success = false;
+#endif
+  PrefaultStack();
+  
+  return success;
+}
+
 Matrix Mat_Copy( Matrix source, Matrix destination )
 {
   if( source == NULL || destination == NULL ) return NULL;
 
+  // Destination may be reshaped, but never beyond its allocated space (group members have no spare capacity)
+  if( source->rowsNumber * source->columnsNumber > destination->dataLength ) return NULL;
+
   destination->rowsNumber = source->rowsNumber;
   destination->columnsNumber = source->columnsNumber;
 
@@ -162,163 +768,2158 @@ void Mat_SetData( Matrix matrix, double* data )
   }
 }
 
-Matrix Mat_Resize( Matrix matrix, size_t rowsNumber, size_t columnsNumber )
+double* Mat_GetColumnMajorData( Matrix matrix, double* buffer )
 {
-  double auxArray[ MATRIX_SIZE_MAX ];
-  
-  if( matrix == NULL )
-    matrix = Mat_Create( NULL, rowsNumber, columnsNumber );
-  else 
-  {
-    if( matrix->rowsNumber * matrix->columnsNumber < rowsNumber * columnsNumber )
-      matrix->data = (double*) realloc( matrix->data, rowsNumber * columnsNumber * sizeof(double) );
-  
-    memcpy( auxArray, matrix->data, matrix->rowsNumber * matrix->columnsNumber * sizeof(double) );
-    
-    memset( matrix->data, 0, rowsNumber * columnsNumber * sizeof(double) );
-    
-    for( size_t column = 0; column < matrix->columnsNumber; column++ )
-    {
-      for( size_t row = 0; row < matrix->rowsNumber; row++ )
-        matrix->data[ column * rowsNumber + row ] = auxArray[ column * matrix->rowsNumber + row ];
-    }
-    
-    matrix->rowsNumber = rowsNumber;
-    matrix->columnsNumber = columnsNumber;
-  }
+  if( matrix == NULL || buffer == NULL ) return NULL;
 
-  return matrix;
+  memcpy( buffer, matrix->data, matrix->rowsNumber * matrix->columnsNumber * sizeof(double) );
+
+  return buffer;
 }
 
-Matrix Mat_Scale( Matrix matrix, double scalar, Matrix result )
+void Mat_SetColumnMajorData( Matrix matrix, double* data )
 {
-  if( matrix == NULL ) return NULL;
-  
-  size_t elementsNumber = result->rowsNumber * result->columnsNumber;
-  for( size_t elementIndex = 0; elementIndex < elementsNumber; elementIndex++ )
-    result->data[ elementIndex ] = scalar * matrix->data[ elementIndex ];
+  if( matrix == NULL || data == NULL ) return;
 
-  result->rowsNumber = matrix->rowsNumber;
-  result->columnsNumber = matrix->columnsNumber;
-  
-  return result;
+  memcpy( matrix->data, data, matrix->rowsNumber * matrix->columnsNumber * sizeof(double) );
 }
 
-Matrix Mat_Sum( Matrix matrix_1, double weight_1, Matrix matrix_2, double weight_2, Matrix result )
+double* Mat_GetRow( Matrix matrix, size_t row, double* buffer )
 {
-  if( matrix_1 == NULL || matrix_2 == NULL ) return NULL;
+  if( matrix == NULL || buffer == NULL ) return NULL;
 
-  if( matrix_1->rowsNumber != matrix_2->rowsNumber || matrix_1->columnsNumber != matrix_2->columnsNumber ) return NULL;
+  if( row >= matrix->rowsNumber ) return NULL;
 
-  result->rowsNumber = matrix_1->rowsNumber;
-  result->columnsNumber = matrix_1->columnsNumber;
-  
-  size_t elementsNumber = result->rowsNumber * result->columnsNumber;
-  for( size_t elementIndex = 0; elementIndex < elementsNumber; elementIndex++ )
-    result->data[ elementIndex ] = weight_1 * matrix_1->data[ elementIndex ] + weight_2 * matrix_2->data[ elementIndex ];
+  const double* rowData = matrix->data + row;
+  for( size_t column = 0; column < matrix->columnsNumber; column++ )
+    buffer[ column ] = rowData[ column * matrix->rowsNumber ];
 
-  return result;
+  return buffer;
 }
 
-Matrix Mat_Dot( Matrix matrix_1, char transpose_1, Matrix matrix_2, char transpose_2, Matrix result )
+void Mat_SetRow( Matrix matrix, size_t row, double* data )
 {
-  const double alpha = 1.0;
-  const double beta = 0.0;
-  
-  double auxArray[ MATRIX_SIZE_MAX ];
-  
-  if( matrix_1 == NULL || matrix_2 == NULL ) return NULL;
-  
-  size_t couplingLength = ( transpose_1 == MATRIX_TRANSPOSE ) ? matrix_1->rowsNumber : matrix_1->columnsNumber;
-   
-  if( couplingLength != ( ( transpose_2 == MATRIX_TRANSPOSE ) ? matrix_2->columnsNumber : matrix_2->rowsNumber ) ) return NULL;
-   
-  result->rowsNumber = ( transpose_1 == MATRIX_TRANSPOSE ) ? matrix_1->columnsNumber : matrix_1->rowsNumber;
-  result->columnsNumber = ( transpose_2 == MATRIX_TRANSPOSE ) ? matrix_2->rowsNumber : matrix_2->columnsNumber;
-  
-  int stride_1 = ( transpose_1 == MATRIX_TRANSPOSE ) ? couplingLength : result->rowsNumber;          // Distance between columns
-  int stride_2 = ( transpose_2 == MATRIX_TRANSPOSE ) ? result->columnsNumber : couplingLength;       // Distance between columns
-  
-  dgemm_( &transpose_1, &transpose_2, (int*) &(result->rowsNumber),(int*) &(result->columnsNumber), (int*) &(couplingLength), 
-          (double*) &alpha, matrix_1->data, &stride_1, matrix_2->data, &stride_2, (double*) &beta, auxArray, (int*) &result->rowsNumber );
-  
-  memcpy( result->data, auxArray, result->rowsNumber * result->columnsNumber * sizeof(double) );
+  if( matrix == NULL || data == NULL ) return;
 
-  return result;
+  if( row >= matrix->rowsNumber ) return;
+
+  double* rowData = matrix->data + row;
+  for( size_t column = 0; column < matrix->columnsNumber; column++ )
+    rowData[ column * matrix->rowsNumber ] = data[ column ];
 }
 
-double Mat_Determinant( Matrix matrix )
+double* Mat_GetColumn( Matrix matrix, size_t column, double* buffer )
 {
-  double auxArray[ MATRIX_SIZE_MAX ];
-  int pivotArray[ MATRIX_SIZE_MAX ];
-  int info;
-  
-  if( matrix == NULL ) return 0.0;
+  if( matrix == NULL || buffer == NULL ) return NULL;
 
-  if( matrix->rowsNumber != matrix->columnsNumber ) return 0.0;
-  
-  memcpy( auxArray, matrix->data, matrix->rowsNumber * matrix->columnsNumber * sizeof(double) );
-  
-  dgetrf_( (int*) &(matrix->rowsNumber), (int*) &(matrix->columnsNumber), auxArray, (int*) &(matrix->rowsNumber), pivotArray, &info );
+  if( column >= matrix->columnsNumber ) return NULL;
+
+  // Columns are contiguous in internal column-major storage
+  memcpy( buffer, matrix->data + column * matrix->rowsNumber, matrix->rowsNumber * sizeof(double) );
+
+  return buffer;
+}
+
+void Mat_SetColumn( Matrix matrix, size_t column, double* data )
+{
+  if( matrix == NULL || data == NULL ) return;
+
+  if( column >= matrix->columnsNumber ) return;
+
+  memcpy( matrix->data + column * matrix->rowsNumber, data, matrix->rowsNumber * sizeof(double) );
+}
+
+Matrix Mat_SwapRows( Matrix matrix, size_t row_1, size_t row_2 )
+{
+  if( matrix == NULL ) return NULL;
+
+  if( row_1 >= matrix->rowsNumber || row_2 >= matrix->rowsNumber ) return NULL;
+
+  double* rowData_1 = matrix->data + row_1;
+  double* rowData_2 = matrix->data + row_2;
+  for( size_t elementIndex = 0; elementIndex < matrix->rowsNumber * matrix->columnsNumber; elementIndex += matrix->rowsNumber )
+  {
+    double swapValue = rowData_1[ elementIndex ];
+    rowData_1[ elementIndex ] = rowData_2[ elementIndex ];
+    rowData_2[ elementIndex ] = swapValue;
+  }
+
+  return matrix;
+}
+
+Matrix Mat_SwapColumns( Matrix matrix, size_t column_1, size_t column_2 )
+{
+  if( matrix == NULL ) return NULL;
+
+  if( column_1 >= matrix->columnsNumber || column_2 >= matrix->columnsNumber ) return NULL;
+
+  double* columnData_1 = matrix->data + column_1 * matrix->rowsNumber;
+  double* columnData_2 = matrix->data + column_2 * matrix->rowsNumber;
+  if( columnData_1 == columnData_2 ) return matrix;
+  // Plain loop over 2 contiguous (non-overlapping) ranges, easily vectorized by the compiler
+  for( size_t row = 0; row < matrix->rowsNumber; row++ )
+  {
+    double swapValue = columnData_1[ row ];
+    columnData_1[ row ] = columnData_2[ row ];
+    columnData_2[ row ] = swapValue;
+  }
+
+  return matrix;
+}
+
+static bool CheckIndexes( size_t* indexesList, size_t indexesNumber, size_t limit )
+{
+  if( indexesList == NULL ) return true;
+  
+  for( size_t indexPosition = 0; indexPosition < indexesNumber; indexPosition++ )
+  {
+    if( indexesList[ indexPosition ] >= limit ) return false;
+  }
+  
+  return true;
+}
+
+Matrix Mat_Gather( Matrix matrix, size_t* rowIndexes, size_t rowsNumber, size_t* columnIndexes, size_t columnsNumber, Matrix result )
+{
+  double auxArray[ MATRIX_SIZE_MAX ];
+  
+  if( matrix == NULL || result == NULL ) return NULL;
+  
+  if( rowIndexes == NULL ) rowsNumber = matrix->rowsNumber;
+  if( columnIndexes == NULL ) columnsNumber = matrix->columnsNumber;
+  
+  if( rowsNumber * columnsNumber > result->dataLength ) return NULL;
+  
+  if( !CheckIndexes( rowIndexes, rowsNumber, matrix->rowsNumber ) ) return NULL;
+  if( !CheckIndexes( columnIndexes, columnsNumber, matrix->columnsNumber ) ) return NULL;
+  
+  // Gathering into own buffer would overwrite values yet to be read
+  double* gatherData = ( result == matrix ) ? auxArray : result->data;
+  for( size_t column = 0; column < columnsNumber; column++ )
+  {
+    size_t sourceColumn = ( columnIndexes != NULL ) ? columnIndexes[ column ] : column;
+    const double* sourceData = matrix->data + sourceColumn * matrix->rowsNumber;
+    double* columnData = gatherData + column * rowsNumber;
+    if( rowIndexes == NULL ) memcpy( columnData, sourceData, rowsNumber * sizeof(double) );
+    else
+    {
+      for( size_t row = 0; row < rowsNumber; row++ )
+        columnData[ row ] = sourceData[ rowIndexes[ row ] ];
+    }
+  }
+  
+  if( gatherData == auxArray ) memcpy( result->data, auxArray, rowsNumber * columnsNumber * sizeof(double) );
+  
+  result->rowsNumber = rowsNumber;
+  result->columnsNumber = columnsNumber;
+  
+  return result;
+}
+
+static Matrix ScatterElements( Matrix source, size_t* rowIndexes, size_t* columnIndexes, Matrix matrix, bool accumulate )
+{
+  if( source == NULL || matrix == NULL || source == matrix ) return NULL;
+  
+  if( rowIndexes == NULL && source->rowsNumber != matrix->rowsNumber ) return NULL;
+  if( columnIndexes == NULL && source->columnsNumber != matrix->columnsNumber ) return NULL;
+  
+  if( !CheckIndexes( rowIndexes, source->rowsNumber, matrix->rowsNumber ) ) return NULL;
+  if( !CheckIndexes( columnIndexes, source->columnsNumber, matrix->columnsNumber ) ) return NULL;
+  
+  for( size_t column = 0; column < source->columnsNumber; column++ )
+  {
+    size_t targetColumn = ( columnIndexes != NULL ) ? columnIndexes[ column ] : column;
+    const double* columnData = source->data + column * source->rowsNumber;
+    double* targetData = matrix->data + targetColumn * matrix->rowsNumber;
+    if( rowIndexes == NULL )
+    {
+      if( accumulate )
+      {
+        for( size_t row = 0; row < source->rowsNumber; row++ )
+          targetData[ row ] += columnData[ row ];
+      }
+      else memcpy( targetData, columnData, source->rowsNumber * sizeof(double) );
+    }
+    else if( accumulate )
+    {
+      for( size_t row = 0; row < source->rowsNumber; row++ )
+        targetData[ rowIndexes[ row ] ] += columnData[ row ];
+    }
+    else
+    {
+      for( size_t row = 0; row < source->rowsNumber; row++ )
+        targetData[ rowIndexes[ row ] ] = columnData[ row ];
+    }
+  }
+  
+  return matrix;
+}
+
+Matrix Mat_Scatter( Matrix source, size_t* rowIndexes, size_t* columnIndexes, Matrix matrix )
+{
+  return ScatterElements( source, rowIndexes, columnIndexes, matrix, false );
+}
+
+Matrix Mat_ScatterAdd( Matrix source, size_t* rowIndexes, size_t* columnIndexes, Matrix matrix )
+{
+  return ScatterElements( source, rowIndexes, columnIndexes, matrix, true );
+}
+
+Matrix Mat_Resize( Matrix matrix, size_t rowsNumber, size_t columnsNumber )
+{
+  double auxArray[ MATRIX_SIZE_MAX ];
+  
+  if( matrix == NULL )
+    matrix = Mat_Create( NULL, rowsNumber, columnsNumber );
+  else 
+  {
+    if( matrix->dataLength < rowsNumber * columnsNumber )
+    {
+      // Co-allocated matrices can't grow beyond their original space
+      if( matrix->groupBlock != NULL || rowsNumber * columnsNumber > MATRIX_SIZE_MAX ) return NULL;
+      bool wasLocked = matrix->isLocked;
+      Mat_Unlock( matrix );
+      double* newData = (double*) realloc( matrix->data, rowsNumber * columnsNumber * sizeof(double) );
+      if( newData == NULL )
+      {
+        // Old buffer is left untouched, still in its own pages, so it can be locked again in place
+        if( wasLocked ) matrix->isLocked = LockBuffer( matrix->data, GetPagesSize( matrix->dataLength * sizeof(double) ) );
+        return NULL;
+      }
+      matrix->data = newData;
+      matrix->dataLength = rowsNumber * columnsNumber;
+      // Keep real-time guarantees: the new buffer is faulted in here, not on first use (failing before any reshaping)
+      if( wasLocked && !Mat_Lock( matrix ) ) return NULL;
+    }
+  
+    memcpy( auxArray, matrix->data, matrix->rowsNumber * matrix->columnsNumber * sizeof(double) );
+    
+    memset( matrix->data, 0, rowsNumber * columnsNumber * sizeof(double) );
+    
+    // Only the block common to old and new dimensions is kept
+    size_t keptRowsNumber = ( rowsNumber < matrix->rowsNumber ) ? rowsNumber : matrix->rowsNumber;
+    size_t keptColumnsNumber = ( columnsNumber < matrix->columnsNumber ) ? columnsNumber : matrix->columnsNumber;
+    for( size_t column = 0; column < keptColumnsNumber; column++ )
+    {
+      for( size_t row = 0; row < keptRowsNumber; row++ )
+        matrix->data[ column * rowsNumber + row ] = auxArray[ column * matrix->rowsNumber + row ];
+    }
+    
+    matrix->rowsNumber = rowsNumber;
+    matrix->columnsNumber = columnsNumber;
+  }
+
+  return matrix;
+}
+
+bool Mat_ApproxEqual( Matrix matrix_1, Matrix matrix_2, double absoluteTolerance, double relativeTolerance )
+{
+  if( matrix_1 == NULL || matrix_2 == NULL ) return false;
+
+  if( matrix_1->rowsNumber != matrix_2->rowsNumber || matrix_1->columnsNumber != matrix_2->columnsNumber ) return false;
+
+  size_t elementsNumber = matrix_1->rowsNumber * matrix_1->columnsNumber;
+  for( size_t blockStart = 0; blockStart < elementsNumber; blockStart += COMPARISON_BLOCK_LENGTH )
+  {
+    size_t blockEnd = ( blockStart + COMPARISON_BLOCK_LENGTH < elementsNumber ) ? blockStart + COMPARISON_BLOCK_LENGTH : elementsNumber;
+    // Branch-free count inside the block, early exit between blocks
+    size_t mismatchesNumber = 0;
+    for( size_t elementIndex = blockStart; elementIndex < blockEnd; elementIndex++ )
+    {
+      double value_1 = matrix_1->data[ elementIndex ], value_2 = matrix_2->data[ elementIndex ];
+      double scale = ( fabs( value_1 ) > fabs( value_2 ) ) ? fabs( value_1 ) : fabs( value_2 );
+      // Negated comparison, so that NaN values are never considered equal
+      mismatchesNumber += !( fabs( value_1 - value_2 ) <= absoluteTolerance + relativeTolerance * scale );
+    }
+    if( mismatchesNumber > 0 ) return false;
+  }
+
+  return true;
+}
+
+double Mat_MaxAbsDiff( Matrix matrix_1, Matrix matrix_2 )
+{
+  if( matrix_1 == NULL || matrix_2 == NULL ) return INFINITY;
+
+  if( matrix_1->rowsNumber != matrix_2->rowsNumber || matrix_1->columnsNumber != matrix_2->columnsNumber ) return INFINITY;
+
+  double maxDifference = 0.0;
+  size_t elementsNumber = matrix_1->rowsNumber * matrix_1->columnsNumber;
+  for( size_t elementIndex = 0; elementIndex < elementsNumber; elementIndex++ )
+  {
+    double difference = fabs( matrix_1->data[ elementIndex ] - matrix_2->data[ elementIndex ] );
+    // NaN differences propagate to the result
+    if( !( difference <= maxDifference ) ) maxDifference = difference;
+  }
+
+  return maxDifference;
+}
+
+bool Mat_HasNonFinite( Matrix matrix )
+{
+  if( matrix == NULL ) return false;
+
+  size_t elementsNumber = matrix->rowsNumber * matrix->columnsNumber;
+  for( size_t blockStart = 0; blockStart < elementsNumber; blockStart += COMPARISON_BLOCK_LENGTH )
+  {
+    size_t blockEnd = ( blockStart + COMPARISON_BLOCK_LENGTH < elementsNumber ) ? blockStart + COMPARISON_BLOCK_LENGTH : elementsNumber;
+    // Multiplying by zero results in NaN only for infinite or NaN values
+    double blockCheck = 0.0;
+    for( size_t elementIndex = blockStart; elementIndex < blockEnd; elementIndex++ )
+      blockCheck += 0.0 * matrix->data[ elementIndex ];
+    if( blockCheck != 0.0 ) return true;
+  }
+
+  return false;
+}
+
+uint64_t Mat_GetFingerprint( Matrix matrix )
+{
+  const uint64_t PRIME_1 = 0x9E3779B97F4A7C15ULL, PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+  uint64_t lanesList[ 4 ] = { PRIME_1, PRIME_2, ~PRIME_1, ~PRIME_2 };
+
+  if( matrix == NULL ) return 0;
+
+  // Hash raw bit patterns over 4 independent lanes (vectorizable), then mix them with matrix dimensions
+  size_t elementsNumber = matrix->rowsNumber * matrix->columnsNumber;
+  size_t elementIndex = 0;
+  for( ; elementIndex + 4 <= elementsNumber; elementIndex += 4 )
+  {
+    for( size_t laneIndex = 0; laneIndex < 4; laneIndex++ )
+    {
+      uint64_t bitsValue;
+      memcpy( &bitsValue, matrix->data + elementIndex + laneIndex, sizeof(uint64_t) );
+      lanesList[ laneIndex ] = ( lanesList[ laneIndex ] ^ bitsValue ) * PRIME_1;
+      lanesList[ laneIndex ] ^= lanesList[ laneIndex ] >> 29;
+    }
+  }
+  for( ; elementIndex < elementsNumber; elementIndex++ )
+  {
+    uint64_t bitsValue;
+    memcpy( &bitsValue, matrix->data + elementIndex, sizeof(uint64_t) );
+    lanesList[ 0 ] = ( lanesList[ 0 ] ^ bitsValue ) * PRIME_1;
+    lanesList[ 0 ] ^= lanesList[ 0 ] >> 29;
+  }
+
+  uint64_t fingerprint = ( (uint64_t) matrix->rowsNumber << 32 ) ^ (uint64_t) matrix->columnsNumber;
+  for( size_t laneIndex = 0; laneIndex < 4; laneIndex++ )
+  {
+    fingerprint = ( fingerprint ^ lanesList[ laneIndex ] ) * PRIME_2;
+    fingerprint ^= fingerprint >> 32;
+  }
+
+  return fingerprint;
+}
+
+void Mat_SetReproducible( bool enabled )
+{
+  isReproducible = enabled;
+}
+
+void Mat_SetShadowVerification( double sampleRate, double tolerance, MatrixMismatchCallback callback )
+{
+  shadowSampleRate = ( sampleRate > 1.0 ) ? 1.0 : sampleRate;
+  shadowSampleCredit = 0.0;
+  shadowTolerance = tolerance;
+  shadowCallback = callback;
+  shadowChecksNumber = shadowMismatchesNumber = 0;
+}
+
+size_t Mat_GetShadowMismatches( size_t* checksNumber )
+{
+  if( checksNumber != NULL ) *checksNumber = shadowChecksNumber;
+  
+  return shadowMismatchesNumber;
+}
+
+double Mat_SumElements( Matrix matrix )
+{
+  if( matrix == NULL ) return 0.0;
+  
+  return ReduceProducts( matrix->data, NULL, matrix->rowsNumber * matrix->columnsNumber );
+}
+
+double Mat_InnerProduct( Matrix matrix_1, Matrix matrix_2 )
+{
+  if( matrix_1 == NULL || matrix_2 == NULL ) return 0.0;
+  
+  if( matrix_1->rowsNumber != matrix_2->rowsNumber || matrix_1->columnsNumber != matrix_2->columnsNumber ) return 0.0;
+  
+  return ReduceProducts( matrix_1->data, matrix_2->data, matrix_1->rowsNumber * matrix_1->columnsNumber );
+}
+
+double Mat_Norm( Matrix matrix )
+{
+  if( matrix == NULL ) return 0.0;
+  
+  return sqrt( ReduceProducts( matrix->data, matrix->data, matrix->rowsNumber * matrix->columnsNumber ) );
+}
+
+Matrix Mat_Scale( Matrix matrix, double scalar, Matrix result )
+{
+  if( matrix == NULL ) return NULL;
+  
+  size_t elementsNumber = result->rowsNumber * result->columnsNumber;
+  for( size_t elementIndex = 0; elementIndex < elementsNumber; elementIndex++ )
+    result->data[ elementIndex ] = scalar * matrix->data[ elementIndex ];
+
+  result->rowsNumber = matrix->rowsNumber;
+  result->columnsNumber = matrix->columnsNumber;
+  
+  return result;
+}
+
+Matrix Mat_Sum( Matrix matrix_1, double weight_1, Matrix matrix_2, double weight_2, Matrix result )
+{
+  if( matrix_1 == NULL || matrix_2 == NULL ) return NULL;
+
+  if( matrix_1->rowsNumber != matrix_2->rowsNumber || matrix_1->columnsNumber != matrix_2->columnsNumber ) return NULL;
+
+  result->rowsNumber = matrix_1->rowsNumber;
+  result->columnsNumber = matrix_1->columnsNumber;
+  
+  size_t elementsNumber = result->rowsNumber * result->columnsNumber;
+  for( size_t elementIndex = 0; elementIndex < elementsNumber; elementIndex++ )
+    result->data[ elementIndex ] = weight_1 * matrix_1->data[ elementIndex ] + weight_2 * matrix_2->data[ elementIndex ];
+
+  return result;
+}
+
+Matrix Mat_Dot( Matrix matrix_1, char transpose_1, Matrix matrix_2, char transpose_2, Matrix result )
+{
+  double auxArray[ MATRIX_SIZE_MAX ];
+  
+  if( matrix_1 == NULL || matrix_2 == NULL || result == NULL ) return NULL;
+  
+  size_t couplingLength = ( transpose_1 == MATRIX_TRANSPOSE ) ? matrix_1->rowsNumber : matrix_1->columnsNumber;
+   
+  if( couplingLength != ( ( transpose_2 == MATRIX_TRANSPOSE ) ? matrix_2->columnsNumber : matrix_2->rowsNumber ) ) return NULL;
+   
+  size_t rowsNumber = ( transpose_1 == MATRIX_TRANSPOSE ) ? matrix_1->columnsNumber : matrix_1->rowsNumber;
+  size_t columnsNumber = ( transpose_2 == MATRIX_TRANSPOSE ) ? matrix_2->rowsNumber : matrix_2->columnsNumber;
+  
+  size_t stride_1 = ( transpose_1 == MATRIX_TRANSPOSE ) ? couplingLength : rowsNumber;          // Distance between columns
+  size_t stride_2 = ( transpose_2 == MATRIX_TRANSPOSE ) ? columnsNumber : couplingLength;       // Distance between columns
+  
+  MultiplyData( transpose_1, transpose_2, rowsNumber, columnsNumber, couplingLength, matrix_1->data, stride_1, matrix_2->data, stride_2, auxArray );
+  
+  result->rowsNumber = rowsNumber;
+  result->columnsNumber = columnsNumber;
+  
+  memcpy( result->data, auxArray, result->rowsNumber * result->columnsNumber * sizeof(double) );
+
+  return result;
+}
+
+// Copy strictly upper triangle of square column-major array to the lower one
+static void MirrorUpper( double* data, size_t size )
+{
+  for( size_t column = 0; column < size; column++ )
+  {
+    for( size_t row = column + 1; row < size; row++ )
+      data[ column * size + row ] = data[ row * size + column ];
+  }
+}
+
+// Squared distances between columns of 2 arrays, from their products. Only the upper triangle is filled for the same points set
+static bool GetSquaredDistances( Matrix points_1, Matrix points_2, double* distancesData )
+{
+  double squaredNormsList_1[ MATRIX_SIZE_MAX ], squaredNormsList_2[ MATRIX_SIZE_MAX ];
+  
+  if( points_1 == NULL || points_2 == NULL ) return false;
+  
+  size_t dimensionsNumber = points_1->rowsNumber;
+  if( points_2->rowsNumber != dimensionsNumber ) return false;
+  
+  size_t pointsNumber_1 = points_1->columnsNumber, pointsNumber_2 = points_2->columnsNumber;
+  if( pointsNumber_1 * pointsNumber_2 > MATRIX_SIZE_MAX ) return false;
+  
+  bool isSymmetric = ( points_1 == points_2 );
+  
+  // -2 x^T y terms. Symmetric rank-k update computes only the upper triangle for the same points set
+  if( isSymmetric && !isReproducible && dimensionsNumber > 0 )
+  {
+    char upperLower = 'U', transpose = 'T';
+    int n = (int) pointsNumber_1, k = (int) dimensionsNumber, ld = (int) dimensionsNumber;
+    double alpha = -2.0, beta = 0.0;
+    dsyrk_( &upperLower, &transpose, &n, &k, &alpha, points_1->data, &ld, &beta, distancesData, &n );
+  }
+  else
+  {
+    MultiplyData( MATRIX_TRANSPOSE, MATRIX_KEEP, pointsNumber_1, pointsNumber_2, dimensionsNumber, 
+                  points_1->data, dimensionsNumber, points_2->data, dimensionsNumber, distancesData );
+    for( size_t elementIndex = 0; elementIndex < pointsNumber_1 * pointsNumber_2; elementIndex++ )
+      distancesData[ elementIndex ] *= -2.0;
+  }
+  
+  for( size_t point = 0; point < pointsNumber_1; point++ )
+    squaredNormsList_1[ point ] = isSymmetric ? -0.5 * distancesData[ point * pointsNumber_1 + point ] 
+                                              : ReduceProducts( points_1->data + point * dimensionsNumber, points_1->data + point * dimensionsNumber, dimensionsNumber );
+  for( size_t point = 0; point < pointsNumber_2; point++ )
+    squaredNormsList_2[ point ] = isSymmetric ? squaredNormsList_1[ point ] 
+                                              : ReduceProducts( points_2->data + point * dimensionsNumber, points_2->data + point * dimensionsNumber, dimensionsNumber );
+  
+  for( size_t column = 0; column < pointsNumber_2; column++ )
+  {
+    double* distancesColumn = distancesData + column * pointsNumber_1;
+    size_t rowsNumber = isSymmetric ? column : pointsNumber_1;
+    for( size_t row = 0; row < rowsNumber; row++ )
+    {
+      double squaredDistance = squaredNormsList_1[ row ] + squaredNormsList_2[ column ] + distancesColumn[ row ];
+      distancesColumn[ row ] = ( squaredDistance > 0.0 ) ? squaredDistance : 0.0;   // Clip cancellation errors
+    }
+    if( isSymmetric ) distancesColumn[ column ] = 0.0;
+  }
+  
+  return true;
+}
+
+Matrix Mat_PairwiseSqDist( Matrix points_1, Matrix points_2, Matrix result )
+{
+  double auxArray[ MATRIX_SIZE_MAX ];
+  
+  if( points_1 == NULL || points_2 == NULL || result == NULL ) return NULL;
+  
+  if( points_1->columnsNumber * points_2->columnsNumber > result->dataLength ) return NULL;
+  
+  if( !GetSquaredDistances( points_1, points_2, auxArray ) ) return NULL;
+  
+  result->rowsNumber = points_1->columnsNumber;
+  result->columnsNumber = points_2->columnsNumber;
+  
+  if( points_1 == points_2 ) MirrorUpper( auxArray, result->rowsNumber );
+  
+  memcpy( result->data, auxArray, result->rowsNumber * result->columnsNumber * sizeof(double) );
+  
+  return result;
+}
+
+Matrix Mat_Kernel( Matrix points_1, Matrix points_2, char kernelType, double lengthScale, double variance, Matrix result )
+{
+  double auxArray[ MATRIX_SIZE_MAX ];
+  
+  if( points_1 == NULL || points_2 == NULL || result == NULL ) return NULL;
+  
+  if( points_1->columnsNumber * points_2->columnsNumber > result->dataLength ) return NULL;
+  
+  if( lengthScale <= 0.0 ) return NULL;
+  
+  if( kernelType != MATRIX_KERNEL_GAUSSIAN && kernelType != MATRIX_KERNEL_MATERN_3_2 && kernelType != MATRIX_KERNEL_MATERN_5_2 ) return NULL;
+  
+  if( !GetSquaredDistances( points_1, points_2, auxArray ) ) return NULL;
+  
+  bool isSymmetric = ( points_1 == points_2 );
+  size_t rowsNumber = points_1->columnsNumber, columnsNumber = points_2->columnsNumber;
+  
+  // Kernel evaluated directly over squared distances, for the upper triangle only if symmetric
+  double squaredLengthScale = lengthScale * lengthScale;
+  for( size_t column = 0; column < columnsNumber; column++ )
+  {
+    double* kernelColumn = auxArray + column * rowsNumber;
+    size_t columnLength = isSymmetric ? column + 1 : rowsNumber;
+    if( kernelType == MATRIX_KERNEL_GAUSSIAN )
+    {
+      for( size_t row = 0; row < columnLength; row++ )
+        kernelColumn[ row ] = variance * exp( -0.5 * kernelColumn[ row ] / squaredLengthScale );
+    }
+    else if( kernelType == MATRIX_KERNEL_MATERN_3_2 )
+    {
+      for( size_t row = 0; row < columnLength; row++ )
+      {
+        double scaledDistance = sqrt( 3.0 * kernelColumn[ row ] / squaredLengthScale );
+        kernelColumn[ row ] = variance * ( 1.0 + scaledDistance ) * exp( -scaledDistance );
+      }
+    }
+    else
+    {
+      for( size_t row = 0; row < columnLength; row++ )
+      {
+        double scaledDistance = sqrt( 5.0 * kernelColumn[ row ] / squaredLengthScale );
+        kernelColumn[ row ] = variance * ( 1.0 + scaledDistance + scaledDistance * scaledDistance / 3.0 ) * exp( -scaledDistance );
+      }
+    }
+  }
+  
+  if( isSymmetric ) MirrorUpper( auxArray, rowsNumber );
+  
+  result->rowsNumber = rowsNumber;
+  result->columnsNumber = columnsNumber;
+  
+  memcpy( result->data, auxArray, result->rowsNumber * result->columnsNumber * sizeof(double) );
+  
+  return result;
+}
+
+Matrix Mat_SymmetricRankUpdate( Matrix matrix, char transpose, double weight, double resultWeight, Matrix result )
+{
+  double auxArray[ MATRIX_SIZE_MAX ];
+  
+  if( matrix == NULL || result == NULL || matrix == result ) return NULL;
+  
+  bool isTransposed = ( transpose == MATRIX_TRANSPOSE );
+  size_t size = isTransposed ? matrix->columnsNumber : matrix->rowsNumber;
+  size_t couplingLength = isTransposed ? matrix->rowsNumber : matrix->columnsNumber;
+  
+  if( size * size > result->dataLength ) return NULL;
+  
+  if( resultWeight != 0.0 && ( result->rowsNumber != size || result->columnsNumber != size ) ) return NULL;
+  
+  if( isReproducible || couplingLength == 0 || size == 0 )
+  {
+    MultiplyData( isTransposed ? MATRIX_TRANSPOSE : MATRIX_KEEP, isTransposed ? MATRIX_KEEP : MATRIX_TRANSPOSE, size, size, couplingLength, 
+                  matrix->data, matrix->rowsNumber, matrix->data, matrix->rowsNumber, auxArray );
+    for( size_t elementIndex = 0; elementIndex < size * size; elementIndex++ )
+      result->data[ elementIndex ] = weight * auxArray[ elementIndex ] + ( ( resultWeight != 0.0 ) ? resultWeight * result->data[ elementIndex ] : 0.0 );
+  }
+  else
+  {
+    char upperLower = 'U', trans = isTransposed ? 'T' : 'N';
+    int n = (int) size, k = (int) couplingLength, ld = (int) matrix->rowsNumber;
+    // BLAS does not read the output when beta is zero
+    dsyrk_( &upperLower, &trans, &n, &k, &weight, matrix->data, &ld, &resultWeight, result->data, &n );
+    MirrorUpper( result->data, size );
+  }
+  
+  result->rowsNumber = size;
+  result->columnsNumber = size;
+  
+  return result;
+}
+
+// Pick, among local buffers, one not currently holding the base or the accumulated power
+static double* GetFreeBuffer( double* buffersList[ 3 ], double* baseData, double* accumulatorData )
+{
+  for( size_t bufferIndex = 0; bufferIndex < 3; bufferIndex++ )
+  {
+    if( buffersList[ bufferIndex ] != baseData && buffersList[ bufferIndex ] != accumulatorData ) return buffersList[ bufferIndex ];
+  }
+  return NULL;
+}
+
+Matrix Mat_Power( Matrix matrix, size_t exponent, Matrix result )
+{
+  double auxArray_1[ MATRIX_SIZE_MAX ], auxArray_2[ MATRIX_SIZE_MAX ], auxArray_3[ MATRIX_SIZE_MAX ];
+  double* buffersList[ 3 ] = { auxArray_1, auxArray_2, auxArray_3 };
+  
+  if( matrix == NULL || result == NULL ) return NULL;
+  
+  size_t size = matrix->rowsNumber;
+  if( matrix->columnsNumber != size || size * size > result->dataLength ) return NULL;
+  
+  // Binary exponentiation, ping-ponging between local buffers: about 2 log2( exponent ) products
+  double* baseData = matrix->data;
+  double* accumulatorData = NULL;
+  while( exponent > 0 )
+  {
+    if( exponent & 1 )
+    {
+      double* productData = GetFreeBuffer( buffersList, baseData, accumulatorData );
+      if( accumulatorData == NULL ) memcpy( productData, baseData, size * size * sizeof(double) );
+      else MultiplyData( MATRIX_KEEP, MATRIX_KEEP, size, size, size, accumulatorData, size, baseData, size, productData );
+      accumulatorData = productData;
+    }
+    exponent >>= 1;
+    if( exponent > 0 )
+    {
+      double* squareData = GetFreeBuffer( buffersList, baseData, accumulatorData );
+      MultiplyData( MATRIX_KEEP, MATRIX_KEEP, size, size, size, baseData, size, baseData, size, squareData );
+      baseData = squareData;
+    }
+  }
+  
+  if( accumulatorData == NULL )
+  {
+    // Zero exponent: identity
+    memset( result->data, 0, size * size * sizeof(double) );
+    for( size_t line = 0; line < size; line++ )
+      result->data[ line * size + line ] = 1.0;
+  }
+  else memcpy( result->data, accumulatorData, size * size * sizeof(double) );
+  
+  result->rowsNumber = result->columnsNumber = size;
+  
+  return result;
+}
+
+// Accumulate sum of coefficient-weighted powers c[ 0 ] x I + c[ 1 ] x A + ... (powers list starting at A^1)
+static void AddWeightedPowers( double* sumData, size_t size, double* coefficientsList, size_t coefficientsNumber, double** powersList )
+{
+  size_t elementsNumber = size * size;
+  for( size_t elementIndex = 0; elementIndex < elementsNumber; elementIndex++ )
+    sumData[ elementIndex ] = 0.0;
+  for( size_t line = 0; line < size; line++ )
+    sumData[ line * size + line ] = coefficientsList[ 0 ];
+  for( size_t power = 1; power < coefficientsNumber; power++ )
+  {
+    double coefficient = coefficientsList[ power ];
+    const double* powerData = powersList[ power - 1 ];
+    for( size_t elementIndex = 0; elementIndex < elementsNumber; elementIndex++ )
+      sumData[ elementIndex ] += coefficient * powerData[ elementIndex ];
+  }
+}
+
+Matrix Mat_Polynomial( double* coefficientsList, size_t coefficientsNumber, Matrix matrix, Matrix result )
+{
+  double powersSpace[ POLYNOMIAL_POWERS_SPACE * MATRIX_SIZE_MAX ];
+  double sumArray[ MATRIX_SIZE_MAX ], productArray[ MATRIX_SIZE_MAX ];
+  double* powersList[ POLYNOMIAL_STEP_MAX ];
+  
+  if( coefficientsList == NULL || matrix == NULL || result == NULL || coefficientsNumber == 0 ) return NULL;
+  
+  size_t size = matrix->rowsNumber;
+  if( matrix->columnsNumber != size || size * size > result->dataLength || size == 0 ) return NULL;
+  
+  // Paterson-Stockmeyer: p(A) = sum_j B_j x (A^s)^j, with B_j of degree s - 1, evaluated by Horner's rule on A^s,
+  // taking about 2 sqrt( degree ) products. Step s is limited by the space for storing A^2 to A^s
+  size_t step = 1;
+  while( step * step < coefficientsNumber ) step++;
+  size_t storedPowersMax = POLYNOMIAL_POWERS_SPACE * MATRIX_SIZE_MAX / ( size * size );
+  if( step > storedPowersMax + 1 ) step = storedPowersMax + 1;
+  if( step > POLYNOMIAL_STEP_MAX ) step = POLYNOMIAL_STEP_MAX;
+  
+  powersList[ 0 ] = matrix->data;
+  for( size_t power = 2; power <= step; power++ )
+  {
+    powersList[ power - 1 ] = powersSpace + ( power - 2 ) * size * size;
+    MultiplyData( MATRIX_KEEP, MATRIX_KEEP, size, size, size, powersList[ power - 2 ], size, matrix->data, size, powersList[ power - 1 ] );
+  }
+  
+  size_t blocksNumber = ( coefficientsNumber + step - 1 ) / step;
+  size_t lastBlockStart = ( blocksNumber - 1 ) * step;
+  AddWeightedPowers( sumArray, size, coefficientsList + lastBlockStart, coefficientsNumber - lastBlockStart, powersList );
+  for( size_t block = blocksNumber - 1; block-- > 0; )
+  {
+    MultiplyData( MATRIX_KEEP, MATRIX_KEEP, size, size, size, sumArray, size, powersList[ step - 1 ], size, productArray );
+    AddWeightedPowers( sumArray, size, coefficientsList + block * step, step, powersList );
+    for( size_t elementIndex = 0; elementIndex < size * size; elementIndex++ )
+      sumArray[ elementIndex ] += productArray[ elementIndex ];
+  }
+  
+  memcpy( result->data, sumArray, size * size * sizeof(double) );
+  result->rowsNumber = result->columnsNumber = size;
+  
+  return result;
+}
+
+// Geometry of independent lines (columns or rows) along which a matrix is scanned: positions of each line are visited in order.
+// Contiguous lines (columns) are scanned one after another, while strided ones (rows) advance all at once, each step being applied to 
+// all lines (independent operations, for vectorization/pipelining), so that inner loops always run over contiguous elements
+typedef struct _LinesLayout
+{
+  size_t linesNumber, positionsNumber;
+  size_t lineStep, positionStep;
+}
+LinesLayout;
+
+static bool GetLinesLayout( size_t rowsNumber, size_t columnsNumber, char axis, LinesLayout* layout )
+{
+  if( axis == MATRIX_ALONG_COLUMNS ) *layout = (LinesLayout) { columnsNumber, rowsNumber, rowsNumber, 1 };
+  else if( axis == MATRIX_ALONG_ROWS ) *layout = (LinesLayout) { rowsNumber, columnsNumber, 1, rowsNumber };
+  else return false;
+  
+  return true;
+}
+
+Matrix Mat_CumulativeSum( Matrix matrix, char axis, Matrix result )
+{
+  LinesLayout lines;
+  
+  if( matrix == NULL || result == NULL ) return NULL;
+  
+  if( !GetLinesLayout( matrix->rowsNumber, matrix->columnsNumber, axis, &lines ) ) return NULL;
+  
+  if( matrix->rowsNumber * matrix->columnsNumber > result->dataLength ) return NULL;
+  
+  // Each position only depends on its own input and the previous output, so in-place operation is safe
+  const double* inputData = matrix->data;
+  double* outputData = result->data;
+  if( lines.positionStep == 1 )
+  {
+    for( size_t line = 0; line < lines.linesNumber; line++ )
+    {
+      size_t offset = line * lines.lineStep;
+      double sum = 0.0;
+      for( size_t position = 0; position < lines.positionsNumber; position++ )
+      {
+        sum = ( position > 0 ) ? sum + inputData[ offset + position ] : inputData[ offset + position ];
+        outputData[ offset + position ] = sum;
+      }
+    }
+  }
+  else
+  {
+    for( size_t position = 0; position < lines.positionsNumber; position++ )
+    {
+      size_t offset = position * lines.positionStep;
+      for( size_t line = 0; line < lines.linesNumber; line++ )
+      {
+        size_t index = line * lines.lineStep + offset;
+        outputData[ index ] = ( position > 0 ) ? outputData[ index - lines.positionStep ] + inputData[ index ] : inputData[ index ];
+      }
+    }
+  }
+  
+  result->rowsNumber = matrix->rowsNumber;
+  result->columnsNumber = matrix->columnsNumber;
+  
+  return result;
+}
+
+// Integral at given line position, from previous integral values and neighbouring samples (step apart)
+static inline double IntegrateStep( const double* f, const double* integral, size_t index, size_t step, size_t position, size_t positionsNumber, double timeStep, char rule )
+{
+  if( position == 0 ) return 0.0;
+  else if( rule == MATRIX_TRAPEZOIDAL_RULE || positionsNumber == 2 )
+    return integral[ index - step ] + timeStep / 2.0 * ( f[ index - step ] + f[ index ] );
+  else if( position % 2 == 0 )       // Simpson's 1/3 rule over the last 2 intervals
+    return integral[ index - 2 * step ] + timeStep / 3.0 * ( f[ index - 2 * step ] + 4.0 * f[ index - step ] + f[ index ] );
+  else if( position + 1 < positionsNumber )       // Single interval of the parabola through the next sample
+    return integral[ index - step ] + timeStep / 12.0 * ( 5.0 * f[ index - step ] + 8.0 * f[ index ] - f[ index + step ] );
+  // Last single interval, using parabola through the previous sample
+  return integral[ index - step ] + timeStep / 12.0 * ( -f[ index - 2 * step ] + 8.0 * f[ index - step ] + 5.0 * f[ index ] );
+}
+
+Matrix Mat_Integrate( Matrix matrix, double timeStep, char rule, char axis, Matrix result )
+{
+  double auxArray[ MATRIX_SIZE_MAX ];
+  LinesLayout lines;
+  
+  if( matrix == NULL || result == NULL ) return NULL;
+  
+  if( rule != MATRIX_TRAPEZOIDAL_RULE && rule != MATRIX_SIMPSON_RULE ) return NULL;
+  
+  if( !GetLinesLayout( matrix->rowsNumber, matrix->columnsNumber, axis, &lines ) ) return NULL;
+  
+  if( matrix->rowsNumber * matrix->columnsNumber > result->dataLength ) return NULL;
+  
+  const double* f = matrix->data;
+  double* integral = ( result == matrix ) ? auxArray : result->data;
+  size_t step = lines.positionStep;
+  if( step == 1 )
+  {
+    for( size_t line = 0; line < lines.linesNumber; line++ )
+    {
+      size_t offset = line * lines.lineStep;
+      for( size_t position = 0; position < lines.positionsNumber; position++ )
+        integral[ offset + position ] = IntegrateStep( f, integral, offset + position, step, position, lines.positionsNumber, timeStep, rule );
+    }
+  }
+  else
+  {
+    for( size_t position = 0; position < lines.positionsNumber; position++ )
+    {
+      size_t offset = position * step;
+      for( size_t line = 0; line < lines.linesNumber; line++ )
+        integral[ line * lines.lineStep + offset ] = IntegrateStep( f, integral, line * lines.lineStep + offset, step, position, lines.positionsNumber, timeStep, rule );
+    }
+  }
+  
+  if( integral == auxArray ) memcpy( result->data, auxArray, matrix->rowsNumber * matrix->columnsNumber * sizeof(double) );
+  
+  result->rowsNumber = matrix->rowsNumber;
+  result->columnsNumber = matrix->columnsNumber;
+  
+  return result;
+}
+
+Matrix Mat_Difference( Matrix matrix, char axis, Matrix result )
+{
+  double auxArray[ MATRIX_SIZE_MAX ];
+  LinesLayout inputLines, outputLines;
+  
+  if( matrix == NULL || result == NULL ) return NULL;
+  
+  if( !GetLinesLayout( matrix->rowsNumber, matrix->columnsNumber, axis, &inputLines ) ) return NULL;
+  
+  if( inputLines.positionsNumber == 0 ) return NULL;
+  
+  size_t rowsNumber = ( axis == MATRIX_ALONG_COLUMNS ) ? matrix->rowsNumber - 1 : matrix->rowsNumber;
+  size_t columnsNumber = ( axis == MATRIX_ALONG_ROWS ) ? matrix->columnsNumber - 1 : matrix->columnsNumber;
+  GetLinesLayout( rowsNumber, columnsNumber, axis, &outputLines );
+  
+  if( rowsNumber * columnsNumber > result->dataLength ) return NULL;
+  
+  // Output layout differs from the input one, so in-place operation needs an intermediate buffer
+  double* differences = ( result == matrix ) ? auxArray : result->data;
+  if( inputLines.positionStep == 1 )
+  {
+    for( size_t line = 0; line < outputLines.linesNumber; line++ )
+    {
+      const double* inputLine = matrix->data + line * inputLines.lineStep;
+      double* outputLine = differences + line * outputLines.lineStep;
+      for( size_t position = 0; position < outputLines.positionsNumber; position++ )
+        outputLine[ position ] = inputLine[ position + 1 ] - inputLine[ position ];
+    }
+  }
+  else
+  {
+    for( size_t position = 0; position < outputLines.positionsNumber; position++ )
+    {
+      for( size_t line = 0; line < outputLines.linesNumber; line++ )
+      {
+        size_t inputIndex = line * inputLines.lineStep + position * inputLines.positionStep;
+        differences[ line * outputLines.lineStep + position * outputLines.positionStep ] = matrix->data[ inputIndex + inputLines.positionStep ] - matrix->data[ inputIndex ];
+      }
+    }
+  }
+  
+  if( differences == auxArray ) memcpy( result->data, auxArray, rowsNumber * columnsNumber * sizeof(double) );
+  
+  result->rowsNumber = rowsNumber;
+  result->columnsNumber = columnsNumber;
+  
+  return result;
+}
+
+double Mat_Determinant( Matrix matrix )
+{
+  double auxArray[ MATRIX_SIZE_MAX ];
+  int pivotArray[ MATRIX_SIZE_MAX ];
+  int info;
+  
+  if( matrix == NULL ) return 0.0;
+
+  if( matrix->rowsNumber != matrix->columnsNumber ) return 0.0;
+  
+  memcpy( auxArray, matrix->data, matrix->rowsNumber * matrix->columnsNumber * sizeof(double) );
+  
+  dgetrf_( (int*) &(matrix->rowsNumber), (int*) &(matrix->columnsNumber), auxArray, (int*) &(matrix->rowsNumber), pivotArray, &info );
   
   double determinant = 1.0;
   for( size_t pivotIndex = 0; pivotIndex < matrix->rowsNumber; pivotIndex++ )
   {
-    determinant *= auxArray[ pivotIndex * matrix->rowsNumber + pivotIndex ];
-    if( pivotArray[ pivotIndex ] != pivotIndex ) determinant *= -1.0;
+    determinant *= auxArray[ pivotIndex * matrix->rowsNumber + pivotIndex ];
+    // LAPACK pivot indexes are 1-based
+    if( pivotArray[ pivotIndex ] != (int) pivotIndex + 1 ) determinant *= -1.0;
+  }
+
+  return determinant;
+}
+
+Matrix Mat_Transpose( Matrix matrix, Matrix result )
+{
+  double auxArray[ MATRIX_SIZE_MAX ] = { 0 };
+  
+  if( matrix == NULL ) return NULL;
+
+  result->rowsNumber = matrix->columnsNumber;
+  result->columnsNumber = matrix->rowsNumber;
+
+  for( size_t row = 0; row < result->rowsNumber; row++ )
+  {
+    for( size_t column = 0; column < result->columnsNumber; column++ )
+      auxArray[ column * result->rowsNumber + row ] = matrix->data[ row * matrix->rowsNumber + column ];
+  }
+
+  memcpy( result->data, auxArray, result->rowsNumber * result->columnsNumber * sizeof(double) );
+
+  return result;
+}
+
+Matrix Mat_Inverse( Matrix matrix, Matrix result )
+{
+  double auxArray[ MATRIX_SIZE_MAX ] = { 0 };
+  int pivotArray[ MATRIX_SIZE_MAX ];
+  int info;
+  
+  if( matrix == NULL || result == NULL ) return NULL;
+
+  if( matrix->rowsNumber != matrix->columnsNumber ) return NULL;
+
+  if( matrix != result )
+  {
+    result->rowsNumber = matrix->rowsNumber;
+    result->columnsNumber = matrix->columnsNumber;
+  
+    memcpy( result->data, matrix->data, matrix->rowsNumber * matrix->columnsNumber * sizeof(double) );
+  }
+  
+  dgetrf_( (int*) &(result->rowsNumber), (int*) &(result->columnsNumber), result->data, (int*) &(result->rowsNumber), pivotArray, &info );
+  
+  if( info != 0 ) return NULL;
+  
+  int workLength = result->rowsNumber * result->columnsNumber;
+  dgetri_( (int*) &(result->rowsNumber), result->data, (int*) &(result->rowsNumber), pivotArray, auxArray, &workLength, &info );
+  
+  if( info != 0 ) return NULL;
+
+  return result;
+}
+
+// Element (row, column) of op(T), read in place through row and column steps
+#define TRIANGULAR_ELEMENT( row, column ) triangularData[ (row) * rowStep + (column) * columnStep ]
+// Optimizers won't always fully unroll nested loops by themselves, even with constant bounds
+#if ( defined( __GNUC__ ) && __GNUC__ >= 8 ) || defined( __clang__ )
+#define UNROLL_TRIANGULAR _Pragma( "GCC unroll 8" )
+#else
+#define UNROLL_TRIANGULAR
+#endif
+
+// Triangular kernels are instantiated for each order up to TRIANGULAR_NATIVE_SIZE_MAX, so that their loops have constant bounds 
+// and get fully unrolled, with the column being processed kept in registers
+static inline void SolveTriangularKernel( const size_t size, const double* triangularData, size_t rowStep, size_t columnStep, 
+                                          bool isLower, bool isUnitDiagonal, double* data, size_t columnsNumber )
+{
+  for( size_t column = 0; column < columnsNumber; column++ )
+  {
+    double* columnData = data + column * size;
+    double valuesList[ TRIANGULAR_NATIVE_SIZE_MAX ];
+    UNROLL_TRIANGULAR
+    for( size_t row = 0; row < size; row++ )
+      valuesList[ row ] = columnData[ row ];
+    if( isLower )
+    {
+      UNROLL_TRIANGULAR
+      for( size_t row = 0; row < size; row++ )
+      {
+        UNROLL_TRIANGULAR
+        for( size_t index = 0; index < row; index++ )
+          valuesList[ row ] -= TRIANGULAR_ELEMENT( row, index ) * valuesList[ index ];
+        if( !isUnitDiagonal ) valuesList[ row ] /= TRIANGULAR_ELEMENT( row, row );
+      }
+    }
+    else
+    {
+      UNROLL_TRIANGULAR
+      for( size_t row = size; row-- > 0; )
+      {
+        UNROLL_TRIANGULAR
+        for( size_t index = row + 1; index < size; index++ )
+          valuesList[ row ] -= TRIANGULAR_ELEMENT( row, index ) * valuesList[ index ];
+        if( !isUnitDiagonal ) valuesList[ row ] /= TRIANGULAR_ELEMENT( row, row );
+      }
+    }
+    UNROLL_TRIANGULAR
+    for( size_t row = 0; row < size; row++ )
+      columnData[ row ] = valuesList[ row ];
+  }
+}
+
+static inline void MultiplyTriangularKernel( const size_t size, const double* triangularData, size_t rowStep, size_t columnStep, 
+                                             bool isLower, bool isUnitDiagonal, double* data, size_t columnsNumber )
+{
+  for( size_t column = 0; column < columnsNumber; column++ )
+  {
+    double* columnData = data + column * size;
+    double valuesList[ TRIANGULAR_NATIVE_SIZE_MAX ];
+    if( isLower )
+    {
+      UNROLL_TRIANGULAR
+      for( size_t row = 0; row < size; row++ )
+      {
+        double sum = 0.0;
+        UNROLL_TRIANGULAR
+        for( size_t index = 0; index < row; index++ )
+          sum += TRIANGULAR_ELEMENT( row, index ) * columnData[ index ];
+        valuesList[ row ] = sum + ( isUnitDiagonal ? columnData[ row ] : TRIANGULAR_ELEMENT( row, row ) * columnData[ row ] );
+      }
+    }
+    else
+    {
+      UNROLL_TRIANGULAR
+      for( size_t row = 0; row < size; row++ )
+      {
+        double sum = isUnitDiagonal ? columnData[ row ] : TRIANGULAR_ELEMENT( row, row ) * columnData[ row ];
+        UNROLL_TRIANGULAR
+        for( size_t index = row + 1; index < size; index++ )
+          sum += TRIANGULAR_ELEMENT( row, index ) * columnData[ index ];
+        valuesList[ row ] = sum;
+      }
+    }
+    UNROLL_TRIANGULAR
+    for( size_t row = 0; row < size; row++ )
+      columnData[ row ] = valuesList[ row ];
+  }
+}
+
+#define TRIANGULAR_NATIVE_KERNELS( SIZE ) \
+  static void SolveTriangular##SIZE( const double* triangularData, size_t rowStep, size_t columnStep, bool isLower, bool isUnitDiagonal, double* data, size_t columnsNumber ) \
+  { SolveTriangularKernel( SIZE, triangularData, rowStep, columnStep, isLower, isUnitDiagonal, data, columnsNumber ); } \
+  static void MultiplyTriangular##SIZE( const double* triangularData, size_t rowStep, size_t columnStep, bool isLower, bool isUnitDiagonal, double* data, size_t columnsNumber ) \
+  { MultiplyTriangularKernel( SIZE, triangularData, rowStep, columnStep, isLower, isUnitDiagonal, data, columnsNumber ); }
+
+TRIANGULAR_NATIVE_KERNELS( 1 )
+TRIANGULAR_NATIVE_KERNELS( 2 )
+TRIANGULAR_NATIVE_KERNELS( 3 )
+TRIANGULAR_NATIVE_KERNELS( 4 )
+TRIANGULAR_NATIVE_KERNELS( 5 )
+TRIANGULAR_NATIVE_KERNELS( 6 )
+TRIANGULAR_NATIVE_KERNELS( 7 )
+TRIANGULAR_NATIVE_KERNELS( 8 )
+
+typedef void (*TriangularKernel)( const double*, size_t, size_t, bool, bool, double*, size_t );
+
+// Kernels indexed by order
+static const TriangularKernel SOLVE_TRIANGULAR_KERNELS[ TRIANGULAR_NATIVE_SIZE_MAX + 1 ] = { NULL, SolveTriangular1, SolveTriangular2, SolveTriangular3, SolveTriangular4, 
+                                                                                              SolveTriangular5, SolveTriangular6, SolveTriangular7, SolveTriangular8 };
+static const TriangularKernel MULTIPLY_TRIANGULAR_KERNELS[ TRIANGULAR_NATIVE_SIZE_MAX + 1 ] = { NULL, MultiplyTriangular1, MultiplyTriangular2, MultiplyTriangular3, MultiplyTriangular4, 
+                                                                                                 MultiplyTriangular5, MultiplyTriangular6, MultiplyTriangular7, MultiplyTriangular8 };
+
+static void ApplyTriangularNative( bool isSolve, Matrix triangular, char upperLower, char transpose, char diagonal, Matrix matrix )
+{
+  size_t size = triangular->rowsNumber;
+  bool isTransposed = ( transpose == MATRIX_TRANSPOSE );
+  // Effective triangle after transposition
+  bool isLower = ( ( upperLower == MATRIX_LOWER ) != isTransposed );
+  size_t rowStep = isTransposed ? size : 1;
+  size_t columnStep = isTransposed ? 1 : size;
+  TriangularKernel kernel = isSolve ? SOLVE_TRIANGULAR_KERNELS[ size ] : MULTIPLY_TRIANGULAR_KERNELS[ size ];
+  kernel( triangular->data, rowStep, columnStep, isLower, ( diagonal == MATRIX_UNIT_DIAGONAL ), matrix->data, matrix->columnsNumber );
+}
+
+static void ApplyTriangularReference( bool isSolve, Matrix triangular, char upperLower, char transpose, char diagonal, double* data, size_t columnsNumber )
+{
+  char side = 'L';
+  char uplo = ( upperLower == MATRIX_LOWER ) ? 'L' : 'U';
+  char trans = ( transpose == MATRIX_TRANSPOSE ) ? 'T' : 'N';
+  char diag = ( diagonal == MATRIX_UNIT_DIAGONAL ) ? 'U' : 'N';
+  int size = (int) triangular->rowsNumber, width = (int) columnsNumber;
+  double alpha = 1.0;
+  
+  if( isSolve ) dtrsm_( &side, &uplo, &trans, &diag, &size, &width, &alpha, triangular->data, &size, data, &size );
+  else dtrmm_( &side, &uplo, &trans, &diag, &size, &width, &alpha, triangular->data, &size, data, &size );
+}
+
+static Matrix ApplyTriangular( bool isSolve, Matrix triangular, char upperLower, char transpose, char diagonal, Matrix matrix )
+{
+  double referenceArray[ MATRIX_SIZE_MAX ];
+  
+  if( triangular == NULL || matrix == NULL || triangular == matrix ) return NULL;
+  
+  if( triangular->rowsNumber != triangular->columnsNumber || triangular->rowsNumber != matrix->rowsNumber ) return NULL;
+  
+  size_t elementsNumber = matrix->rowsNumber * matrix->columnsNumber;
+  if( elementsNumber == 0 ) return matrix;
+  
+  if( triangular->rowsNumber > TRIANGULAR_NATIVE_SIZE_MAX )
+  {
+    ApplyTriangularReference( isSolve, triangular, upperLower, transpose, diagonal, matrix->data, matrix->columnsNumber );
+    return matrix;
+  }
+  
+  bool isVerified = ShouldVerifyShadow();
+  if( isVerified ) memcpy( referenceArray, matrix->data, elementsNumber * sizeof(double) );
+  
+  ApplyTriangularNative( isSolve, triangular, upperLower, transpose, diagonal, matrix );
+  
+  if( isVerified )
+  {
+    MatrixData inputsList[ 2 ] = { *triangular, WrapData( referenceArray, matrix->rowsNumber, matrix->columnsNumber ) };
+    // Reference result overwrites the input copy, so report inputs before running it
+    double inputArray[ MATRIX_SIZE_MAX ];
+    memcpy( inputArray, referenceArray, elementsNumber * sizeof(double) );
+    inputsList[ 1 ].data = inputArray;
+    ApplyTriangularReference( isSolve, triangular, upperLower, transpose, diagonal, referenceArray, matrix->columnsNumber );
+    char operationName[ 32 ];
+    snprintf( operationName, sizeof(operationName), "%s(%c,%c,%c)", isSolve ? "TriangularSolve" : "TriangularMultiply", 
+              ( upperLower == MATRIX_LOWER ) ? 'L' : 'U', ( transpose == MATRIX_TRANSPOSE ) ? 'T' : 'N', ( diagonal == MATRIX_UNIT_DIAGONAL ) ? 'U' : 'N' );
+    VerifyShadow( operationName, inputsList, 2, matrix->data, referenceArray, matrix->rowsNumber, matrix->columnsNumber );
+  }
+  
+  return matrix;
+}
+
+Matrix Mat_TriangularSolve( Matrix triangular, char upperLower, char transpose, char diagonal, Matrix matrix )
+{
+  return ApplyTriangular( true, triangular, upperLower, transpose, diagonal, matrix );
+}
+
+Matrix Mat_TriangularMultiply( Matrix triangular, char upperLower, char transpose, char diagonal, Matrix matrix )
+{
+  return ApplyTriangular( false, triangular, upperLower, transpose, diagonal, matrix );
+}
+
+Permutation Mat_CreatePermutation( size_t size )
+{
+  if( size > MATRIX_SIZE_MAX ) return NULL;
+  
+  Permutation newPermutation = (Permutation) malloc( sizeof(PermutationData) );
+  if( newPermutation == NULL ) return NULL;
+  
+  newPermutation->indexesList = (size_t*) malloc( size * sizeof(size_t) );
+  if( newPermutation->indexesList == NULL && size > 0 )
+  {
+    free( newPermutation );
+    return NULL;
+  }
+  
+  newPermutation->size = size;
+  for( size_t position = 0; position < size; position++ )
+    newPermutation->indexesList[ position ] = position;
+  
+  return newPermutation;
+}
+
+void Mat_DiscardPermutation( Permutation permutation )
+{
+  if( permutation == NULL ) return;
+  
+  free( permutation->indexesList );
+  
+  free( permutation );
+}
+
+size_t Mat_GetPermutationSize( Permutation permutation )
+{
+  if( permutation == NULL ) return 0;
+  
+  return permutation->size;
+}
+
+size_t* Mat_GetPermutation( Permutation permutation, size_t* buffer )
+{
+  if( permutation == NULL || buffer == NULL ) return NULL;
+  
+  memcpy( buffer, permutation->indexesList, permutation->size * sizeof(size_t) );
+  
+  return buffer;
+}
+
+Permutation Mat_SetPermutation( Permutation permutation, size_t* indexesList )
+{
+  bool usedList[ MATRIX_SIZE_MAX ] = { false };
+  
+  if( permutation == NULL || indexesList == NULL ) return NULL;
+  
+  // Reject lists that are not a valid reordering (out of range or repeated indexes)
+  for( size_t position = 0; position < permutation->size; position++ )
+  {
+    if( indexesList[ position ] >= permutation->size ) return NULL;
+    if( usedList[ indexesList[ position ] ] ) return NULL;
+    usedList[ indexesList[ position ] ] = true;
+  }
+  
+  memcpy( permutation->indexesList, indexesList, permutation->size * sizeof(size_t) );
+  
+  return permutation;
+}
+
+Permutation Mat_ComposePermutations( Permutation first, Permutation second, Permutation result )
+{
+  size_t auxList[ MATRIX_SIZE_MAX ];
+  
+  if( first == NULL || second == NULL || result == NULL ) return NULL;
+  
+  if( first->size != second->size || first->size != result->size ) return NULL;
+  
+  for( size_t position = 0; position < result->size; position++ )
+    auxList[ position ] = first->indexesList[ second->indexesList[ position ] ];
+  
+  memcpy( result->indexesList, auxList, result->size * sizeof(size_t) );
+  
+  return result;
+}
+
+Permutation Mat_InvertPermutation( Permutation permutation, Permutation result )
+{
+  size_t auxList[ MATRIX_SIZE_MAX ];
+  
+  if( permutation == NULL || result == NULL ) return NULL;
+  
+  if( permutation->size != result->size ) return NULL;
+  
+  for( size_t position = 0; position < result->size; position++ )
+    auxList[ permutation->indexesList[ position ] ] = position;
+  
+  memcpy( result->indexesList, auxList, result->size * sizeof(size_t) );
+  
+  return result;
+}
+
+Matrix Mat_PermuteRows( Matrix matrix, Permutation permutation, Matrix result )
+{
+  double auxArray[ MATRIX_SIZE_MAX ];
+  
+  if( matrix == NULL || permutation == NULL || result == NULL ) return NULL;
+  
+  if( permutation->size != matrix->rowsNumber ) return NULL;
+  
+  if( matrix->rowsNumber * matrix->columnsNumber > result->dataLength ) return NULL;
+  
+  double* permutedData = ( result == matrix ) ? auxArray : result->data;
+  for( size_t column = 0; column < matrix->columnsNumber; column++ )
+  {
+    const double* columnData = matrix->data + column * matrix->rowsNumber;
+    double* permutedColumn = permutedData + column * matrix->rowsNumber;
+    for( size_t row = 0; row < matrix->rowsNumber; row++ )
+      permutedColumn[ row ] = columnData[ permutation->indexesList[ row ] ];
+  }
+  
+  if( permutedData == auxArray ) memcpy( result->data, auxArray, matrix->rowsNumber * matrix->columnsNumber * sizeof(double) );
+  
+  result->rowsNumber = matrix->rowsNumber;
+  result->columnsNumber = matrix->columnsNumber;
+  
+  return result;
+}
+
+Matrix Mat_PermuteColumns( Matrix matrix, Permutation permutation, Matrix result )
+{
+  double auxArray[ MATRIX_SIZE_MAX ];
+  
+  if( matrix == NULL || permutation == NULL || result == NULL ) return NULL;
+  
+  if( permutation->size != matrix->columnsNumber ) return NULL;
+  
+  if( matrix->rowsNumber * matrix->columnsNumber > result->dataLength ) return NULL;
+  
+  // Whole contiguous columns are moved at once
+  double* permutedData = ( result == matrix ) ? auxArray : result->data;
+  for( size_t column = 0; column < matrix->columnsNumber; column++ )
+    memcpy( permutedData + column * matrix->rowsNumber, matrix->data + permutation->indexesList[ column ] * matrix->rowsNumber, matrix->rowsNumber * sizeof(double) );
+  
+  if( permutedData == auxArray ) memcpy( result->data, auxArray, matrix->rowsNumber * matrix->columnsNumber * sizeof(double) );
+  
+  result->rowsNumber = matrix->rowsNumber;
+  result->columnsNumber = matrix->columnsNumber;
+  
+  return result;
+}
+
+// Convert sequence of (1-based) LAPACK row interchanges into the equivalent reordering
+static void PivotsToPermutation( int* pivotArray, size_t pivotsNumber, Permutation permutation )
+{
+  for( size_t position = 0; position < permutation->size; position++ )
+    permutation->indexesList[ position ] = position;
+  
+  for( size_t pivotIndex = 0; pivotIndex < pivotsNumber; pivotIndex++ )
+  {
+    size_t swapIndex = (size_t) pivotArray[ pivotIndex ] - 1;
+    size_t swapValue = permutation->indexesList[ pivotIndex ];
+    permutation->indexesList[ pivotIndex ] = permutation->indexesList[ swapIndex ];
+    permutation->indexesList[ swapIndex ] = swapValue;
+  }
+}
+
+Matrix Mat_DecomposeLU( Matrix matrix, Permutation permutation, Matrix result )
+{
+  int pivotArray[ MATRIX_SIZE_MAX ];
+  int info;
+  
+  if( matrix == NULL || result == NULL ) return NULL;
+  
+  if( permutation != NULL && permutation->size != matrix->rowsNumber ) return NULL;
+  
+  if( matrix->rowsNumber * matrix->columnsNumber > result->dataLength ) return NULL;
+  
+  if( matrix != result )
+  {
+    result->rowsNumber = matrix->rowsNumber;
+    result->columnsNumber = matrix->columnsNumber;
+  
+    memcpy( result->data, matrix->data, matrix->rowsNumber * matrix->columnsNumber * sizeof(double) );
+  }
+  
+  int rowsNumber = (int) result->rowsNumber;
+  int columnsNumber = (int) result->columnsNumber;
+  int leadingDimension = ( rowsNumber > 0 ) ? rowsNumber : 1;
+  dgetrf_( &rowsNumber, &columnsNumber, result->data, &leadingDimension, pivotArray, &info );
+  
+  if( info < 0 ) return NULL;
+  
+  if( permutation != NULL ) 
+    PivotsToPermutation( pivotArray, ( rowsNumber < columnsNumber ) ? rowsNumber : columnsNumber, permutation );
+  
+  return result;
+}
+
+Matrix Mat_DecomposeCholesky( Matrix matrix, Matrix result )
+{
+  int info;
+  
+  if( matrix == NULL || result == NULL ) return NULL;
+  
+  if( matrix->rowsNumber != matrix->columnsNumber ) return NULL;
+  
+  if( matrix->rowsNumber * matrix->columnsNumber > result->dataLength ) return NULL;
+  
+  if( matrix != result )
+  {
+    result->rowsNumber = matrix->rowsNumber;
+    result->columnsNumber = matrix->columnsNumber;
+  
+    memcpy( result->data, matrix->data, matrix->rowsNumber * matrix->columnsNumber * sizeof(double) );
+  }
+  
+  char uplo = 'L';
+  int size = (int) result->rowsNumber;
+  int leadingDimension = ( size > 0 ) ? size : 1;
+  dpotrf_( &uplo, &size, result->data, &leadingDimension, &info );
+  
+  if( info != 0 ) return NULL;
+  
+  // Strict upper triangle is not referenced by LAPACK and keeps the input values
+  for( size_t column = 1; column < result->columnsNumber; column++ )
+    memset( result->data + column * result->rowsNumber, 0, column * sizeof(double) );
+  
+  return result;
+}
+
+Matrix Mat_UpdateCholesky( Matrix factor, Matrix vector )
+{
+  double auxArray[ MATRIX_SIZE_MAX ];
+  
+  if( factor == NULL || vector == NULL ) return NULL;
+  
+  size_t size = factor->rowsNumber;
+  if( factor->columnsNumber != size || vector->rowsNumber * vector->columnsNumber != size ) return NULL;
+  
+  memcpy( auxArray, vector->data, size * sizeof(double) );
+  
+  // Sequence of rotations zeroing the appended vector against each factor column (LINPACK dchud-like)
+  for( size_t column = 0; column < size; column++ )
+  {
+    double* factorColumn = factor->data + column * size;
+    double diagonal = factorColumn[ column ];
+    double newDiagonal = hypot( diagonal, auxArray[ column ] );
+    if( newDiagonal == 0.0 ) continue;
+    double cosine = diagonal / newDiagonal, sine = auxArray[ column ] / newDiagonal;
+    factorColumn[ column ] = newDiagonal;
+    for( size_t row = column + 1; row < size; row++ )
+    {
+      double factorElement = factorColumn[ row ];
+      factorColumn[ row ] = cosine * factorElement + sine * auxArray[ row ];
+      auxArray[ row ] = cosine * auxArray[ row ] - sine * factorElement;
+    }
+  }
+  
+  return factor;
+}
+
+static size_t FindMaxAbsolute( const double* data, size_t length, size_t stride )
+{
+  size_t maxIndex = 0;
+  for( size_t index = 1; index < length; index++ )
+  {
+    if( fabs( data[ index * stride ] ) > fabs( data[ maxIndex * stride ] ) ) maxIndex = index;
   }
+  return maxIndex;
+}
 
-  return determinant;
+static double GetColumnNorm( const double* data, size_t length )
+{
+  double sum = 0.0;
+  for( size_t index = 0; index < length; index++ )
+    sum += data[ index ] * data[ index ];
+  return sqrt( sum );
 }
 
-Matrix Mat_Transpose( Matrix matrix, Matrix result )
+// In-tree unblocked Householder QR with column pivoting (same steps as LAPACK dlaqp2), optionally stopping
+// as soon as all remaining column norms fall below tolerance. Returns number of completed steps
+static size_t DecomposeQRPivotedNative( double* data, size_t rowsNumber, size_t columnsNumber, size_t* pivotsList, double tolerance, bool stopEarly )
 {
-  double auxArray[ MATRIX_SIZE_MAX ] = { 0 };
+  double partialNormsList[ MATRIX_SIZE_MAX ], fullNormsList[ MATRIX_SIZE_MAX ];
+  const double NORM_RECOMPUTE_THRESHOLD = sqrt( DBL_EPSILON );
+  #define A( row, column ) data[ (column) * rowsNumber + (row) ]
   
-  if( matrix == NULL ) return NULL;
+  for( size_t column = 0; column < columnsNumber; column++ )
+  {
+    partialNormsList[ column ] = fullNormsList[ column ] = GetColumnNorm( &A( 0, column ), rowsNumber );
+    pivotsList[ column ] = column;
+  }
+  
+  size_t stepsNumber = ( rowsNumber < columnsNumber ) ? rowsNumber : columnsNumber;
+  double firstDiagonal = 0.0;
+  for( size_t step = 0; step < stepsNumber; step++ )
+  {
+    size_t pivotColumn = step + FindMaxAbsolute( partialNormsList + step, columnsNumber - step, 1 );
+    if( stopEarly && step > 0 && partialNormsList[ pivotColumn ] <= tolerance * firstDiagonal ) return step;
+    
+    if( pivotColumn != step )
+    {
+      for( size_t row = 0; row < rowsNumber; row++ )
+      {
+        double swapValue = A( row, step ); A( row, step ) = A( row, pivotColumn ); A( row, pivotColumn ) = swapValue;
+      }
+      size_t swapIndex = pivotsList[ step ]; pivotsList[ step ] = pivotsList[ pivotColumn ]; pivotsList[ pivotColumn ] = swapIndex;
+      partialNormsList[ pivotColumn ] = partialNormsList[ step ];
+      fullNormsList[ pivotColumn ] = fullNormsList[ step ];
+    }
+    
+    // Householder reflector H = I - tau * v * v^T (v[ 0 ] = 1) annihilating the column below the diagonal
+    double alpha = A( step, step );
+    double* reflectorData = &A( step + 1, step );
+    size_t reflectorLength = rowsNumber - step - 1;
+    double tailNorm = GetColumnNorm( reflectorData, reflectorLength );
+    double tau = 0.0;
+    if( tailNorm > 0.0 )
+    {
+      double beta = -copysign( hypot( alpha, tailNorm ), alpha );
+      tau = ( beta - alpha ) / beta;
+      double scale = 1.0 / ( alpha - beta );
+      for( size_t index = 0; index < reflectorLength; index++ )
+        reflectorData[ index ] *= scale;
+      A( step, step ) = beta;
+    }
+    if( step == 0 ) firstDiagonal = fabs( A( 0, 0 ) );
+    
+    for( size_t column = step + 1; column < columnsNumber; column++ )
+    {
+      if( tau != 0.0 )
+      {
+        double* columnData = &A( step, column );
+        double projection = columnData[ 0 ];
+        for( size_t index = 0; index < reflectorLength; index++ )
+          projection += reflectorData[ index ] * columnData[ index + 1 ];
+        projection *= tau;
+        columnData[ 0 ] -= projection;
+        for( size_t index = 0; index < reflectorLength; index++ )
+          columnData[ index + 1 ] -= projection * reflectorData[ index ];
+      }
+      // Downdate remaining column norms, recomputing them when cancellation makes the estimate unreliable
+      if( partialNormsList[ column ] != 0.0 )
+      {
+        double ratio = fabs( A( step, column ) ) / partialNormsList[ column ];
+        double factor = 1.0 - ratio * ratio;
+        if( factor < 0.0 ) factor = 0.0;
+        double estimateRatio = partialNormsList[ column ] / fullNormsList[ column ];
+        if( factor * estimateRatio * estimateRatio <= NORM_RECOMPUTE_THRESHOLD )
+          partialNormsList[ column ] = fullNormsList[ column ] = GetColumnNorm( &A( step + 1, column ), reflectorLength );
+        else 
+          partialNormsList[ column ] *= sqrt( factor );
+      }
+    }
+  }
+  
+  #undef A
+  return stepsNumber;
+}
 
-  result->rowsNumber = matrix->columnsNumber;
-  result->columnsNumber = matrix->rowsNumber;
+static void DecomposeQRPivotedReference( double* data, size_t rowsNumber, size_t columnsNumber, size_t* pivotsList )
+{
+  int pivotArray[ MATRIX_SIZE_MAX ];
+  double tauArray[ MATRIX_SIZE_MAX ];
+  double workArray[ 3 * MATRIX_SIZE_MAX + 1 ];
+  int m = (int) rowsNumber, n = (int) columnsNumber, workLength = 3 * n + 1, info;
+  
+  // All columns free for pivoting
+  memset( pivotArray, 0, columnsNumber * sizeof(int) );
+  dgeqp3_( &m, &n, data, &m, pivotArray, tauArray, workArray, &workLength, &info );
+  
+  for( size_t column = 0; column < columnsNumber; column++ )
+    pivotsList[ column ] = (size_t) pivotArray[ column ] - 1;
+}
 
-  for( size_t row = 0; row < result->rowsNumber; row++ )
+// Pivoting among numerically null columns is arbitrary, so only the leading (full rank) rows of R are compared, with columns restored to original order
+static void VerifyQRPivoted( Matrix matrix, const double* fastData, size_t* fastPivotsList, const double* referenceData, size_t* referencePivotsList, double tolerance )
+{
+  double fastArray[ MATRIX_SIZE_MAX ], referenceArray[ MATRIX_SIZE_MAX ];
+  
+  size_t rowsNumber = matrix->rowsNumber, columnsNumber = matrix->columnsNumber;
+  size_t stepsNumber = ( rowsNumber < columnsNumber ) ? rowsNumber : columnsNumber;
+  size_t rank = 0;
+  while( rank < stepsNumber && fabs( fastData[ rank * rowsNumber + rank ] ) > tolerance * fabs( fastData[ 0 ] ) ) rank++;
+  if( rank == 0 ) return;
+  
+  for( size_t column = 0; column < columnsNumber; column++ )
   {
-    for( size_t column = 0; column < result->columnsNumber; column++ )
-      auxArray[ column * result->rowsNumber + row ] = matrix->data[ row * matrix->rowsNumber + column ];
+    for( size_t row = 0; row < rank; row++ )
+    {
+      fastArray[ fastPivotsList[ column ] * rank + row ] = ( row <= column ) ? fastData[ column * rowsNumber + row ] : 0.0;
+      referenceArray[ referencePivotsList[ column ] * rank + row ] = ( row <= column ) ? referenceData[ column * rowsNumber + row ] : 0.0;
+    }
   }
+  
+  MatrixData inputsList[ 1 ] = { *matrix };
+  VerifyShadow( "QRPivoted", inputsList, 1, fastArray, referenceArray, rank, columnsNumber );
+}
 
-  memcpy( result->data, auxArray, result->rowsNumber * result->columnsNumber * sizeof(double) );
+size_t Mat_DecomposeQRPivoted( Matrix matrix, double tolerance, bool stopEarly, Permutation permutation, Matrix result )
+{
+  double auxArray[ MATRIX_SIZE_MAX ];
+  double referenceArray[ MATRIX_SIZE_MAX ];
+  size_t pivotsList[ MATRIX_SIZE_MAX ], referencePivotsList[ MATRIX_SIZE_MAX ];
+  
+  if( matrix == NULL || result == NULL ) return 0;
+  
+  size_t rowsNumber = matrix->rowsNumber, columnsNumber = matrix->columnsNumber;
+  size_t stepsNumber = ( rowsNumber < columnsNumber ) ? rowsNumber : columnsNumber;
+  
+  if( permutation != NULL && permutation->size != columnsNumber ) return 0;
+  
+  if( stepsNumber * columnsNumber > result->dataLength || stepsNumber == 0 ) return 0;
+  
+  if( tolerance <= 0.0 ) tolerance = ( rowsNumber > columnsNumber ? rowsNumber : columnsNumber ) * DBL_EPSILON;
+  
+  memcpy( auxArray, matrix->data, rowsNumber * columnsNumber * sizeof(double) );
+  
+  size_t completedSteps = stepsNumber;
+  if( stopEarly || columnsNumber <= QR_NATIVE_SIZE_MAX )
+  {
+    completedSteps = DecomposeQRPivotedNative( auxArray, rowsNumber, columnsNumber, pivotsList, tolerance, stopEarly );
+    
+    if( !stopEarly && ShouldVerifyShadow() )
+    {
+      memcpy( referenceArray, matrix->data, rowsNumber * columnsNumber * sizeof(double) );
+      DecomposeQRPivotedReference( referenceArray, rowsNumber, columnsNumber, referencePivotsList );
+      VerifyQRPivoted( matrix, auxArray, pivotsList, referenceArray, referencePivotsList, tolerance );
+    }
+  }
+  else DecomposeQRPivotedReference( auxArray, rowsNumber, columnsNumber, pivotsList );
+  
+  size_t rank = 0;
+  double rankThreshold = tolerance * fabs( auxArray[ 0 ] );
+  while( rank < completedSteps && fabs( auxArray[ rank * rowsNumber + rank ] ) > rankThreshold ) rank++;
+  
+  // Copy R (upper trapezoidal, with trailing block zeroed if decomposition stopped early)
+  for( size_t column = 0; column < columnsNumber; column++ )
+  {
+    for( size_t row = 0; row < stepsNumber; row++ )
+    {
+      bool isFactored = ( row <= column && row < completedSteps );
+      result->data[ column * stepsNumber + row ] = isFactored ? auxArray[ column * rowsNumber + row ] : 0.0;
+    }
+  }
+  result->rowsNumber = stepsNumber;
+  result->columnsNumber = columnsNumber;
+  
+  if( permutation != NULL ) memcpy( permutation->indexesList, pivotsList, columnsNumber * sizeof(size_t) );
+  
+  return rank;
+}
 
+Matrix Mat_GetNullSpace( Matrix factor, size_t rank, Permutation permutation, Matrix result )
+{
+  double triangularArray[ MATRIX_SIZE_MAX ], coefficientsArray[ MATRIX_SIZE_MAX ];
+  
+  if( factor == NULL || permutation == NULL || result == NULL || factor == result ) return NULL;
+  
+  size_t columnsNumber = factor->columnsNumber;
+  if( permutation->size != columnsNumber || rank > factor->rowsNumber || rank > columnsNumber ) return NULL;
+  
+  size_t nullity = columnsNumber - rank;
+  if( columnsNumber * nullity > result->dataLength ) return NULL;
+  
+  // Null space of A P = Q [ R11 R12 ] is spanned by [ -R11^(-1) R12; I ], to be reordered back by P
+  for( size_t column = 0; column < columnsNumber; column++ )
+  {
+    double* targetData = ( column < rank ) ? triangularArray + column * rank : coefficientsArray + ( column - rank ) * rank;
+    memcpy( targetData, factor->data + column * factor->rowsNumber, rank * sizeof(double) );
+  }
+  MatrixData triangular = WrapData( triangularArray, rank, rank );
+  MatrixData coefficients = WrapData( coefficientsArray, rank, nullity );
+  if( rank > 0 && nullity > 0 ) Mat_TriangularSolve( &triangular, MATRIX_UPPER, MATRIX_KEEP, MATRIX_NON_UNIT_DIAGONAL, &coefficients );
+  
+  result->rowsNumber = columnsNumber;
+  result->columnsNumber = nullity;
+  for( size_t column = 0; column < nullity; column++ )
+  {
+    double* columnData = result->data + column * columnsNumber;
+    for( size_t row = 0; row < columnsNumber; row++ )
+    {
+      double value;
+      if( row < rank ) value = -coefficientsArray[ column * rank + row ];
+      else value = ( row - rank == column ) ? 1.0 : 0.0;
+      columnData[ permutation->indexesList[ row ] ] = value;
+    }
+  }
+  
   return result;
 }
 
-Matrix Mat_Inverse( Matrix matrix, Matrix result )
+// Blocks of column-major storage are addressed in place, with matrix rows number as leading dimension
+static double* GetBlockData( Matrix matrix, MatrixBlock block )
 {
-  double auxArray[ MATRIX_SIZE_MAX ] = { 0 };
-  int pivotArray[ MATRIX_SIZE_MAX ];
-  int info;
+  if( matrix == NULL ) return NULL;
   
-  if( matrix == NULL || result == NULL ) return NULL;
+  if( block.firstRow + block.rowsNumber > matrix->rowsNumber || block.firstColumn + block.columnsNumber > matrix->columnsNumber ) return NULL;
+  
+  return matrix->data + block.firstColumn * matrix->rowsNumber + block.firstRow;
+}
 
-  if( matrix->rowsNumber != matrix->columnsNumber ) return NULL;
+// Single row or column block as strided vector
+static double* GetVectorData( Matrix matrix, MatrixBlock vector, size_t* length, size_t* stride )
+{
+  *length = 0;
+  *stride = 1;
+  
+  if( matrix == NULL ) return NULL;
+  
+  if( vector.rowsNumber != 1 && vector.columnsNumber != 1 ) return NULL;
+  
+  *length = ( vector.columnsNumber == 1 ) ? vector.rowsNumber : vector.columnsNumber;
+  *stride = ( vector.columnsNumber == 1 ) ? 1 : matrix->rowsNumber;
+  
+  return GetBlockData( matrix, vector );
+}
 
-  if( matrix != result )
+double Mat_GenerateHouseholder( Matrix matrix, MatrixBlock vector )
+{
+  size_t length, stride;
+  double tau = 0.0;
+  
+  double* vectorData = GetVectorData( matrix, vector, &length, &stride );
+  if( vectorData == NULL || length == 0 ) return 0.0;
+  
+  int n = (int) length, increment = (int) stride;
+  dlarfg_( &n, vectorData, vectorData + stride, &increment, &tau );
+  
+  return tau;
+}
+
+Matrix Mat_ApplyHouseholder( Matrix reflector, MatrixBlock vector, double tau, char side, Matrix matrix, MatrixBlock target )
+{
+  double reflectorArray[ MATRIX_SIZE_MAX ];
+  double workArray[ MATRIX_SIZE_MAX ];
+  size_t length, stride;
+  
+  if( reflector == NULL || matrix == NULL ) return NULL;
+  
+  const double* vectorData = GetVectorData( reflector, vector, &length, &stride );
+  double* targetData = GetBlockData( matrix, target );
+  if( vectorData == NULL || targetData == NULL ) return NULL;
+  
+  if( side != MATRIX_FROM_LEFT && side != MATRIX_FROM_RIGHT ) return NULL;
+  if( length != ( ( side == MATRIX_FROM_LEFT ) ? target.rowsNumber : target.columnsNumber ) ) return NULL;
+  
+  if( tau == 0.0 || target.rowsNumber == 0 || target.columnsNumber == 0 ) return matrix;
+  
+  // Contiguous copy with explicit unit first element: the stored one usually holds beta
+  reflectorArray[ 0 ] = 1.0;
+  for( size_t index = 1; index < length; index++ )
+    reflectorArray[ index ] = vectorData[ index * stride ];
+  
+  char sideCode = ( side == MATRIX_FROM_LEFT ) ? 'L' : 'R';
+  int m = (int) target.rowsNumber, n = (int) target.columnsNumber, increment = 1, leadingDimension = (int) matrix->rowsNumber;
+  dlarf_( &sideCode, &m, &n, reflectorArray, &increment, &tau, targetData, &leadingDimension, workArray );
+  
+  return matrix;
+}
+
+Matrix Mat_ApplyHouseholderBlock( Matrix reflectors, MatrixBlock vectors, double* tausList, char side, char transpose, Matrix matrix, MatrixBlock target )
+{
+  double reflectorsArray[ MATRIX_SIZE_MAX ];
+  double triangularArray[ MATRIX_SIZE_MAX ];
+  double workArray[ MATRIX_SIZE_MAX ];
+  
+  if( reflectors == NULL || tausList == NULL || matrix == NULL ) return NULL;
+  
+  const double* vectorsData = GetBlockData( reflectors, vectors );
+  double* targetData = GetBlockData( matrix, target );
+  if( vectorsData == NULL || targetData == NULL ) return NULL;
+  
+  if( side != MATRIX_FROM_LEFT && side != MATRIX_FROM_RIGHT ) return NULL;
+  size_t length = vectors.rowsNumber, reflectorsNumber = vectors.columnsNumber;
+  if( length != ( ( side == MATRIX_FROM_LEFT ) ? target.rowsNumber : target.columnsNumber ) || reflectorsNumber > length ) return NULL;
+  
+  if( reflectorsNumber == 0 || target.rowsNumber == 0 || target.columnsNumber == 0 ) return matrix;
+  
+  // Unit lower trapezoidal copy of the reflectors, so that their source storage is never modified
+  for( size_t column = 0; column < reflectorsNumber; column++ )
   {
-    result->rowsNumber = matrix->rowsNumber;
-    result->columnsNumber = matrix->columnsNumber;
+    double* reflectorColumn = reflectorsArray + column * length;
+    const double* sourceColumn = vectorsData + column * reflectors->rowsNumber;
+    for( size_t row = 0; row < length; row++ )
+      reflectorColumn[ row ] = ( row > column ) ? sourceColumn[ row ] : ( ( row == column ) ? 1.0 : 0.0 );
+  }
   
-    memcpy( result->data, matrix->data, matrix->rowsNumber * matrix->columnsNumber * sizeof(double) );
+  char direction = 'F', storage = 'C';
+  int n = (int) length, k = (int) reflectorsNumber;
+  dlarft_( &direction, &storage, &n, &k, reflectorsArray, &n, tausList, triangularArray, &k );
+  
+  char sideCode = ( side == MATRIX_FROM_LEFT ) ? 'L' : 'R';
+  char trans = ( transpose == MATRIX_TRANSPOSE ) ? 'T' : 'N';
+  int rowsNumber = (int) target.rowsNumber, columnsNumber = (int) target.columnsNumber, leadingDimension = (int) matrix->rowsNumber;
+  int workLength = ( side == MATRIX_FROM_LEFT ) ? columnsNumber : rowsNumber;
+  dlarfb_( &sideCode, &trans, &direction, &storage, &rowsNumber, &columnsNumber, &k, reflectorsArray, &n, 
+           triangularArray, &k, targetData, &leadingDimension, workArray, &workLength );
+  
+  return matrix;
+}
+
+void Mat_GenerateGivens( double a, double b, double* cosine, double* sine, double* radius )
+{
+  double radiusValue;
+  
+  if( cosine == NULL || sine == NULL ) return;
+  
+  dlartg_( &a, &b, cosine, sine, &radiusValue );
+  
+  if( radius != NULL ) *radius = radiusValue;
+}
+
+Matrix Mat_ApplyGivens( Matrix matrix, MatrixBlock target, char side, size_t index_1, size_t index_2, double cosine, double sine )
+{
+  double* targetData = GetBlockData( matrix, target );
+  if( targetData == NULL ) return NULL;
+  
+  if( side != MATRIX_FROM_LEFT && side != MATRIX_FROM_RIGHT ) return NULL;
+  
+  bool isLeft = ( side == MATRIX_FROM_LEFT );
+  size_t linesNumber = isLeft ? target.rowsNumber : target.columnsNumber;
+  if( index_1 >= linesNumber || index_2 >= linesNumber || index_1 == index_2 ) return NULL;
+  
+  // Rows are strided by the leading dimension, columns are contiguous
+  size_t lineStep = isLeft ? 1 : matrix->rowsNumber;
+  int n = (int) ( isLeft ? target.columnsNumber : target.rowsNumber ), increment = (int) ( isLeft ? matrix->rowsNumber : 1 );
+  drot_( &n, targetData + index_1 * lineStep, &increment, targetData + index_2 * lineStep, &increment, &cosine, &sine );
+  
+  return matrix;
+}
+
+Matrix Mat_ApplyGivensSequence( Matrix matrix, MatrixBlock target, char side, double* cosinesList, double* sinesList, bool isBackward )
+{
+  double* targetData = GetBlockData( matrix, target );
+  if( targetData == NULL || cosinesList == NULL || sinesList == NULL ) return NULL;
+  
+  if( side != MATRIX_FROM_LEFT && side != MATRIX_FROM_RIGHT ) return NULL;
+  
+  if( target.rowsNumber < 2 && side == MATRIX_FROM_LEFT ) return matrix;
+  if( target.columnsNumber < 2 && side == MATRIX_FROM_RIGHT ) return matrix;
+  
+  // LAPACK applies P x A (or A x P^T) with rotation P_k = [ c s; -s c ] on planes ( k, k + 1 )
+  char sideCode = ( side == MATRIX_FROM_LEFT ) ? 'L' : 'R', pivot = 'V', direction = isBackward ? 'B' : 'F';
+  int m = (int) target.rowsNumber, n = (int) target.columnsNumber, leadingDimension = (int) matrix->rowsNumber;
+  dlasr_( &sideCode, &pivot, &direction, &m, &n, cosinesList, sinesList, targetData, &leadingDimension );
+  
+  return matrix;
+}
+
+MassFactorization Mat_CreateMassFactorization( size_t size )
+{
+  if( size * size > MATRIX_SIZE_MAX ) return NULL;
+  
+  MassFactorization newFactorization = (MassFactorization) calloc( 1, sizeof(MassFactorizationData) );
+  if( newFactorization == NULL ) return NULL;
+  
+  newFactorization->factorData = (double*) malloc( ( size * size + 1 ) * sizeof(double) );
+  newFactorization->workArray = (double*) malloc( ( EIGEN_WORK_LENGTH( size ) + 1 ) * sizeof(double) );
+  newFactorization->indexesArray = (int*) malloc( ( EIGEN_INDEXES_LENGTH( size ) + 2 * size + 1 ) * sizeof(int) );
+  newFactorization->size = size;
+  
+  if( newFactorization->factorData == NULL || newFactorization->workArray == NULL || newFactorization->indexesArray == NULL )
+  {
+    Mat_DiscardMassFactorization( newFactorization );
+    return NULL;
   }
   
-  dgetrf_( (int*) &(result->rowsNumber), (int*) &(result->columnsNumber), result->data, (int*) &(result->rowsNumber), pivotArray, &info );
+  return newFactorization;
+}
+
+void Mat_DiscardMassFactorization( MassFactorization factorization )
+{
+  if( factorization == NULL ) return;
+  
+  free( factorization->factorData );
+  free( factorization->workArray );
+  free( factorization->indexesArray );
   
+  free( factorization );
+}
+
+MassFactorization Mat_DecomposeMass( Matrix mass, MassFactorization factorization )
+{
+  if( mass == NULL || factorization == NULL ) return NULL;
+  
+  size_t size = factorization->size;
+  if( mass->rowsNumber != size || mass->columnsNumber != size || size == 0 ) return NULL;
+  
+  char uplo = 'L';
+  int order = (int) size, info;
+  memcpy( factorization->factorData, mass->data, size * size * sizeof(double) );
+  dpotrf_( &uplo, &order, factorization->factorData, &order, &info );
+  
+  factorization->isDecomposed = ( info == 0 );
+  if( !factorization->isDecomposed ) return NULL;
+  
+  return factorization;
+}
+
+Matrix Mat_GeneralizedEigen( Matrix stiffness, MassFactorization mass, size_t modesNumber, Matrix values, Matrix vectors )
+{
+  double reducedArray[ MATRIX_SIZE_MAX ];
+  double eigenvaluesArray[ MATRIX_SIZE_MAX ];
+  
+  if( stiffness == NULL || mass == NULL || values == NULL ) return NULL;
+  
+  size_t size = stiffness->rowsNumber;
+  if( stiffness->columnsNumber != size || mass->size != size || size == 0 ) return NULL;
+  if( !mass->isDecomposed ) return NULL;
+  
+  if( modesNumber == 0 || modesNumber > size ) modesNumber = size;
+  
+  if( modesNumber > values->dataLength ) return NULL;
+  if( vectors != NULL && size * modesNumber > vectors->dataLength ) return NULL;
+  
+  // Reduction to standard symmetric problem C = L^(-1) x K x L^(-T), with M = L x L^T
+  char uplo = 'L';
+  int order = (int) size, problemType = 1, info;
+  memcpy( reducedArray, stiffness->data, size * size * sizeof(double) );
+  dsygst_( &problemType, &uplo, &order, reducedArray, &order, mass->factorData, &order, &info );
   if( info != 0 ) return NULL;
   
-  int workLength = result->rowsNumber * result->columnsNumber;
-  dgetri_( (int*) &(result->rowsNumber), result->data, (int*) &(result->rowsNumber), pivotArray, auxArray, &workLength, &info );
+  // Only the lowest modes are calculated, if requested
+  char jobz = ( vectors != NULL ) ? 'V' : 'N';
+  char range = ( modesNumber < size ) ? 'I' : 'A';
+  int lowestIndex = 1, highestIndex = (int) modesNumber, foundNumber;
+  double lowerBound = 0.0, upperBound = 0.0, absoluteTolerance = 0.0;
+  int workLength = (int) EIGEN_WORK_LENGTH( size ), indexesLength = (int) EIGEN_INDEXES_LENGTH( size );
+  double* eigenvectorsData = ( vectors != NULL ) ? vectors->data : NULL;
+  dsyevr_( &jobz, &range, &uplo, &order, reducedArray, &order, &lowerBound, &upperBound, &lowestIndex, &highestIndex, &absoluteTolerance, 
+           &foundNumber, eigenvaluesArray, eigenvectorsData, &order, mass->indexesArray + EIGEN_INDEXES_LENGTH( size ), 
+           mass->workArray, &workLength, mass->indexesArray, &indexesLength, &info );
+  if( info != 0 || foundNumber != (int) modesNumber ) return NULL;
+  
+  memcpy( values->data, eigenvaluesArray, modesNumber * sizeof(double) );
+  values->rowsNumber = modesNumber;
+  values->columnsNumber = 1;
+  
+  if( vectors != NULL )
+  {
+    // Back transformation of eigenvectors: x = L^(-T) x z (M-orthonormal)
+    vectors->rowsNumber = size;
+    vectors->columnsNumber = modesNumber;
+    MatrixData massFactor = WrapData( mass->factorData, size, size );
+    Mat_TriangularSolve( &massFactor, MATRIX_LOWER, MATRIX_TRANSPOSE, MATRIX_NON_UNIT_DIAGONAL, vectors );
+  }
+  
+  return values;
+}
+
+LDLTFactorization Mat_CreateLDLT( size_t size )
+{
+  int order = (int) size, info, workQueryLength = -1;
+  double optimalWorkLength = 1.0;
+  char uplo = 'L';
+  
+  if( size * size > MATRIX_SIZE_MAX ) return NULL;
+  
+  LDLTFactorization newFactorization = (LDLTFactorization) calloc( 1, sizeof(LDLTData) );
+  if( newFactorization == NULL ) return NULL;
+  
+  // Workspace size query, so that decompositions never allocate
+  if( size > 0 ) dsytrf_( &uplo, &order, NULL, &order, NULL, &optimalWorkLength, &workQueryLength, &info );
+  newFactorization->workLength = ( optimalWorkLength > 1.0 ) ? (int) optimalWorkLength : 1;
+  
+  newFactorization->factorData = (double*) malloc( ( size * size + 1 ) * sizeof(double) );
+  newFactorization->pivotsList = (int*) malloc( ( size + 1 ) * sizeof(int) );
+  newFactorization->workArray = (double*) malloc( newFactorization->workLength * sizeof(double) );
+  newFactorization->size = size;
+  
+  if( newFactorization->factorData == NULL || newFactorization->pivotsList == NULL || newFactorization->workArray == NULL )
+  {
+    Mat_DiscardLDLT( newFactorization );
+    return NULL;
+  }
+  
+  return newFactorization;
+}
+
+void Mat_DiscardLDLT( LDLTFactorization factorization )
+{
+  if( factorization == NULL ) return;
+  
+  free( factorization->factorData );
+  free( factorization->pivotsList );
+  free( factorization->workArray );
+  
+  free( factorization );
+}
+
+// In-tree unblocked Bunch-Kaufman decomposition (same algorithm and storage as LAPACK dsytf2 with lower triangle)
+static bool DecomposeLDLTNative( double* factorData, int* pivotsList, size_t size )
+{
+  const double ALPHA = ( 1.0 + sqrt( 17.0 ) ) / 8.0;
+  #define A( row, column ) factorData[ (column) * size + (row) ]
+  
+  bool isSingular = false;
+  size_t k = 0;
+  while( k < size )
+  {
+    size_t pivotStep = 1, pivotIndex = k;
+    double diagonalMax = fabs( A( k, k ) );
+    size_t maxRow = k;
+    double columnMax = 0.0;
+    if( k + 1 < size )
+    {
+      maxRow = k + 1 + FindMaxAbsolute( &A( k + 1, k ), size - k - 1, 1 );
+      columnMax = fabs( A( maxRow, k ) );
+    }
+    
+    if( ( diagonalMax > columnMax ? diagonalMax : columnMax ) == 0.0 || isnan( diagonalMax ) ) isSingular = true;
+    else
+    {
+      if( diagonalMax < ALPHA * columnMax )
+      {
+        size_t maxColumn = k + FindMaxAbsolute( &A( maxRow, k ), maxRow - k, size );
+        double rowMax = fabs( A( maxRow, maxColumn ) );
+        if( maxRow + 1 < size )
+        {
+          size_t belowRow = maxRow + 1 + FindMaxAbsolute( &A( maxRow + 1, maxRow ), size - maxRow - 1, 1 );
+          if( fabs( A( belowRow, maxRow ) ) > rowMax ) rowMax = fabs( A( belowRow, maxRow ) );
+        }
+        
+        if( diagonalMax >= ALPHA * columnMax * ( columnMax / rowMax ) ) pivotIndex = k;
+        else if( fabs( A( maxRow, maxRow ) ) >= ALPHA * rowMax ) pivotIndex = maxRow;
+        else
+        {
+          pivotIndex = maxRow;
+          pivotStep = 2;
+        }
+      }
+      
+      // Symmetric interchange of rows/columns kk and pivotIndex on the trailing (lower) submatrix
+      size_t kk = k + pivotStep - 1;
+      if( pivotIndex != kk )
+      {
+        double swapValue;
+        for( size_t row = pivotIndex + 1; row < size; row++ )
+        {
+          swapValue = A( row, kk ); A( row, kk ) = A( row, pivotIndex ); A( row, pivotIndex ) = swapValue;
+        }
+        for( size_t index = kk + 1; index < pivotIndex; index++ )
+        {
+          swapValue = A( index, kk ); A( index, kk ) = A( pivotIndex, index ); A( pivotIndex, index ) = swapValue;
+        }
+        swapValue = A( kk, kk ); A( kk, kk ) = A( pivotIndex, pivotIndex ); A( pivotIndex, pivotIndex ) = swapValue;
+        if( pivotStep == 2 )
+        {
+          swapValue = A( k + 1, k ); A( k + 1, k ) = A( pivotIndex, k ); A( pivotIndex, k ) = swapValue;
+        }
+      }
+      
+      if( pivotStep == 1 )
+      {
+        if( k + 1 < size )
+        {
+          double inverse = 1.0 / A( k, k );
+          for( size_t column = k + 1; column < size; column++ )
+          {
+            for( size_t row = column; row < size; row++ )
+              A( row, column ) -= inverse * A( row, k ) * A( column, k );
+          }
+          for( size_t row = k + 1; row < size; row++ )
+            A( row, k ) *= inverse;
+        }
+      }
+      else if( k + 2 < size )
+      {
+        double d21 = A( k + 1, k );
+        double d11 = A( k + 1, k + 1 ) / d21;
+        double d22 = A( k, k ) / d21;
+        double t = 1.0 / ( d11 * d22 - 1.0 );
+        d21 = t / d21;
+        for( size_t column = k + 2; column < size; column++ )
+        {
+          double wk = d21 * ( d11 * A( column, k ) - A( column, k + 1 ) );
+          double wkp1 = d21 * ( d22 * A( column, k + 1 ) - A( column, k ) );
+          for( size_t row = column; row < size; row++ )
+            A( row, column ) = A( row, column ) - A( row, k ) * wk - A( row, k + 1 ) * wkp1;
+          A( column, k ) = wk;
+          A( column, k + 1 ) = wkp1;
+        }
+      }
+    }
+    
+    if( pivotStep == 1 ) pivotsList[ k ] = (int) pivotIndex + 1;
+    else pivotsList[ k ] = pivotsList[ k + 1 ] = -( (int) pivotIndex + 1 );
+    
+    k += pivotStep;
+  }
+  
+  #undef A
+  return !isSingular;
+}
+
+static bool DecomposeLDLTReference( LDLTFactorization factorization, double* factorData, int* pivotsList )
+{
+  int order = (int) factorization->size, info;
+  char uplo = 'L';
+  
+  dsytrf_( &uplo, &order, factorData, &order, pivotsList, factorization->workArray, &(factorization->workLength), &info );
+  
+  return ( info == 0 );
+}
+
+LDLTFactorization Mat_DecomposeLDLT( Matrix matrix, LDLTFactorization factorization )
+{
+  double referenceArray[ MATRIX_SIZE_MAX ];
+  int referencePivotsList[ LDLT_NATIVE_SIZE_MAX ];
+  
+  if( matrix == NULL || factorization == NULL ) return NULL;
+  
+  if( matrix->rowsNumber != factorization->size || matrix->columnsNumber != factorization->size ) return NULL;
+  
+  size_t size = factorization->size;
+  memcpy( factorization->factorData, matrix->data, size * size * sizeof(double) );
+  factorization->isDecomposed = true;
+  
+  if( size > LDLT_NATIVE_SIZE_MAX )
+  {
+    factorization->isSingular = !DecomposeLDLTReference( factorization, factorization->factorData, factorization->pivotsList );
+    return factorization;
+  }
+  
+  factorization->isSingular = !DecomposeLDLTNative( factorization->factorData, factorization->pivotsList, size );
+  
+  if( size > 0 && ShouldVerifyShadow() )
+  {
+    memcpy( referenceArray, matrix->data, size * size * sizeof(double) );
+    DecomposeLDLTReference( factorization, referenceArray, referencePivotsList );
+    // Same algorithm and storage: any different interchange also shows up as a factors mismatch
+    MatrixData inputsList[ 1 ] = { *matrix };
+    VerifyShadow( "LDLT", inputsList, 1, factorization->factorData, referenceArray, size, size );
+  }
+  
+  return factorization;
+}
+
+Matrix Mat_SolveLDLT( LDLTFactorization factorization, Matrix matrix )
+{
+  char uplo = 'L';
+  int info;
+  
+  if( factorization == NULL || matrix == NULL ) return NULL;
+  
+  if( !factorization->isDecomposed || factorization->isSingular ) return NULL;
+  
+  if( matrix->rowsNumber != factorization->size ) return NULL;
+  
+  if( matrix->columnsNumber == 0 || factorization->size == 0 ) return matrix;
+  
+  int order = (int) factorization->size, columnsNumber = (int) matrix->columnsNumber;
+  dsytrs_( &uplo, &order, &columnsNumber, factorization->factorData, &order, factorization->pivotsList, matrix->data, &order, &info );
   
   if( info != 0 ) return NULL;
+  
+  return matrix;
+}
 
-  return result;
+bool Mat_GetLDLTInertia( LDLTFactorization factorization, size_t* positivesNumber, size_t* negativesNumber, size_t* zerosNumber )
+{
+  size_t inertiaList[ 3 ] = { 0, 0, 0 };     // Positive, negative and zero eigenvalues counts
+  
+  if( factorization == NULL ) return false;
+  
+  if( !factorization->isDecomposed ) return false;
+  
+  // By Sylvester's law of inertia, A and the block diagonal D have the same eigenvalue signs
+  size_t size = factorization->size;
+  const double* D = factorization->factorData;
+  for( size_t k = 0; k < size; k++ )
+  {
+    if( factorization->pivotsList[ k ] > 0 )
+    {
+      double value = D[ k * size + k ];
+      inertiaList[ ( value > 0.0 ) ? 0 : ( ( value < 0.0 ) ? 1 : 2 ) ]++;
+    }
+    else
+    {
+      // 2x2 block: determinant sign tells if eigenvalues have opposite signs
+      double a = D[ k * size + k ], b = D[ k * size + k + 1 ], c = D[ ( k + 1 ) * size + k + 1 ];
+      double determinant = a * c - b * b;
+      if( determinant < 0.0 ) { inertiaList[ 0 ]++; inertiaList[ 1 ]++; }
+      else if( determinant > 0.0 ) inertiaList[ ( a + c > 0.0 ) ? 0 : 1 ] += 2;
+      else { inertiaList[ 2 ]++; inertiaList[ ( a + c > 0.0 ) ? 0 : ( ( a + c < 0.0 ) ? 1 : 2 ) ]++; }
+      k++;
+    }
+  }
+  
+  if( positivesNumber != NULL ) *positivesNumber = inertiaList[ 0 ];
+  if( negativesNumber != NULL ) *negativesNumber = inertiaList[ 1 ];
+  if( zerosNumber != NULL ) *zerosNumber = inertiaList[ 2 ];
+  
+  return true;
 }
 
 void Mat_Print( Matrix matrix )
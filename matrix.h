@@ -27,8 +27,12 @@
 #define MATRIX_H
 
 #include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
 
-#define MATRIX_SIZE_MAX (50 * 50)   ///< Maximum allowed matrix number of elements (rows x columns)
+#ifndef MATRIX_SIZE_MAX
+#define MATRIX_SIZE_MAX (50 * 50)   ///< Maximum allowed matrix number of elements (rows x columns). Scratch arrays are stack allocated with this size, so it may be redefined at build time (same value for library and users)
+#endif
 
 #define MATRIX_IDENTITY 'I'         ///< Create square matrix as identity type (main diagonal filled with 1's)
 #define MATRIX_ZERO '0'             ///< Create square matrix as zero type (completely zeroed)
@@ -36,10 +40,65 @@
 #define MATRIX_TRANSPOSE 'T'        ///< Transpose matrix before multiplication
 #define MATRIX_KEEP 'N'             ///< Keep matrix unadulterated before multiplication
 
+#define MATRIX_UPPER 'U'            ///< Use upper triangle of matrix (lower one is not accessed)
+#define MATRIX_LOWER 'L'            ///< Use lower triangle of matrix (upper one is not accessed)
+
+#define MATRIX_ALONG_COLUMNS 'C'    ///< Operate along each column (over consecutive rows)
+#define MATRIX_ALONG_ROWS 'R'       ///< Operate along each row (over consecutive columns)
+
+#define MATRIX_TRAPEZOIDAL_RULE 'T' ///< Integrate with trapezoidal rule (linear interpolation between samples)
+#define MATRIX_SIMPSON_RULE 'S'     ///< Integrate with Simpson's rule (quadratic interpolation between samples)
+
+#define MATRIX_UNIT_DIAGONAL 'U'    ///< Consider triangular matrix main diagonal filled with 1's (not accessed)
+#define MATRIX_NON_UNIT_DIAGONAL 'N'  ///< Use actual values of triangular matrix main diagonal
+
+#define MATRIX_FROM_LEFT 'L'        ///< Apply transformation to the left of target matrix (acting on its rows)
+#define MATRIX_FROM_RIGHT 'R'       ///< Apply transformation to the right of target matrix (acting on its columns)
+
+#define MATRIX_KERNEL_GAUSSIAN 'G'  ///< Squared exponential (RBF) kernel: s² exp( -r² / 2l² )
+#define MATRIX_KERNEL_MATERN_3_2 '3'  ///< Matérn kernel with nu = 3/2: s² ( 1 + √3 r/l ) exp( -√3 r/l )
+#define MATRIX_KERNEL_MATERN_5_2 '5'  ///< Matérn kernel with nu = 5/2: s² ( 1 + √5 r/l + 5r²/3l² ) exp( -√5 r/l )
+
 
 typedef struct _MatrixData MatrixData;    ///< Matrix internal data structure
 typedef MatrixData* Matrix;               ///< Opaque reference to Matrix data structure
 
+typedef struct _PermutationData PermutationData;    ///< Permutation internal data structure
+typedef PermutationData* Permutation;               ///< Opaque reference to Permutation (reordering index list) data structure
+
+typedef struct _LDLTData LDLTData;                  ///< LDL^T factorization internal data structure
+typedef LDLTData* LDLTFactorization;                ///< Opaque reference to symmetric indefinite (LDL^T) factorization data structure
+
+typedef struct _MassFactorizationData MassFactorizationData;    ///< Mass matrix factorization internal data structure
+typedef MassFactorizationData* MassFactorization;               ///< Opaque reference to mass matrix (Cholesky) factorization and generalized eigensolver workspace
+
+/// @brief Function called when a shadow verification check fails. Matrix references are only valid during the call (copy them to replay the failing case)
+/// @param[in] operationName name of the checked operation, with its parameters (e.g. "Dot(N,T)")
+/// @param[in] inputsList list of references to operation input matrices (as stored, before any transposition)
+/// @param[in] inputsNumber number of input matrices in @a inputsList
+/// @param[in] fastResult reference to result obtained by the fast (in-tree) path
+/// @param[in] referenceResult reference to result obtained by the reference (BLAS/LAPACK) path
+/// @param[in] maxDifference maximum absolute difference between the 2 results
+typedef void (*MatrixMismatchCallback)( const char* operationName, Matrix* inputsList, size_t inputsNumber, Matrix fastResult, Matrix referenceResult, double maxDifference );
+
+/// Dimensions of a matrix to be created
+typedef struct _MatrixShape
+{
+  size_t rowsNumber;        ///< number of rows
+  size_t columnsNumber;     ///< number of columns
+}
+MatrixShape;
+
+/// Rectangular region (submatrix) of a matrix, operated in place
+typedef struct _MatrixBlock
+{
+  size_t firstRow;          ///< index of block first row
+  size_t firstColumn;       ///< index of block first column
+  size_t rowsNumber;        ///< number of block rows
+  size_t columnsNumber;     ///< number of block columns
+}
+MatrixBlock;
+
 
 /// @brief Creates matrix with specified values and dimensions                                               
 /// @param[in] data array with values in row-major order to fill matrix data (NULL for filling with zeros)                                 
@@ -48,20 +107,64 @@ typedef MatrixData* Matrix;               ///< Opaque reference to Matrix data s
 /// @return reference/pointer to allocated and filled matrix (NULL if elements number is greater than MATRIX_SIZE_MAX)
 Matrix Mat_Create( double* data, size_t rowsNumber, size_t columnsNumber );     
 
+/// @brief Creates matrix with specified dimensions, without initializing its values (faster, for results about to be overwritten)
+/// @param[in] rowsNumber number of rows
+/// @param[in] columnsNumber number of columns
+/// @return reference/pointer to allocated matrix, with undefined contents (NULL if elements number is greater than MATRIX_SIZE_MAX)
+Matrix Mat_CreateUninitialized( size_t rowsNumber, size_t columnsNumber );
+
+/// @brief Creates matrix with the same dimensions of a given one, without initializing its values
+/// @param[in] matrix reference to matrix whose dimensions will be replicated
+/// @return reference/pointer to allocated matrix, with undefined contents (NULL on errors)
+Matrix Mat_CreateLike( Matrix matrix );
+
+/// @brief Creates matrix with specified dimensions from an array already in internal (column-major) order, with a single copy
+/// @param[in] data array with values in column-major order to fill matrix data
+/// @param[in] rowsNumber number of rows
+/// @param[in] columnsNumber number of columns
+/// @return reference/pointer to allocated and filled matrix (NULL on errors or if elements number is greater than MATRIX_SIZE_MAX)
+Matrix Mat_CreateFromColumnMajor( double* data, size_t rowsNumber, size_t columnsNumber );
+
 /// @brief Creates square matrix of specified size and type                              
 /// @param[in] size size/order of the square matrix (equal number of rows and cells)
 /// @param[in] type defines if internal data is filled as zero (MATRIX_ZERO) or identity (MATRIX_IDENTITY) matrix       
 /// @return reference/pointer to allocated and filled matrix (NULL if size is bigger than MATRIX_SIZE_MAX)
 Matrix Mat_CreateSquare( size_t size, char type );
 
+/// @brief Creates group of zeroed matrices sharing a single contiguous memory block (headers and cache-line aligned buffers), for locality of related data
+/// @param[in] count number of matrices in the group
+/// @param[in] shapes list of dimensions for each created matrix
+/// @param[in] accessOrder list of matrix indexes (each one exactly once) in the order their buffers should be laid out in memory, e.g. the order of use (NULL for list order)
+/// @param[out] groupList list to be filled with references to the created matrices
+/// @return reference/pointer to filled @a groupList (NULL on errors, invalid access order or if count or any elements number is greater than MATRIX_SIZE_MAX)
+Matrix* Mat_CreateGroup( size_t count, MatrixShape* shapes, size_t* accessOrder, Matrix* groupList );
+
+/// @brief Destroys/deallocates memory of a whole group of co-allocated matrices, unlocking it if needed (Mat_Discard has no effect on group members)
+/// @param[in] member reference to any matrix of the group
+void Mat_DiscardGroup( Matrix member );
+
 /// @brief Destroys/deallocates memory of matrix 
 /// @param[in] matrix reference to matrix to be destroyed/deallocated
 void Mat_Discard( Matrix matrix );
                                                                       
+/// @brief Locks matrix data buffer into RAM and touches all its pages, avoiding page faults on first use (kept locked across Mat_Resize). 
+/// Data is moved to pages of its own before locking, and group members lock their whole group block until the last one is unlocked
+/// @param[in] matrix reference to matrix to be locked
+/// @return true on success, false on errors or if memory locking is not available/allowed
+bool Mat_Lock( Matrix matrix );
+
+/// @brief Allows matrix data buffer previously locked with Mat_Lock to be paged out again
+/// @param[in] matrix reference to matrix to be unlocked
+void Mat_Unlock( Matrix matrix );
+
+/// @brief Locks all current and future process memory into RAM and pre-faults the stack depth used by internal scratch arrays, for real-time use
+/// @return true on success, false if memory locking is not available/allowed (stack pre-faulting is performed anyway)
+bool Mat_PrefaultAll( void );
+
 /// @brief Copies content from one matrix to another, previously allocated  
 /// @param[in] source reference to matrix from which data will be copied
-/// @param[in] destination matrix to which data will be copied
-/// @return reference/pointer to destination matrix (NULL on errors)
+/// @param[in] destination matrix to which data will be copied (reshaped to source dimensions, within its allocated space)
+/// @return reference/pointer to destination matrix (NULL on errors or if source elements don't fit destination allocated space)
 Matrix Mat_Copy( Matrix source, Matrix destination );
 
 /// @brief Sets all elements of given matrix to zero                             
@@ -104,13 +207,148 @@ double* Mat_GetData( Matrix matrix, double* buffer );
 /// @param[in] data row-major order data array for filling the matrix
 void Mat_SetData( Matrix matrix, double* data );
 
+/// @brief Gets all matrix values in internal (column-major) order, with a single contiguous copy
+/// @param[in] matrix reference to matrix
+/// @param[out] buffer reference to array (with at least rows x columns length) to be filled
+/// @return pointer to filled buffer (NULL on errors)
+double* Mat_GetColumnMajorData( Matrix matrix, double* buffer );
+
+/// @brief Sets all matrix values from an array in internal (column-major) order, with a single contiguous copy (as in Mat_CreateFromColumnMajor)
+/// @param[in] matrix reference to matrix
+/// @param[in] data column-major order data array (with at least rows x columns length) for filling the matrix
+void Mat_SetColumnMajorData( Matrix matrix, double* data );
+
+/// @brief Gets values of given matrix row at once
+/// @param[in] matrix reference to matrix
+/// @param[in] row row position of accessed elements
+/// @param[out] buffer reference to array (with at least columns number length) to be filled
+/// @return pointer to filled buffer (NULL on errors)
+double* Mat_GetRow( Matrix matrix, size_t row, double* buffer );
+
+/// @brief Sets values of given matrix row at once
+/// @param[in] matrix reference to matrix
+/// @param[in] row row position of updated elements
+/// @param[in] data array (with at least columns number length) of new row values
+void Mat_SetRow( Matrix matrix, size_t row, double* data );
+
+/// @brief Gets values of given matrix column at once (single contiguous copy)
+/// @param[in] matrix reference to matrix
+/// @param[in] column column position of accessed elements
+/// @param[out] buffer reference to array (with at least rows number length) to be filled
+/// @return pointer to filled buffer (NULL on errors)
+double* Mat_GetColumn( Matrix matrix, size_t column, double* buffer );
+
+/// @brief Sets values of given matrix column at once (single contiguous copy)
+/// @param[in] matrix reference to matrix
+/// @param[in] column column position of updated elements
+/// @param[in] data array (with at least rows number length) of new column values
+void Mat_SetColumn( Matrix matrix, size_t column, double* data );
+
+/// @brief Exchanges values of 2 rows of given matrix, in place
+/// @param[in] matrix reference to matrix
+/// @param[in] row_1 position of first row
+/// @param[in] row_2 position of second row
+/// @return reference/pointer to updated matrix (NULL on errors)
+Matrix Mat_SwapRows( Matrix matrix, size_t row_1, size_t row_2 );
+
+/// @brief Exchanges values of 2 columns of given matrix, in place
+/// @param[in] matrix reference to matrix
+/// @param[in] column_1 position of first column
+/// @param[in] column_2 position of second column
+/// @return reference/pointer to updated matrix (NULL on errors)
+Matrix Mat_SwapColumns( Matrix matrix, size_t column_1, size_t column_2 );
+
+/// @brief Extracts submatrix formed by arbitrary lists of rows and columns (in any order, with possible repetitions) of given matrix
+/// @param[in] matrix reference to source matrix
+/// @param[in] rowIndexes list of source row positions to be extracted (NULL for all rows, in order)
+/// @param[in] rowsNumber length of @a rowIndexes list (ignored if it's NULL)
+/// @param[in] columnIndexes list of source column positions to be extracted (NULL for all columns, in order)
+/// @param[in] columnsNumber length of @a columnIndexes list (ignored if it's NULL)
+/// @param[out] result preallocated matrix to store the extracted submatrix (can be the same as the input one). It is reshaped to 
+/// the gathered (rowsNumber x columnsNumber) dimensions, which must fit its allocated space
+/// @return reference/pointer to @a result matrix (NULL on errors or invalid indexes, leaving @a result unchanged)
+Matrix Mat_Gather( Matrix matrix, size_t* rowIndexes, size_t rowsNumber, size_t* columnIndexes, size_t columnsNumber, Matrix result );
+
+/// @brief Writes all elements of given matrix into arbitrary rows and columns of another one: matrix[ rowIndexes[ i ], columnIndexes[ j ] ] = source[ i, j ]
+/// @param[in] source reference to matrix with values to be written
+/// @param[in] rowIndexes list (with source rows number length) of target row positions (NULL for all rows, in order)
+/// @param[in] columnIndexes list (with source columns number length) of target column positions (NULL for all columns, in order)
+/// @param[in] matrix reference to updated matrix (must be different from @a source)
+/// @return reference/pointer to updated matrix (NULL on errors or invalid indexes)
+Matrix Mat_Scatter( Matrix source, size_t* rowIndexes, size_t* columnIndexes, Matrix matrix );
+
+/// @brief Accumulates all elements of given matrix into arbitrary rows and columns of another one: matrix[ rowIndexes[ i ], columnIndexes[ j ] ] += source[ i, j ]
+/// @param[in] source reference to matrix with values to be added
+/// @param[in] rowIndexes list (with source rows number length) of target row positions (NULL for all rows, in order)
+/// @param[in] columnIndexes list (with source columns number length) of target column positions (NULL for all columns, in order)
+/// @param[in] matrix reference to updated matrix (must be different from @a source)
+/// @return reference/pointer to updated matrix (NULL on errors or invalid indexes)
+Matrix Mat_ScatterAdd( Matrix source, size_t* rowIndexes, size_t* columnIndexes, Matrix matrix );
+
 /// @brief Resizes/reallocates given matrix to specified dimensions. Fill new space with zeros when growing                    
-/// @param[in] matrix reference to matrix to be resized
+/// @param[in] matrix reference to matrix to be resized (group members can't grow beyond their creation elements number)
 /// @param[in] rowsNumber new number of rows
 /// @param[in] columnsNumber new number of columns
-/// @return reference/pointer to resized/reallocated matrix (NULL on errors)
+/// @return reference/pointer to resized/reallocated matrix (NULL on errors, or if a locked matrix could not be kept locked, with dimensions and contents unchanged)
 Matrix Mat_Resize( Matrix matrix, size_t rowsNumber, size_t columnsNumber );
 
+/// @brief Checks if all elements of 2 matrices are approximately equal: |a - b| <= absoluteTolerance + relativeTolerance * max( |a|, |b| )
+/// @param[in] matrix_1 reference to first matrix
+/// @param[in] matrix_2 reference to second matrix
+/// @param[in] absoluteTolerance maximum absolute difference allowed
+/// @param[in] relativeTolerance maximum difference allowed relative to the larger absolute value
+/// @return true if dimensions match and all elements are within tolerance, false otherwise (or if any element is NaN)
+bool Mat_ApproxEqual( Matrix matrix_1, Matrix matrix_2, double absoluteTolerance, double relativeTolerance );
+
+/// @brief Calculates maximum absolute difference between corresponding elements of 2 matrices
+/// @param[in] matrix_1 reference to first matrix
+/// @param[in] matrix_2 reference to second matrix
+/// @return maximum absolute element difference (INFINITY on errors or dimensions mismatch, NaN if any difference is NaN)
+double Mat_MaxAbsDiff( Matrix matrix_1, Matrix matrix_2 );
+
+/// @brief Checks if given matrix contains any infinite or NaN element
+/// @param[in] matrix reference to matrix
+/// @return true if any element is not finite, false otherwise
+bool Mat_HasNonFinite( Matrix matrix );
+
+/// @brief Calculates cheap (non-cryptographic) hash of matrix dimensions and contents, for detecting unchanged inputs
+/// @param[in] matrix reference to matrix
+/// @return 64-bit fingerprint value (equal for bitwise identical matrices. 0 on errors)
+uint64_t Mat_GetFingerprint( Matrix matrix );
+
+/// @brief Enables/disables reproducible mode, in which matrix products use an in-tree kernel with fixed tiling and summation order instead of (possibly multithreaded) BLAS,
+/// giving bitwise identical results regardless of threads number and operands storage (reductions like Mat_SumElements and Mat_Norm are always reproducible)
+/// @param[in] enabled true for reproducible products, false (default) for BLAS ones
+void Mat_SetReproducible( bool enabled );
+
+/// @brief Configures shadow verification mode, in which a sampled fraction of calls to fast (in-tree) kernels is also executed through reference BLAS/LAPACK routines and compared.
+/// Resets mismatch statistics
+/// @param[in] sampleRate fraction (0.0 to 1.0) of fast path calls to be verified (0.0 disables verification)
+/// @param[in] tolerance absolute and relative tolerance for results comparison (as in Mat_ApproxEqual)
+/// @param[in] callback function called with shapes and inputs of each mismatch, for recording/replay (NULL for only counting them)
+void Mat_SetShadowVerification( double sampleRate, double tolerance, MatrixMismatchCallback callback );
+
+/// @brief Gets shadow verification statistics since the last call to Mat_SetShadowVerification
+/// @param[out] checksNumber pointer to variable to receive the number of verified calls (NULL if not needed)
+/// @return number of verified calls whose results did not match within tolerance
+size_t Mat_GetShadowMismatches( size_t* checksNumber );
+
+/// @brief Calculates sum of all given matrix elements, with fixed (pairwise) summation order
+/// @param[in] matrix reference to matrix
+/// @return sum of elements (0.0 on errors)
+double Mat_SumElements( Matrix matrix );
+
+/// @brief Calculates sum of products of corresponding elements of 2 matrices (dot product of vectors), with fixed (pairwise) summation order
+/// @param[in] matrix_1 reference to first matrix
+/// @param[in] matrix_2 reference to second matrix (same dimensions as the first one)
+/// @return inner product value (0.0 on errors)
+double Mat_InnerProduct( Matrix matrix_1, Matrix matrix_2 );
+
+/// @brief Calculates Frobenius (euclidean, for vectors) norm of given matrix, with fixed (pairwise) summation order
+/// @param[in] matrix reference to matrix
+/// @return norm value (0.0 on errors)
+double Mat_Norm( Matrix matrix );
+
 /// @brief Multiply all given matrix elements by a specified value                              
 /// @param[in] matrix reference to matrix to be scaled
 /// @param[in] factor scalar value that multiplies the matrix
@@ -136,6 +374,70 @@ Matrix Mat_Sum( Matrix matrix_1, double weight_1, Matrix matrix_2, double weight
 /// @return reference/pointer to multiplication @a result matrix (NULL on errors)
 Matrix Mat_Dot( Matrix matrix_1, char trans_1, Matrix matrix_2, char trans_2, Matrix result );
 
+/// @brief Performs symmetric rank-k update C = w x op(A) x op(A)^T + w_c x C, computing only one triangle (mirrored to the other one)
+/// @param[in] matrix reference to matrix A
+/// @param[in] transpose defines transformation applied to A (MATRIX_TRANSPOSE for C = A^T x A, MATRIX_KEEP for C = A x A^T)
+/// @param[in] weight weight w of product on sum
+/// @param[in] resultWeight weight w_c of previous result contents on sum (0.0 to ignore them)
+/// @param[in] result preallocated square matrix C to store the update result (must be different from @a matrix)
+/// @return reference/pointer to updated @a result matrix (NULL on errors)
+Matrix Mat_SymmetricRankUpdate( Matrix matrix, char transpose, double weight, double resultWeight, Matrix result );
+
+/// @brief Calculates squared euclidean distances between all pairs of points, as ||x||² + ||y||² - 2 x^T y (single matrix product, half of it for the same point sets)
+/// @param[in] points_1 reference to first points set matrix (dimensions x n, one point per column)
+/// @param[in] points_2 reference to second points set matrix (dimensions x m, one point per column, can be the same as the first one)
+/// @param[in] result preallocated matrix to store the squared distances (nxm dimensions)
+/// @return reference/pointer to distances @a result matrix (NULL on errors or if @a result capacity is smaller than nxm)
+Matrix Mat_PairwiseSqDist( Matrix points_1, Matrix points_2, Matrix result );
+
+/// @brief Calculates kernel (Gram/covariance) matrix between all pairs of points, evaluating kernel function over squared distances in a single pass
+/// @param[in] points_1 reference to first points set matrix (dimensions x n, one point per column)
+/// @param[in] points_2 reference to second points set matrix (dimensions x m, one point per column, can be the same as the first one)
+/// @param[in] kernelType stationary kernel function (MATRIX_KERNEL_GAUSSIAN, MATRIX_KERNEL_MATERN_3_2 or MATRIX_KERNEL_MATERN_5_2)
+/// @param[in] lengthScale (positive) kernel length scale l
+/// @param[in] variance kernel signal variance s² (value for coincident points)
+/// @param[in] result preallocated matrix to store the kernel values (nxm dimensions)
+/// @return reference/pointer to kernel @a result matrix (NULL on errors or if @a result capacity is smaller than nxm)
+Matrix Mat_Kernel( Matrix points_1, Matrix points_2, char kernelType, double lengthScale, double variance, Matrix result );
+
+/// @brief Calculates integer power A^k of given square matrix by binary exponentiation (about 2 log2( k ) products, no allocations)
+/// @param[in] matrix reference to square matrix A
+/// @param[in] exponent non-negative integer power k (0 results in identity)
+/// @param[in] result preallocated matrix to store the power result (can be the same as the input one)
+/// @return reference/pointer to @a result matrix (NULL on errors)
+Matrix Mat_Power( Matrix matrix, size_t exponent, Matrix result );
+
+/// @brief Evaluates matrix polynomial c[ 0 ] x I + c[ 1 ] x A + ... + c[ d ] x A^d by Paterson-Stockmeyer method (about 2 sqrt( d ) products, no allocations)
+/// @param[in] coefficientsList array of polynomial coefficients, in increasing power order
+/// @param[in] coefficientsNumber number of coefficients (polynomial degree + 1)
+/// @param[in] matrix reference to square matrix A
+/// @param[in] result preallocated matrix to store the evaluation result (can be the same as the input one)
+/// @return reference/pointer to @a result matrix (NULL on errors)
+Matrix Mat_Polynomial( double* coefficientsList, size_t coefficientsNumber, Matrix matrix, Matrix result );
+
+/// @brief Calculates running (prefix) sums of given matrix elements along columns or rows
+/// @param[in] matrix reference to matrix
+/// @param[in] axis direction of accumulation (MATRIX_ALONG_COLUMNS or MATRIX_ALONG_ROWS)
+/// @param[in] result preallocated matrix to store the cumulative sums (can be the same as the input one)
+/// @return reference/pointer to @a result matrix (NULL on errors)
+Matrix Mat_CumulativeSum( Matrix matrix, char axis, Matrix result );
+
+/// @brief Calculates cumulative integral of equally spaced samples along columns or rows (first element of each line is 0)
+/// @param[in] matrix reference to matrix of sampled values
+/// @param[in] timeStep interval between consecutive samples
+/// @param[in] rule numerical integration rule (MATRIX_TRAPEZOIDAL_RULE or MATRIX_SIMPSON_RULE)
+/// @param[in] axis direction of integration (MATRIX_ALONG_COLUMNS or MATRIX_ALONG_ROWS)
+/// @param[in] result preallocated matrix to store the integrals (can be the same as the input one)
+/// @return reference/pointer to @a result matrix (NULL on errors)
+Matrix Mat_Integrate( Matrix matrix, double timeStep, char rule, char axis, Matrix result );
+
+/// @brief Calculates differences between consecutive elements along columns or rows (result has 1 less row or column)
+/// @param[in] matrix reference to matrix
+/// @param[in] axis direction of differentiation (MATRIX_ALONG_COLUMNS or MATRIX_ALONG_ROWS)
+/// @param[in] result preallocated matrix to store the differences (can be the same as the input one)
+/// @return reference/pointer to @a result matrix (NULL on errors)
+Matrix Mat_Difference( Matrix matrix, char axis, Matrix result );
+
 /// @brief Calculates determinant of given matrix
 /// @param[in] matrix reference to matrix
 /// @return determinant value (0.0 on errors)
@@ -153,6 +455,223 @@ Matrix Mat_Transpose( Matrix matrix, Matrix result );
 /// @return reference/pointer to inverted @a result matrix (NULL on errors)
 Matrix Mat_Inverse( Matrix matrix, Matrix result );
 
+/// @brief Solves triangular system op(T) x X = B, overwriting B with the solution (no explicit inversion. In-tree kernel for orders up to 8)
+/// @param[in] triangular reference to square triangular matrix T
+/// @param[in] upperLower defines which triangle of T is used (MATRIX_UPPER or MATRIX_LOWER)
+/// @param[in] transpose defines transformation applied to T (MATRIX_TRANSPOSE or MATRIX_KEEP)
+/// @param[in] diagonal defines if T diagonal is considered unitary (MATRIX_UNIT_DIAGONAL or MATRIX_NON_UNIT_DIAGONAL)
+/// @param[in] matrix reference to right-hand side matrix B (same rows number as T), replaced by the solution
+/// @return reference/pointer to solution @a matrix (NULL on errors)
+Matrix Mat_TriangularSolve( Matrix triangular, char upperLower, char transpose, char diagonal, Matrix matrix );
+
+/// @brief Calculates triangular product op(T) x B, overwriting B with the result (In-tree kernel for orders up to 8)
+/// @param[in] triangular reference to square triangular matrix T
+/// @param[in] upperLower defines which triangle of T is used (MATRIX_UPPER or MATRIX_LOWER)
+/// @param[in] transpose defines transformation applied to T (MATRIX_TRANSPOSE or MATRIX_KEEP)
+/// @param[in] diagonal defines if T diagonal is considered unitary (MATRIX_UNIT_DIAGONAL or MATRIX_NON_UNIT_DIAGONAL)
+/// @param[in] matrix reference to matrix B (same rows number as T), replaced by the product
+/// @return reference/pointer to product @a matrix (NULL on errors)
+Matrix Mat_TriangularMultiply( Matrix triangular, char upperLower, char transpose, char diagonal, Matrix matrix );
+
+/// @brief Creates identity permutation (no reordering) of specified size. Applying a permutation p moves source position p[ i ] to position i
+/// @param[in] size number of reordered positions
+/// @return reference/pointer to allocated permutation (NULL on errors or if size is bigger than MATRIX_SIZE_MAX)
+Permutation Mat_CreatePermutation( size_t size );
+
+/// @brief Destroys/deallocates memory of permutation
+/// @param[in] permutation reference to permutation to be destroyed/deallocated
+void Mat_DiscardPermutation( Permutation permutation );
+
+/// @brief Gets number of reordered positions for given permutation
+/// @param[in] permutation reference to permutation
+/// @return permutation size (0 on errors)
+size_t Mat_GetPermutationSize( Permutation permutation );
+
+/// @brief Gets list of source positions of given permutation
+/// @param[in] permutation reference to permutation
+/// @param[out] buffer reference to array (with at least permutation size length) to be filled
+/// @return pointer to filled buffer (NULL on errors)
+size_t* Mat_GetPermutation( Permutation permutation, size_t* buffer );
+
+/// @brief Sets permutation from list of source positions
+/// @param[in] permutation reference to permutation
+/// @param[in] indexesList list (with permutation size length) of source positions, each appearing exactly once
+/// @return reference/pointer to updated permutation (NULL on errors or invalid list)
+Permutation Mat_SetPermutation( Permutation permutation, size_t* indexesList );
+
+/// @brief Composes 2 permutations into one equivalent to applying the first and then the second
+/// @param[in] first reference to first applied permutation
+/// @param[in] second reference to second applied permutation
+/// @param[in] result preallocated permutation to store the composition (can be the same as one of the inputs)
+/// @return reference/pointer to composed @a result permutation (NULL on errors)
+Permutation Mat_ComposePermutations( Permutation first, Permutation second, Permutation result );
+
+/// @brief Calculates permutation that undoes given one
+/// @param[in] permutation reference to permutation to be inverted
+/// @param[in] result preallocated permutation to store the inversion result (can be the same as the input one)
+/// @return reference/pointer to inverted @a result permutation (NULL on errors)
+Permutation Mat_InvertPermutation( Permutation permutation, Permutation result );
+
+/// @brief Reorders rows of given matrix (result row i is source row p[ i ]), without dense permutation matrix products
+/// @param[in] matrix reference to matrix to be reordered
+/// @param[in] permutation reference to permutation with rows number size
+/// @param[in] result preallocated matrix to store the reordering result (can be the same as the input one)
+/// @return reference/pointer to reordered @a result matrix (NULL on errors)
+Matrix Mat_PermuteRows( Matrix matrix, Permutation permutation, Matrix result );
+
+/// @brief Reorders columns of given matrix (result column j is source column p[ j ]), without dense permutation matrix products
+/// @param[in] matrix reference to matrix to be reordered
+/// @param[in] permutation reference to permutation with columns number size
+/// @param[in] result preallocated matrix to store the reordering result (can be the same as the input one)
+/// @return reference/pointer to reordered @a result matrix (NULL on errors)
+Matrix Mat_PermuteColumns( Matrix matrix, Permutation permutation, Matrix result );
+
+/// @brief Calculates LU decomposition with partial pivoting of given matrix, such that rows of the matrix reordered by the permutation equal L x U
+/// @param[in] matrix reference to matrix to be decomposed
+/// @param[out] permutation preallocated permutation (with rows number size) to store the row pivoting (NULL if not needed)
+/// @param[in] result preallocated matrix to store U factor on upper triangle and L factor (unit diagonal omitted) below it (can be the same as the input one)
+/// @return reference/pointer to decomposed @a result matrix (NULL on errors. Singular matrices are decomposed, with zeros on U diagonal)
+Matrix Mat_DecomposeLU( Matrix matrix, Permutation permutation, Matrix result );
+
+/// @brief Calculates Cholesky decomposition L x L^T of given symmetric positive definite matrix (only its lower triangle is accessed)
+/// @param[in] matrix reference to square matrix to be decomposed
+/// @param[in] result preallocated matrix to store lower triangular factor L, with zeroed upper triangle (can be the same as the input one)
+/// @return reference/pointer to factor @a result matrix (NULL on errors or if matrix is not positive definite)
+Matrix Mat_DecomposeCholesky( Matrix matrix, Matrix result );
+
+/// @brief Updates lower Cholesky factor in place to the one of L x L^T + v x v^T, in O(n²) operations (instead of O(n³) refactorization)
+/// @param[in] factor reference to square lower triangular Cholesky factor L, replaced by the updated one
+/// @param[in] vector reference to update vector v (same number of elements as factor rows, not modified)
+/// @return reference/pointer to updated @a factor matrix (NULL on errors)
+Matrix Mat_UpdateCholesky( Matrix factor, Matrix vector );
+
+/// @brief Calculates rank-revealing QR decomposition with column pivoting (A x P = Q x R) of given matrix and estimates its numerical rank
+/// @param[in] matrix reference to (m x n) matrix to be decomposed
+/// @param[in] tolerance relative rank tolerance: diagonal elements of R with |R[ i, i ]| <= tolerance * |R[ 0, 0 ]| are considered null (<= 0.0 for max( m, n ) * machine epsilon)
+/// @param[in] stopEarly true for stopping the (in-tree) decomposition as soon as all remaining columns are below tolerance (trailing block of R is zeroed), false for complete decomposition
+/// @param[out] permutation preallocated permutation (with columns number size) to store the column pivoting (NULL if not needed)
+/// @param[in] result preallocated matrix to store the upper trapezoidal R factor (min( m, n ) x n dimensions. Can be the same as the input one)
+/// @return estimated numerical rank (0 on errors)
+size_t Mat_DecomposeQRPivoted( Matrix matrix, double tolerance, bool stopEarly, Permutation permutation, Matrix result );
+
+/// @brief Calculates basis for the (right) null space of a matrix from its pivoted QR decomposition
+/// @param[in] factor reference to R factor obtained by Mat_DecomposeQRPivoted
+/// @param[in] rank numerical rank obtained by Mat_DecomposeQRPivoted
+/// @param[in] permutation reference to column permutation obtained by Mat_DecomposeQRPivoted
+/// @param[in] result preallocated matrix to store the basis vectors as columns (n x ( n - rank ) dimensions. Must be different from @a factor)
+/// @return reference/pointer to null space basis @a result matrix (NULL on errors)
+Matrix Mat_GetNullSpace( Matrix factor, size_t rank, Permutation permutation, Matrix result );
+
+/// @brief Generates elementary reflector H = I - tau x v x v^T (v[ 0 ] = 1) such that H x [ alpha; x ] = [ beta; 0 ], in place over a single row or column block
+/// @param[in] matrix reference to matrix holding vector [ alpha; x ], replaced by [ beta; v[ 1: ] ]
+/// @param[in] vector single column or single row block of @a matrix with the vector elements
+/// @return scalar factor tau (0.0 if H is identity or on errors)
+double Mat_GenerateHouseholder( Matrix matrix, MatrixBlock vector );
+
+/// @brief Applies elementary reflector H = I - tau x v x v^T to a block of given matrix (from the left: H x B, from the right: B x H)
+/// @param[in] reflector reference to matrix holding reflector vector, as generated by Mat_GenerateHouseholder (first element is taken as 1)
+/// @param[in] vector single column or single row block of @a reflector with vector v
+/// @param[in] tau scalar factor of the reflector
+/// @param[in] side side of application (MATRIX_FROM_LEFT, block rows number equal to v length, or MATRIX_FROM_RIGHT, block columns number equal to v length)
+/// @param[in] matrix reference to matrix to be transformed (can be the same as @a reflector, if blocks do not overlap)
+/// @param[in] target block B of @a matrix to be transformed in place
+/// @return reference/pointer to transformed @a matrix (NULL on errors)
+Matrix Mat_ApplyHouseholder( Matrix reflector, MatrixBlock vector, double tau, char side, Matrix matrix, MatrixBlock target );
+
+/// @brief Applies product of k elementary reflectors H = H_1 x H_2 x ... x H_k (or its transpose) to a block of given matrix at once, 
+/// in compact WY form H = I - V x T x V^T (matrix-matrix products instead of k rank-1 updates)
+/// @param[in] reflectors reference to matrix holding reflector vectors (e.g. QR factorization below-diagonal storage)
+/// @param[in] vectors (n x k) block of @a reflectors whose column i holds v_i from its row i (unit diagonal and elements above it are not accessed)
+/// @param[in] tausList array of k reflector scalar factors
+/// @param[in] side side of application (MATRIX_FROM_LEFT, block rows number n, or MATRIX_FROM_RIGHT, block columns number n)
+/// @param[in] transpose defines transformation applied to H (MATRIX_TRANSPOSE or MATRIX_KEEP)
+/// @param[in] matrix reference to matrix to be transformed (can be the same as @a reflectors, if blocks do not overlap)
+/// @param[in] target block B of @a matrix to be transformed in place
+/// @return reference/pointer to transformed @a matrix (NULL on errors)
+Matrix Mat_ApplyHouseholderBlock( Matrix reflectors, MatrixBlock vectors, double* tausList, char side, char transpose, Matrix matrix, MatrixBlock target );
+
+/// @brief Generates plane (Givens) rotation such that [ c s; -s c ] x [ a; b ] = [ r; 0 ]
+/// @param[in] a first vector element
+/// @param[in] b second vector element, to be annihilated
+/// @param[out] cosine pointer to rotation cosine c
+/// @param[out] sine pointer to rotation sine s
+/// @param[out] radius pointer to resulting first element r (NULL if not needed)
+void Mat_GenerateGivens( double a, double b, double* cosine, double* sine, double* radius );
+
+/// @brief Applies plane rotation to 2 rows (from the left) or 2 columns (from the right) x, y of a block: x = c x + s y, y = c y - s x
+/// @param[in] matrix reference to matrix to be transformed
+/// @param[in] target block of @a matrix to be transformed in place
+/// @param[in] side side of application (MATRIX_FROM_LEFT for rows or MATRIX_FROM_RIGHT for columns)
+/// @param[in] index_1 position of first rotated row/column x, relative to the block
+/// @param[in] index_2 position of second rotated row/column y, relative to the block
+/// @param[in] cosine rotation cosine c
+/// @param[in] sine rotation sine s
+/// @return reference/pointer to transformed @a matrix (NULL on errors)
+Matrix Mat_ApplyGivens( Matrix matrix, MatrixBlock target, char side, size_t index_1, size_t index_2, double cosine, double sine );
+
+/// @brief Applies sequence of plane rotations between consecutive rows (from the left) or columns (from the right) i and i + 1 of a block, in a single pass
+/// @param[in] matrix reference to matrix to be transformed
+/// @param[in] target block of @a matrix to be transformed in place (with r + 1 rows/columns for r rotations)
+/// @param[in] side side of application (MATRIX_FROM_LEFT for rows or MATRIX_FROM_RIGHT for columns)
+/// @param[in] cosinesList array of r rotation cosines (rotation i acts on rows/columns i and i + 1)
+/// @param[in] sinesList array of r rotation sines
+/// @param[in] isBackward false for applying rotations from first to last, true for last to first
+/// @return reference/pointer to transformed @a matrix (NULL on errors)
+Matrix Mat_ApplyGivensSequence( Matrix matrix, MatrixBlock target, char side, double* cosinesList, double* sinesList, bool isBackward );
+
+/// @brief Creates storage (Cholesky factor and preallocated eigensolver workspace) for generalized eigenproblems with mass matrices of specified size
+/// @param[in] size size/order of the mass matrices
+/// @return reference/pointer to allocated factorization (NULL on errors or if size x size is bigger than MATRIX_SIZE_MAX)
+MassFactorization Mat_CreateMassFactorization( size_t size );
+
+/// @brief Destroys/deallocates memory of mass matrix factorization
+/// @param[in] factorization reference to factorization to be destroyed/deallocated
+void Mat_DiscardMassFactorization( MassFactorization factorization );
+
+/// @brief Calculates Cholesky decomposition M = L x L^T of mass matrix, reused by generalized eigenproblems until M changes and is decomposed again
+/// @param[in] mass reference to symmetric positive definite (n x n) matrix M (only lower triangle is used)
+/// @param[in] factorization reference to factorization (with matrix size) to store the result
+/// @return reference/pointer to updated @a factorization (NULL on errors or if M is not positive definite)
+MassFactorization Mat_DecomposeMass( Matrix mass, MassFactorization factorization );
+
+/// @brief Solves symmetric-definite generalized eigenproblem K x v = lambda x M x v (e.g. modal analysis) by Cholesky reduction, without inverting M or allocating
+/// @param[in] stiffness reference to symmetric (n x n) matrix K (only lower triangle is used)
+/// @param[in] mass reference to factorization of mass matrix M, from Mat_DecomposeMass
+/// @param[in] modesNumber number k of lowest eigenvalues/modes to be calculated (0 for all of them)
+/// @param[in] values preallocated matrix to store the eigenvalues in ascending order (k x 1 dimensions)
+/// @param[in] vectors preallocated matrix to store the corresponding M-normalized eigenvectors as columns (n x k dimensions. NULL if not needed)
+/// @return reference/pointer to eigenvalues @a values matrix (NULL on errors or if M was not successfully decomposed)
+Matrix Mat_GeneralizedEigen( Matrix stiffness, MassFactorization mass, size_t modesNumber, Matrix values, Matrix vectors );
+
+/// @brief Creates storage (factors, pivots and preallocated workspace) for LDL^T factorizations of symmetric matrices of specified size
+/// @param[in] size size/order of the decomposed square matrices
+/// @return reference/pointer to allocated factorization (NULL on errors or if size x size is bigger than MATRIX_SIZE_MAX)
+LDLTFactorization Mat_CreateLDLT( size_t size );
+
+/// @brief Destroys/deallocates memory of LDL^T factorization
+/// @param[in] factorization reference to factorization to be destroyed/deallocated
+void Mat_DiscardLDLT( LDLTFactorization factorization );
+
+/// @brief Calculates Bunch-Kaufman LDL^T decomposition of symmetric (possibly indefinite, e.g. KKT) matrix, without allocations (In-tree kernel for orders up to 8)
+/// @param[in] matrix reference to symmetric matrix to be decomposed (only lower triangle is used)
+/// @param[in] factorization reference to factorization (with matrix size) to store the result
+/// @return reference/pointer to updated @a factorization (NULL on errors. Singular matrices are decomposed, but can't be solved)
+LDLTFactorization Mat_DecomposeLDLT( Matrix matrix, LDLTFactorization factorization );
+
+/// @brief Solves linear system A x X = B for previously decomposed symmetric matrix A, overwriting B with the solution
+/// @param[in] factorization reference to LDL^T factorization of A
+/// @param[in] matrix reference to right-hand side matrix B (same rows number as A), replaced by the solution
+/// @return reference/pointer to solution @a matrix (NULL on errors or for singular A)
+Matrix Mat_SolveLDLT( LDLTFactorization factorization, Matrix matrix );
+
+/// @brief Gets inertia (numbers of positive, negative and zero eigenvalues) of previously decomposed symmetric matrix, at no extra cost
+/// @param[in] factorization reference to LDL^T factorization
+/// @param[out] positivesNumber pointer to variable to receive positive eigenvalues number (NULL if not needed)
+/// @param[out] negativesNumber pointer to variable to receive negative eigenvalues number (NULL if not needed)
+/// @param[out] zerosNumber pointer to variable to receive zero eigenvalues number (NULL if not needed)
+/// @return true on success, false on errors
+bool Mat_GetLDLTInertia( LDLTFactorization factorization, size_t* positivesNumber, size_t* negativesNumber, size_t* zerosNumber );
+
 /// @brief Print given matrix element values in a formatted way                             
 /// @param[in] matrix reference to matrix to be displayed
 void Mat_Print( Matrix matrix );
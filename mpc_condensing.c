@@ -0,0 +1,394 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include "mpc_condensing.h"
+
+
+struct _MPCCondensingData
+{
+  size_t statesNumber, inputsNumber, horizonLength;
+  Matrix dynamics, inputGain;
+  Matrix stateWeightRoot, terminalWeightRoot;     // S factors such that Q = S S^T
+  Matrix inputWeight;
+  Matrix inputResponse;                           // [ B; A B; ...; A^(N-1) B ]: first block column of Gamma, which repeats along the diagonals
+  Matrix freeResponse, forcedResponse;            // Phi and Gamma
+  Matrix weightedInputResponse;                   // S^T A^k B blocks
+  Matrix terminalInputResponse;                   // S_N^T A^k B blocks
+  Matrix weightedResponse;                        // Sbar^T Gamma, with Sbar = diag( S, ..., S, S_N )
+  Matrix weightedFreeResponse;                    // Sbar^T Phi
+  Matrix stateHessian;                            // Gamma^T Qbar Gamma
+  Matrix hessian, gradientMatrix;
+  Matrix block, productBlock;
+  size_t* indexesList;                            // 0, 1, 2, ...: offsets in it give contiguous index ranges for block copies
+  bool isModelUpdated, isStateWeightUpdated, isInputWeightUpdated;
+};
+
+
+MPCCondensing MPCCondensing_Create( size_t statesNumber, size_t inputsNumber, size_t horizonLength )
+{
+  if( statesNumber == 0 || inputsNumber == 0 || horizonLength == 0 ) return NULL;
+  
+  size_t predictedStatesNumber = horizonLength * statesNumber, predictedInputsNumber = horizonLength * inputsNumber;
+  if( predictedStatesNumber * predictedInputsNumber > MATRIX_SIZE_MAX || predictedInputsNumber * predictedInputsNumber > MATRIX_SIZE_MAX 
+      || predictedStatesNumber * statesNumber > MATRIX_SIZE_MAX ) return NULL;
+  
+  MPCCondensing newCondensing = (MPCCondensing) calloc( 1, sizeof(MPCCondensingData) );
+  if( newCondensing == NULL ) return NULL;
+  
+  newCondensing->statesNumber = statesNumber;
+  newCondensing->inputsNumber = inputsNumber;
+  newCondensing->horizonLength = horizonLength;
+  
+  size_t blockColumnsNumber = ( statesNumber > inputsNumber ) ? statesNumber : inputsNumber;
+  newCondensing->dynamics = Mat_Create( NULL, statesNumber, statesNumber );
+  newCondensing->inputGain = Mat_Create( NULL, statesNumber, inputsNumber );
+  newCondensing->stateWeightRoot = Mat_Create( NULL, statesNumber, statesNumber );
+  newCondensing->terminalWeightRoot = Mat_Create( NULL, statesNumber, statesNumber );
+  newCondensing->inputWeight = Mat_Create( NULL, inputsNumber, inputsNumber );
+  newCondensing->inputResponse = Mat_Create( NULL, predictedStatesNumber, inputsNumber );
+  newCondensing->freeResponse = Mat_Create( NULL, predictedStatesNumber, statesNumber );
+  newCondensing->forcedResponse = Mat_Create( NULL, predictedStatesNumber, predictedInputsNumber );
+  newCondensing->weightedInputResponse = Mat_Create( NULL, predictedStatesNumber, inputsNumber );
+  newCondensing->terminalInputResponse = Mat_Create( NULL, predictedStatesNumber, inputsNumber );
+  newCondensing->weightedResponse = Mat_Create( NULL, predictedStatesNumber, predictedInputsNumber );
+  newCondensing->weightedFreeResponse = Mat_Create( NULL, predictedStatesNumber, statesNumber );
+  newCondensing->stateHessian = Mat_Create( NULL, predictedInputsNumber, predictedInputsNumber );
+  newCondensing->hessian = Mat_Create( NULL, predictedInputsNumber, predictedInputsNumber );
+  newCondensing->gradientMatrix = Mat_Create( NULL, predictedInputsNumber, statesNumber );
+  newCondensing->block = Mat_Create( NULL, predictedStatesNumber, blockColumnsNumber );
+  newCondensing->productBlock = Mat_Create( NULL, statesNumber, blockColumnsNumber );
+  newCondensing->indexesList = (size_t*) calloc( predictedStatesNumber + predictedInputsNumber, sizeof(size_t) );
+  
+  if( newCondensing->dynamics == NULL || newCondensing->inputGain == NULL || newCondensing->stateWeightRoot == NULL || newCondensing->terminalWeightRoot == NULL 
+      || newCondensing->inputWeight == NULL || newCondensing->inputResponse == NULL || newCondensing->freeResponse == NULL || newCondensing->forcedResponse == NULL 
+      || newCondensing->weightedInputResponse == NULL || newCondensing->terminalInputResponse == NULL || newCondensing->weightedResponse == NULL 
+      || newCondensing->weightedFreeResponse == NULL || newCondensing->stateHessian == NULL || newCondensing->hessian == NULL || newCondensing->gradientMatrix == NULL 
+      || newCondensing->block == NULL || newCondensing->productBlock == NULL || newCondensing->indexesList == NULL )
+  {
+    MPCCondensing_Discard( newCondensing );
+    return NULL;
+  }
+  
+  for( size_t index = 0; index < predictedStatesNumber + predictedInputsNumber; index++ )
+    newCondensing->indexesList[ index ] = index;
+  
+  return newCondensing;
+}
+
+void MPCCondensing_Discard( MPCCondensing condensing )
+{
+  if( condensing == NULL ) return;
+  
+  Mat_Discard( condensing->dynamics );
+  Mat_Discard( condensing->inputGain );
+  Mat_Discard( condensing->stateWeightRoot );
+  Mat_Discard( condensing->terminalWeightRoot );
+  Mat_Discard( condensing->inputWeight );
+  Mat_Discard( condensing->inputResponse );
+  Mat_Discard( condensing->freeResponse );
+  Mat_Discard( condensing->forcedResponse );
+  Mat_Discard( condensing->weightedInputResponse );
+  Mat_Discard( condensing->terminalInputResponse );
+  Mat_Discard( condensing->weightedResponse );
+  Mat_Discard( condensing->weightedFreeResponse );
+  Mat_Discard( condensing->stateHessian );
+  Mat_Discard( condensing->hessian );
+  Mat_Discard( condensing->gradientMatrix );
+  Mat_Discard( condensing->block );
+  Mat_Discard( condensing->productBlock );
+  free( condensing->indexesList );
+  
+  free( condensing );
+}
+
+static bool HasShape( Matrix matrix, size_t rowsNumber, size_t columnsNumber )
+{
+  return ( Mat_GetHeight( matrix ) == rowsNumber && Mat_GetWidth( matrix ) == columnsNumber );
+}
+
+static bool IsSquare( Matrix matrix, size_t size )
+{
+  return HasShape( matrix, size, size );
+}
+
+bool MPCCondensing_SetModel( MPCCondensing condensing, Matrix dynamics, Matrix inputGain )
+{
+  if( condensing == NULL ) return false;
+  
+  if( dynamics != NULL && !IsSquare( dynamics, condensing->statesNumber ) ) return false;
+  if( inputGain != NULL && ( Mat_GetHeight( inputGain ) != condensing->statesNumber || Mat_GetWidth( inputGain ) != condensing->inputsNumber ) ) return false;
+  
+  if( dynamics != NULL ) Mat_Copy( dynamics, condensing->dynamics );
+  if( inputGain != NULL ) Mat_Copy( inputGain, condensing->inputGain );
+  
+  condensing->isModelUpdated = false;
+  
+  return true;
+}
+
+// Square root S = P L of symmetric positive semidefinite weight, from its pivoted (semidefinite) Cholesky decomposition P^T Q P = L L^T:
+// column k of L is stored in original (unpermuted) row order, and columns beyond the weight rank are left zeroed
+static bool GetWeightRoot( MPCCondensing condensing, Matrix weight, Matrix result )
+{
+  double complementArray[ MATRIX_SIZE_MAX ];
+  double rootArray[ MATRIX_SIZE_MAX ];
+  bool isPivotedList[ MATRIX_SIZE_MAX ] = { false };
+  
+  size_t size = condensing->statesNumber;
+  // Symmetric matrix: same layout for row-major and column-major order
+  Mat_GetData( weight, complementArray );
+  memset( rootArray, 0, size * size * sizeof(double) );
+  
+  double largestDiagonal = 0.0;
+  for( size_t index = 0; index < size; index++ )
+    largestDiagonal = fmax( largestDiagonal, fabs( complementArray[ index * size + index ] ) );
+  double pivotTolerance = size * DBL_EPSILON * largestDiagonal;
+  
+  for( size_t column = 0; column < size; column++ )
+  {
+    // Largest remaining diagonal element of the Schur complement as pivot
+    size_t pivot = size;
+    for( size_t index = 0; index < size; index++ )
+    {
+      if( isPivotedList[ index ] ) continue;
+      if( pivot == size || complementArray[ index * size + index ] > complementArray[ pivot * size + pivot ] ) pivot = index;
+    }
+    if( complementArray[ pivot * size + pivot ] <= pivotTolerance ) break;
+    
+    isPivotedList[ pivot ] = true;
+    double pivotRoot = sqrt( complementArray[ pivot * size + pivot ] );
+    for( size_t row = 0; row < size; row++ )
+    {
+      if( row == pivot || !isPivotedList[ row ] ) rootArray[ row * size + column ] = complementArray[ row * size + pivot ] / pivotRoot;
+    }
+    
+    for( size_t row = 0; row < size; row++ )
+    {
+      if( isPivotedList[ row ] ) continue;
+      for( size_t index = 0; index < size; index++ )
+      {
+        if( !isPivotedList[ index ] ) complementArray[ row * size + index ] -= rootArray[ row * size + column ] * rootArray[ index * size + column ];
+      }
+    }
+  }
+  
+  // Remaining complement of a semidefinite weight is negligible, as | a_ij | <= sqrt( a_ii a_jj )
+  for( size_t row = 0; row < size; row++ )
+  {
+    for( size_t index = 0; index < size; index++ )
+    {
+      if( isPivotedList[ row ] || isPivotedList[ index ] ) continue;
+      if( fabs( complementArray[ row * size + index ] ) > sqrt( DBL_EPSILON ) * largestDiagonal ) return false;
+    }
+  }
+  
+  Mat_SetData( result, rootArray );
+  
+  return true;
+}
+
+bool MPCCondensing_SetStateWeights( MPCCondensing condensing, Matrix stateWeight, Matrix terminalWeight )
+{
+  if( condensing == NULL || stateWeight == NULL ) return false;
+  
+  if( !IsSquare( stateWeight, condensing->statesNumber ) ) return false;
+  if( terminalWeight != NULL && !IsSquare( terminalWeight, condensing->statesNumber ) ) return false;
+  
+  if( !GetWeightRoot( condensing, stateWeight, condensing->stateWeightRoot ) ) return false;
+  if( terminalWeight == NULL ) Mat_Copy( condensing->stateWeightRoot, condensing->terminalWeightRoot );
+  else if( !GetWeightRoot( condensing, terminalWeight, condensing->terminalWeightRoot ) ) return false;
+  
+  condensing->isStateWeightUpdated = false;
+  
+  return true;
+}
+
+bool MPCCondensing_SetInputWeight( MPCCondensing condensing, Matrix inputWeight )
+{
+  if( condensing == NULL || inputWeight == NULL ) return false;
+  
+  if( !IsSquare( inputWeight, condensing->inputsNumber ) ) return false;
+  
+  Mat_Copy( inputWeight, condensing->inputWeight );
+  
+  condensing->isInputWeightUpdated = false;
+  
+  return true;
+}
+
+// Copies block between arbitrary positions of 2 matrices
+static void CopyBlock( MPCCondensing condensing, Matrix source, size_t sourceRow, size_t sourceColumn, size_t rowsNumber, size_t columnsNumber, 
+                       Matrix destination, size_t destinationRow, size_t destinationColumn )
+{
+  size_t* indexesList = condensing->indexesList;
+  Mat_Gather( source, indexesList + sourceRow, rowsNumber, indexesList + sourceColumn, columnsNumber, condensing->block );
+  Mat_Scatter( condensing->block, indexesList + destinationRow, indexesList + destinationColumn, destination );
+}
+
+// Stacks products A^k x initial, for k = 0 to N - 1
+static void StackPowers( MPCCondensing condensing, Matrix initial, Matrix result )
+{
+  Mat_Copy( initial, condensing->productBlock );
+  for( size_t step = 0; step < condensing->horizonLength; step++ )
+  {
+    if( step > 0 ) Mat_Dot( condensing->dynamics, MATRIX_KEEP, condensing->productBlock, MATRIX_KEEP, condensing->productBlock );
+    Mat_Scatter( condensing->productBlock, condensing->indexesList + step * condensing->statesNumber, NULL, result );
+  }
+}
+
+// Left multiplies each n rows block of given stack by root^T
+static void WeightBlocks( MPCCondensing condensing, Matrix stack, Matrix root, size_t blocksNumber, Matrix result )
+{
+  size_t statesNumber = condensing->statesNumber, columnsNumber = Mat_GetWidth( stack );
+  for( size_t blockIndex = 0; blockIndex < blocksNumber; blockIndex++ )
+  {
+    Mat_Gather( stack, condensing->indexesList + blockIndex * statesNumber, statesNumber, NULL, columnsNumber, condensing->block );
+    Mat_Dot( root, MATRIX_TRANSPOSE, condensing->block, MATRIX_KEEP, condensing->productBlock );
+    Mat_Scatter( condensing->productBlock, condensing->indexesList + blockIndex * statesNumber, NULL, result );
+  }
+}
+
+static void UpdateModel( MPCCondensing condensing )
+{
+  size_t statesNumber = condensing->statesNumber, inputsNumber = condensing->inputsNumber, horizonLength = condensing->horizonLength;
+  
+  // Each A^k B is computed only once: Gamma diagonals repeat the first block column
+  StackPowers( condensing, condensing->inputGain, condensing->inputResponse );
+  StackPowers( condensing, condensing->dynamics, condensing->freeResponse );
+  
+  Mat_Clear( condensing->forcedResponse );
+  for( size_t blockColumn = 0; blockColumn < horizonLength; blockColumn++ )
+    CopyBlock( condensing, condensing->inputResponse, 0, 0, ( horizonLength - blockColumn ) * statesNumber, inputsNumber, 
+               condensing->forcedResponse, blockColumn * statesNumber, blockColumn * inputsNumber );
+  
+  condensing->isModelUpdated = true;
+}
+
+static void UpdateStateWeights( MPCCondensing condensing )
+{
+  size_t statesNumber = condensing->statesNumber, inputsNumber = condensing->inputsNumber, horizonLength = condensing->horizonLength;
+  
+  WeightBlocks( condensing, condensing->inputResponse, condensing->stateWeightRoot, horizonLength, condensing->weightedInputResponse );
+  WeightBlocks( condensing, condensing->inputResponse, condensing->terminalWeightRoot, horizonLength, condensing->terminalInputResponse );
+  
+  // Same Toeplitz structure for Sbar^T Gamma, except for the terminal blocks row
+  Mat_Clear( condensing->weightedResponse );
+  size_t lastRow = ( horizonLength - 1 ) * statesNumber;
+  for( size_t blockColumn = 0; blockColumn < horizonLength; blockColumn++ )
+  {
+    if( blockColumn < horizonLength - 1 )
+      CopyBlock( condensing, condensing->weightedInputResponse, 0, 0, ( horizonLength - 1 - blockColumn ) * statesNumber, inputsNumber, 
+                 condensing->weightedResponse, blockColumn * statesNumber, blockColumn * inputsNumber );
+    CopyBlock( condensing, condensing->terminalInputResponse, lastRow - blockColumn * statesNumber, 0, statesNumber, inputsNumber, 
+               condensing->weightedResponse, lastRow, blockColumn * inputsNumber );
+  }
+  
+  WeightBlocks( condensing, condensing->freeResponse, condensing->stateWeightRoot, horizonLength - 1, condensing->weightedFreeResponse );
+  Mat_Gather( condensing->freeResponse, condensing->indexesList + lastRow, statesNumber, NULL, statesNumber, condensing->block );
+  Mat_Dot( condensing->terminalWeightRoot, MATRIX_TRANSPOSE, condensing->block, MATRIX_KEEP, condensing->productBlock );
+  Mat_Scatter( condensing->productBlock, condensing->indexesList + lastRow, NULL, condensing->weightedFreeResponse );
+  
+  // Gamma^T Qbar Gamma = ( Sbar^T Gamma )^T ( Sbar^T Gamma ): symmetric by construction
+  Mat_SymmetricRankUpdate( condensing->weightedResponse, MATRIX_TRANSPOSE, 1.0, 0.0, condensing->stateHessian );
+  Mat_Dot( condensing->weightedResponse, MATRIX_TRANSPOSE, condensing->weightedFreeResponse, MATRIX_KEEP, condensing->gradientMatrix );
+  
+  condensing->isStateWeightUpdated = true;
+}
+
+static void UpdateInputWeight( MPCCondensing condensing )
+{
+  size_t inputsNumber = condensing->inputsNumber;
+  
+  Mat_Copy( condensing->stateHessian, condensing->hessian );
+  for( size_t step = 0; step < condensing->horizonLength; step++ )
+  {
+    size_t* blockIndexesList = condensing->indexesList + step * inputsNumber;
+    Mat_ScatterAdd( condensing->inputWeight, blockIndexesList, blockIndexesList, condensing->hessian );
+  }
+  
+  condensing->isInputWeightUpdated = true;
+}
+
+// Recomputes only terms affected by changes since last request
+static void UpdateCondensing( MPCCondensing condensing )
+{
+  if( !condensing->isModelUpdated )
+  {
+    UpdateModel( condensing );
+    condensing->isStateWeightUpdated = false;
+  }
+  
+  if( !condensing->isStateWeightUpdated )
+  {
+    UpdateStateWeights( condensing );
+    condensing->isInputWeightUpdated = false;
+  }
+  
+  if( !condensing->isInputWeightUpdated ) UpdateInputWeight( condensing );
+}
+
+Matrix MPCCondensing_GetHessian( MPCCondensing condensing, Matrix result )
+{
+  if( condensing == NULL || result == NULL ) return NULL;
+  
+  if( !IsSquare( result, condensing->horizonLength * condensing->inputsNumber ) ) return NULL;
+  
+  UpdateCondensing( condensing );
+  
+  return Mat_Copy( condensing->hessian, result );
+}
+
+Matrix MPCCondensing_GetGradientMatrix( MPCCondensing condensing, Matrix result )
+{
+  if( condensing == NULL || result == NULL ) return NULL;
+  
+  if( !HasShape( result, condensing->horizonLength * condensing->inputsNumber, condensing->statesNumber ) ) return NULL;
+  
+  UpdateCondensing( condensing );
+  
+  return Mat_Copy( condensing->gradientMatrix, result );
+}
+
+bool MPCCondensing_GetPrediction( MPCCondensing condensing, Matrix freeResponse, Matrix forcedResponse )
+{
+  if( condensing == NULL ) return false;
+  
+  size_t predictedStatesNumber = condensing->horizonLength * condensing->statesNumber;
+  if( freeResponse != NULL && !HasShape( freeResponse, predictedStatesNumber, condensing->statesNumber ) ) return false;
+  if( forcedResponse != NULL && !HasShape( forcedResponse, predictedStatesNumber, condensing->horizonLength * condensing->inputsNumber ) ) return false;
+  
+  if( !condensing->isModelUpdated ) 
+  {
+    UpdateModel( condensing );
+    condensing->isStateWeightUpdated = false;
+  }
+  
+  if( freeResponse != NULL ) Mat_Copy( condensing->freeResponse, freeResponse );
+  if( forcedResponse != NULL ) Mat_Copy( condensing->forcedResponse, forcedResponse );
+  
+  return true;
+}
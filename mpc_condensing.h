@@ -0,0 +1,86 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file mpc_condensing.h
+/// @brief Condensing of linear model predictive control (MPC) problems into dense quadratic programs, exploiting block-Toeplitz prediction structure
+
+#ifndef MPC_CONDENSING_H
+#define MPC_CONDENSING_H
+
+#include "matrix.h"
+
+typedef struct _MPCCondensingData MPCCondensingData;    ///< MPC condensing internal data structure
+typedef MPCCondensingData* MPCCondensing;               ///< Opaque reference to MPC condensing data structure
+
+
+/// @brief Creates condensing for model x[k+1] = A x[k] + B u[k] over given horizon, where predicted states X = Phi x[0] + Gamma U 
+/// and cost sum_k ( x[k+1]^T Q x[k+1] + u[k]^T R u[k] ) (Q replaced by terminal weight on last step) becomes 0.5 U^T H U + x[0]^T F^T U + constant
+/// @param[in] statesNumber number of model states n
+/// @param[in] inputsNumber number of model inputs m
+/// @param[in] horizonLength number of prediction steps N
+/// @return reference/pointer to allocated condensing data, with zeroed model and weights (NULL on errors or if Nn x Nm, Nm x Nm or Nn x n exceed MATRIX_SIZE_MAX)
+MPCCondensing MPCCondensing_Create( size_t statesNumber, size_t inputsNumber, size_t horizonLength );
+
+/// @brief Destroys/deallocates memory of MPC condensing data
+/// @param[in] condensing reference to condensing data to be destroyed/deallocated
+void MPCCondensing_Discard( MPCCondensing condensing );
+
+/// @brief Sets prediction model matrices (all condensed matrices are recomputed on next request)
+/// @param[in] condensing reference to condensing data
+/// @param[in] dynamics reference to nxn state transition matrix A (NULL keeps current one)
+/// @param[in] inputGain reference to nxm input matrix B (NULL keeps current one)
+/// @return true on success, false on errors
+bool MPCCondensing_SetModel( MPCCondensing condensing, Matrix dynamics, Matrix inputGain );
+
+/// @brief Sets state cost weights (prediction matrices A^k B are not recomputed)
+/// @param[in] condensing reference to condensing data
+/// @param[in] stateWeight reference to nxn symmetric positive semidefinite stage weight Q
+/// @param[in] terminalWeight reference to nxn symmetric positive semidefinite weight of last predicted state (NULL to use Q)
+/// @return true on success, false on errors or indefinite weights
+bool MPCCondensing_SetStateWeights( MPCCondensing condensing, Matrix stateWeight, Matrix terminalWeight );
+
+/// @brief Sets input cost weight (only added to the Hessian diagonal blocks, without recomputing state cost terms)
+/// @param[in] condensing reference to condensing data
+/// @param[in] inputWeight reference to mxm symmetric weight R
+/// @return true on success, false on errors
+bool MPCCondensing_SetInputWeight( MPCCondensing condensing, Matrix inputWeight );
+
+/// @brief Gets condensed cost Hessian H = Gamma^T Qbar Gamma + Rbar, formed with a symmetric rank-k update
+/// @param[in] condensing reference to condensing data
+/// @param[out] result preallocated matrix to store the Hessian (Nm x Nm dimensions)
+/// @return reference/pointer to @a result matrix (NULL on errors or wrong result dimensions)
+Matrix MPCCondensing_GetHessian( MPCCondensing condensing, Matrix result );
+
+/// @brief Gets condensed cost gradient matrix F = Gamma^T Qbar Phi, such that QP linear cost is q = F x[0]
+/// @param[in] condensing reference to condensing data
+/// @param[out] result preallocated matrix to store the gradient matrix (Nm x n dimensions)
+/// @return reference/pointer to @a result matrix (NULL on errors or wrong result dimensions)
+Matrix MPCCondensing_GetGradientMatrix( MPCCondensing condensing, Matrix result );
+
+/// @brief Gets state prediction matrices, stacked for steps 1 to N (e.g. for state constraints)
+/// @param[in] condensing reference to condensing data
+/// @param[out] freeResponse preallocated matrix to store Phi = [ A; A^2; ...; A^N ] (Nn x n dimensions. NULL if not needed)
+/// @param[out] forcedResponse preallocated matrix to store block lower triangular Toeplitz Gamma, with blocks A^(i-j) B (Nn x Nm dimensions. NULL if not needed)
+/// @return true on success, false on errors or wrong matrices dimensions
+bool MPCCondensing_GetPrediction( MPCCondensing condensing, Matrix freeResponse, Matrix forcedResponse );
+
+#endif // MPC_CONDENSING_H
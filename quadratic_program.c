@@ -0,0 +1,526 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include "quadratic_program.h"
+
+
+#define SIGMA_DEFAULT 1e-6                // Proximal regularization, for positive definite KKT system with semidefinite costs
+#define RHO_DEFAULT 0.1
+#define RHO_MIN 1e-6
+#define RHO_MAX 1e6
+#define RHO_EQUALITY_RATIO 1e3            // Stiffer step size for equality rows
+#define RHO_ADAPTATION_RATIO 5.0          // Minimum step size change that justifies a refactorization
+#define RELAXATION_DEFAULT 1.6
+#define TOLERANCE_DEFAULT 1e-4
+#define ITERATIONS_MAX_DEFAULT 4000
+#define CHECK_INTERVAL 5                  // Residuals are evaluated only every few iterations, as they cost extra products
+
+struct _QuadraticProgramData
+{
+  size_t variablesNumber, constraintsNumber;
+  Matrix hessian;
+  Matrix constraints;
+  Matrix scaledConstraints;                       // sqrt(rho) A, for KKT matrix formation
+  Matrix factor;                                  // Cholesky factor of P + sigma I + A^T diag(rho) A + diag(rho_b)
+  Matrix solution, solutionTilde;                 // Column vectors used in products and triangular solves
+  Matrix auxVariables, auxConstraints;
+  // Element-wise updated vectors are kept as raw arrays, sparing per element accessor calls on each iteration
+  double* vectorsBlock;
+  double* gradientList;
+  double* constraintsLowerList, * constraintsUpperList;
+  double* boundsLowerList, * boundsUpperList;
+  double* constraintsRhosList, * boundsRhosList;        // Per row ADMM step sizes
+  double* constraintsValuesList, * constraintsDualsList; // z and y for A x
+  double* boundsValuesList, * boundsDualsList;          // z and y for x
+  double* solutionList, * solutionTildeList;            // Raw copies of primal iterates
+  double* auxVariablesList, * auxConstraintsList, * scalesList;
+  double rho, relaxation;
+  double absoluteTolerance, relativeTolerance;
+  size_t iterationsMax, iterationsNumber;
+  bool isFactorUpdated;
+};
+
+
+QuadraticProgram QuadraticProgram_Create( size_t variablesNumber, size_t constraintsNumber )
+{
+  if( variablesNumber == 0 ) return NULL;
+  
+  if( variablesNumber * variablesNumber > MATRIX_SIZE_MAX || constraintsNumber * variablesNumber > MATRIX_SIZE_MAX ) return NULL;
+  
+  QuadraticProgram newProblem = (QuadraticProgram) calloc( 1, sizeof(QuadraticProgramData) );
+  if( newProblem == NULL ) return NULL;
+  
+  newProblem->variablesNumber = variablesNumber;
+  newProblem->constraintsNumber = constraintsNumber;
+  
+  // Matrices with no constraints still get 1 row of storage, avoiding empty buffers
+  size_t constraintsRowsNumber = ( constraintsNumber > 0 ) ? constraintsNumber : 1;
+  newProblem->hessian = Mat_Create( NULL, variablesNumber, variablesNumber );
+  newProblem->constraints = Mat_Create( NULL, constraintsRowsNumber, variablesNumber );
+  newProblem->scaledConstraints = Mat_Create( NULL, constraintsRowsNumber, variablesNumber );
+  newProblem->factor = Mat_Create( NULL, variablesNumber, variablesNumber );
+  newProblem->solution = Mat_Create( NULL, variablesNumber, 1 );
+  newProblem->solutionTilde = Mat_Create( NULL, variablesNumber, 1 );
+  newProblem->auxVariables = Mat_Create( NULL, variablesNumber, 1 );
+  newProblem->auxConstraints = Mat_Create( NULL, constraintsRowsNumber, 1 );
+  // Single block for all raw vectors: 10 with variables length and 7 with constraints length
+  newProblem->vectorsBlock = (double*) calloc( 10 * variablesNumber + 7 * constraintsRowsNumber, sizeof(double) );
+  
+  if( newProblem->hessian == NULL || newProblem->constraints == NULL || newProblem->scaledConstraints == NULL || newProblem->factor == NULL 
+      || newProblem->solution == NULL || newProblem->solutionTilde == NULL || newProblem->auxVariables == NULL || newProblem->auxConstraints == NULL 
+      || newProblem->vectorsBlock == NULL )
+  {
+    QuadraticProgram_Discard( newProblem );
+    return NULL;
+  }
+  
+  double* vectorsList = newProblem->vectorsBlock;
+  newProblem->gradientList = vectorsList; vectorsList += variablesNumber;
+  newProblem->boundsLowerList = vectorsList; vectorsList += variablesNumber;
+  newProblem->boundsUpperList = vectorsList; vectorsList += variablesNumber;
+  newProblem->boundsRhosList = vectorsList; vectorsList += variablesNumber;
+  newProblem->boundsValuesList = vectorsList; vectorsList += variablesNumber;
+  newProblem->boundsDualsList = vectorsList; vectorsList += variablesNumber;
+  newProblem->solutionList = vectorsList; vectorsList += variablesNumber;
+  newProblem->solutionTildeList = vectorsList; vectorsList += variablesNumber;
+  newProblem->auxVariablesList = vectorsList; vectorsList += 2 * variablesNumber;   // Also used as 2 variables length buffers for limits updates
+  newProblem->constraintsLowerList = vectorsList; vectorsList += constraintsRowsNumber;
+  newProblem->constraintsUpperList = vectorsList; vectorsList += constraintsRowsNumber;
+  newProblem->constraintsRhosList = vectorsList; vectorsList += constraintsRowsNumber;
+  newProblem->constraintsValuesList = vectorsList; vectorsList += constraintsRowsNumber;
+  newProblem->constraintsDualsList = vectorsList; vectorsList += constraintsRowsNumber;
+  newProblem->auxConstraintsList = vectorsList; vectorsList += constraintsRowsNumber;
+  newProblem->scalesList = vectorsList;
+  
+  for( size_t row = 0; row < constraintsNumber; row++ )
+  {
+    newProblem->constraintsLowerList[ row ] = -INFINITY;
+    newProblem->constraintsUpperList[ row ] = INFINITY;
+  }
+  for( size_t variable = 0; variable < variablesNumber; variable++ )
+  {
+    newProblem->boundsLowerList[ variable ] = -INFINITY;
+    newProblem->boundsUpperList[ variable ] = INFINITY;
+  }
+  
+  QuadraticProgram_SetSettings( newProblem, RHO_DEFAULT, RELAXATION_DEFAULT, TOLERANCE_DEFAULT, TOLERANCE_DEFAULT, ITERATIONS_MAX_DEFAULT );
+  
+  return newProblem;
+}
+
+void QuadraticProgram_Discard( QuadraticProgram problem )
+{
+  if( problem == NULL ) return;
+  
+  Mat_Discard( problem->hessian );
+  Mat_Discard( problem->constraints );
+  Mat_Discard( problem->scaledConstraints );
+  Mat_Discard( problem->factor );
+  Mat_Discard( problem->solution );
+  Mat_Discard( problem->solutionTilde );
+  Mat_Discard( problem->auxVariables );
+  Mat_Discard( problem->auxConstraints );
+  free( problem->vectorsBlock );
+  
+  free( problem );
+}
+
+// Per row step sizes: equality rows get a stiffer one, free rows (no finite limit) the minimum one
+static void UpdateRhos( double* rhosList, double* lowerList, double* upperList, size_t rowsNumber, double rho )
+{
+  for( size_t row = 0; row < rowsNumber; row++ )
+  {
+    double rowRho = rho;
+    if( lowerList[ row ] == upperList[ row ] ) rowRho = RHO_EQUALITY_RATIO * rho;
+    else if( isinf( lowerList[ row ] ) && isinf( upperList[ row ] ) ) rowRho = RHO_MIN;
+    rhosList[ row ] = rowRho;
+  }
+}
+
+static void SetRho( QuadraticProgram problem, double rho )
+{
+  problem->rho = rho;
+  UpdateRhos( problem->constraintsRhosList, problem->constraintsLowerList, problem->constraintsUpperList, problem->constraintsNumber, rho );
+  UpdateRhos( problem->boundsRhosList, problem->boundsLowerList, problem->boundsUpperList, problem->variablesNumber, rho );
+  problem->isFactorUpdated = false;
+}
+
+bool QuadraticProgram_SetSettings( QuadraticProgram problem, double rho, double relaxation, double absoluteTolerance, double relativeTolerance, size_t iterationsMax )
+{
+  if( problem == NULL ) return false;
+  
+  if( rho <= 0.0 || relaxation <= 0.0 || relaxation >= 2.0 || absoluteTolerance < 0.0 || relativeTolerance < 0.0 || iterationsMax == 0 ) return false;
+  
+  problem->relaxation = relaxation;
+  problem->absoluteTolerance = absoluteTolerance;
+  problem->relativeTolerance = relativeTolerance;
+  problem->iterationsMax = iterationsMax;
+  SetRho( problem, rho );
+  
+  return true;
+}
+
+static bool IsVector( Matrix vector, size_t length )
+{
+  return ( vector != NULL && Mat_GetHeight( vector ) * Mat_GetWidth( vector ) == length );
+}
+
+static double ClipValue( double value, double lower, double upper )
+{
+  if( value < lower ) return lower;
+  if( value > upper ) return upper;
+  return value;
+}
+
+bool QuadraticProgram_SetCost( QuadraticProgram problem, Matrix hessian, Matrix gradient )
+{
+  if( problem == NULL ) return false;
+  
+  size_t variablesNumber = problem->variablesNumber;
+  if( hessian != NULL && ( Mat_GetHeight( hessian ) != variablesNumber || Mat_GetWidth( hessian ) != variablesNumber ) ) return false;
+  if( gradient != NULL && !IsVector( gradient, variablesNumber ) ) return false;
+  
+  if( hessian != NULL )
+  {
+    Mat_Copy( hessian, problem->hessian );
+    problem->isFactorUpdated = false;
+  }
+  
+  // Row and column vectors share the same raw data order
+  if( gradient != NULL ) Mat_GetData( gradient, problem->gradientList );
+  
+  return true;
+}
+
+// New limits are read into the given buffers, and only stored if consistent
+static bool SetLimits( double* lowerList, double* upperList, Matrix newLower, Matrix newUpper, size_t length, double* lowerBuffer, double* upperBuffer )
+{
+  if( newLower != NULL && !IsVector( newLower, length ) ) return false;
+  if( newUpper != NULL && !IsVector( newUpper, length ) ) return false;
+  
+  double* newLowerList = ( newLower != NULL ) ? Mat_GetData( newLower, lowerBuffer ) : lowerList;
+  double* newUpperList = ( newUpper != NULL ) ? Mat_GetData( newUpper, upperBuffer ) : upperList;
+  
+  for( size_t index = 0; index < length; index++ )
+  {
+    if( newLowerList[ index ] > newUpperList[ index ] ) return false;
+  }
+  
+  memcpy( lowerList, newLowerList, length * sizeof(double) );
+  memcpy( upperList, newUpperList, length * sizeof(double) );
+  
+  return true;
+}
+
+// Limits changes only require refactorization if rows switch between equality, inequality or free types
+static void UpdateLimitsRhos( QuadraticProgram problem )
+{
+  double* constraintsRhosList = problem->auxConstraintsList;
+  double* boundsRhosList = problem->auxVariablesList;
+  
+  memcpy( constraintsRhosList, problem->constraintsRhosList, problem->constraintsNumber * sizeof(double) );
+  memcpy( boundsRhosList, problem->boundsRhosList, problem->variablesNumber * sizeof(double) );
+  bool isFactorUpdated = problem->isFactorUpdated;
+  
+  SetRho( problem, problem->rho );
+  
+  if( memcmp( constraintsRhosList, problem->constraintsRhosList, problem->constraintsNumber * sizeof(double) ) != 0 ) isFactorUpdated = false;
+  if( memcmp( boundsRhosList, problem->boundsRhosList, problem->variablesNumber * sizeof(double) ) != 0 ) isFactorUpdated = false;
+  
+  problem->isFactorUpdated = isFactorUpdated;
+}
+
+bool QuadraticProgram_SetConstraints( QuadraticProgram problem, Matrix constraints, Matrix lower, Matrix upper )
+{
+  if( problem == NULL ) return false;
+  
+  if( constraints != NULL && ( Mat_GetHeight( constraints ) != problem->constraintsNumber || Mat_GetWidth( constraints ) != problem->variablesNumber ) ) return false;
+  
+  if( !SetLimits( problem->constraintsLowerList, problem->constraintsUpperList, lower, upper, problem->constraintsNumber, 
+                  problem->auxConstraintsList, problem->scalesList ) ) return false;
+  
+  UpdateLimitsRhos( problem );
+  
+  if( constraints != NULL && problem->constraintsNumber > 0 )
+  {
+    Mat_Copy( constraints, problem->constraints );
+    problem->isFactorUpdated = false;
+  }
+  
+  return true;
+}
+
+bool QuadraticProgram_SetBounds( QuadraticProgram problem, Matrix lower, Matrix upper )
+{
+  if( problem == NULL ) return false;
+  
+  if( !SetLimits( problem->boundsLowerList, problem->boundsUpperList, lower, upper, problem->variablesNumber, 
+                  problem->auxVariablesList, problem->auxVariablesList + problem->variablesNumber ) ) return false;
+  
+  UpdateLimitsRhos( problem );
+  
+  return true;
+}
+
+// Constraint values consistent with current primal point: projection of A x and x over their limits
+static void ProjectSolution( QuadraticProgram problem )
+{
+  if( problem->constraintsNumber > 0 )
+  {
+    Mat_Dot( problem->constraints, MATRIX_KEEP, problem->solution, MATRIX_KEEP, problem->auxConstraints );
+    double* productList = Mat_GetColumn( problem->auxConstraints, 0, problem->auxConstraintsList );
+    for( size_t row = 0; row < problem->constraintsNumber; row++ )
+      problem->constraintsValuesList[ row ] = ClipValue( productList[ row ], problem->constraintsLowerList[ row ], problem->constraintsUpperList[ row ] );
+  }
+  
+  double* solutionList = Mat_GetColumn( problem->solution, 0, problem->solutionList );
+  for( size_t variable = 0; variable < problem->variablesNumber; variable++ )
+    problem->boundsValuesList[ variable ] = ClipValue( solutionList[ variable ], problem->boundsLowerList[ variable ], problem->boundsUpperList[ variable ] );
+}
+
+bool QuadraticProgram_SetInitialGuess( QuadraticProgram problem, Matrix solution )
+{
+  if( problem == NULL ) return false;
+  
+  if( !IsVector( solution, problem->variablesNumber ) ) return false;
+  
+  Mat_SetColumn( problem->solution, 0, Mat_GetData( solution, problem->solutionList ) );
+  ProjectSolution( problem );
+  
+  return true;
+}
+
+void QuadraticProgram_Reset( QuadraticProgram problem )
+{
+  if( problem == NULL ) return;
+  
+  Mat_Clear( problem->solution );
+  memset( problem->constraintsDualsList, 0, problem->constraintsNumber * sizeof(double) );
+  memset( problem->boundsDualsList, 0, problem->variablesNumber * sizeof(double) );
+  ProjectSolution( problem );
+}
+
+// KKT system reduced to primal variables: ( P + sigma I + A^T diag(rho) A + diag(rho_b) ) x = rhs
+static bool UpdateFactor( QuadraticProgram problem )
+{
+  size_t variablesNumber = problem->variablesNumber, constraintsNumber = problem->constraintsNumber;
+  
+  // Scaling and diagonal terms are applied over whole (contiguous) columns
+  double* columnList = problem->solutionTildeList;
+  double* hessianColumnList = problem->auxVariablesList;
+  if( constraintsNumber > 0 )
+  {
+    double* constraintsColumnList = problem->auxConstraintsList;
+    for( size_t row = 0; row < constraintsNumber; row++ )
+      problem->scalesList[ row ] = sqrt( problem->constraintsRhosList[ row ] );
+    for( size_t column = 0; column < variablesNumber; column++ )
+    {
+      Mat_GetColumn( problem->constraints, column, constraintsColumnList );
+      for( size_t row = 0; row < constraintsNumber; row++ )
+        constraintsColumnList[ row ] *= problem->scalesList[ row ];
+      Mat_SetColumn( problem->scaledConstraints, column, constraintsColumnList );
+    }
+    Mat_Dot( problem->scaledConstraints, MATRIX_TRANSPOSE, problem->scaledConstraints, MATRIX_KEEP, problem->factor );
+  }
+  else Mat_Clear( problem->factor );
+  
+  for( size_t column = 0; column < variablesNumber; column++ )
+  {
+    Mat_GetColumn( problem->factor, column, columnList );
+    Mat_GetColumn( problem->hessian, column, hessianColumnList );
+    for( size_t row = 0; row < variablesNumber; row++ )
+      columnList[ row ] += hessianColumnList[ row ];
+    columnList[ column ] += SIGMA_DEFAULT + problem->boundsRhosList[ column ];
+    Mat_SetColumn( problem->factor, column, columnList );
+  }
+  
+  problem->isFactorUpdated = ( Mat_DecomposeCholesky( problem->factor, problem->factor ) != NULL );
+  
+  return problem->isFactorUpdated;
+}
+
+// Relaxed update of constraint values (projected over limits) and their duals, for one group of rows
+static void UpdateConstraints( double* valuesTildeList, double* valuesList, double* dualsList, double* rhosList, double* lowerList, double* upperList, 
+                               size_t length, double relaxation )
+{
+  for( size_t row = 0; row < length; row++ )
+  {
+    double relaxedValue = relaxation * valuesTildeList[ row ] + ( 1.0 - relaxation ) * valuesList[ row ];
+    double value = ClipValue( relaxedValue + dualsList[ row ] / rhosList[ row ], lowerList[ row ], upperList[ row ] );
+    dualsList[ row ] += rhosList[ row ] * ( relaxedValue - value );
+    valuesList[ row ] = value;
+  }
+}
+
+static void IterateADMM( QuadraticProgram problem )
+{
+  size_t variablesNumber = problem->variablesNumber, constraintsNumber = problem->constraintsNumber;
+  double relaxation = problem->relaxation;
+  double* solutionList = problem->solutionList;
+  double* solutionTildeList = problem->solutionTildeList;
+  double* auxConstraintsList = problem->auxConstraintsList;
+  
+  // Right-hand side: sigma x - q + A^T ( rho z - y ) + rho_b z_b - y_b
+  if( constraintsNumber > 0 )
+  {
+    for( size_t row = 0; row < constraintsNumber; row++ )
+      auxConstraintsList[ row ] = problem->constraintsRhosList[ row ] * problem->constraintsValuesList[ row ] - problem->constraintsDualsList[ row ];
+    Mat_SetColumn( problem->auxConstraints, 0, auxConstraintsList );
+    Mat_Dot( problem->constraints, MATRIX_TRANSPOSE, problem->auxConstraints, MATRIX_KEEP, problem->solutionTilde );
+    Mat_GetColumn( problem->solutionTilde, 0, solutionTildeList );
+  }
+  else memset( solutionTildeList, 0, variablesNumber * sizeof(double) );
+  
+  Mat_GetColumn( problem->solution, 0, solutionList );
+  for( size_t variable = 0; variable < variablesNumber; variable++ )
+  {
+    solutionTildeList[ variable ] += SIGMA_DEFAULT * solutionList[ variable ] - problem->gradientList[ variable ] 
+                                     + problem->boundsRhosList[ variable ] * problem->boundsValuesList[ variable ] - problem->boundsDualsList[ variable ];
+  }
+  Mat_SetColumn( problem->solutionTilde, 0, solutionTildeList );
+  
+  Mat_TriangularSolve( problem->factor, MATRIX_LOWER, MATRIX_KEEP, MATRIX_NON_UNIT_DIAGONAL, problem->solutionTilde );
+  Mat_TriangularSolve( problem->factor, MATRIX_LOWER, MATRIX_TRANSPOSE, MATRIX_NON_UNIT_DIAGONAL, problem->solutionTilde );
+  Mat_GetColumn( problem->solutionTilde, 0, solutionTildeList );
+  
+  if( constraintsNumber > 0 )
+  {
+    Mat_Dot( problem->constraints, MATRIX_KEEP, problem->solutionTilde, MATRIX_KEEP, problem->auxConstraints );
+    UpdateConstraints( Mat_GetColumn( problem->auxConstraints, 0, auxConstraintsList ), problem->constraintsValuesList, problem->constraintsDualsList, 
+                       problem->constraintsRhosList, problem->constraintsLowerList, problem->constraintsUpperList, constraintsNumber, relaxation );
+  }
+  UpdateConstraints( solutionTildeList, problem->boundsValuesList, problem->boundsDualsList, problem->boundsRhosList, 
+                     problem->boundsLowerList, problem->boundsUpperList, variablesNumber, relaxation );
+  
+  for( size_t variable = 0; variable < variablesNumber; variable++ )
+    solutionList[ variable ] = relaxation * solutionTildeList[ variable ] + ( 1.0 - relaxation ) * solutionList[ variable ];
+  Mat_SetColumn( problem->solution, 0, solutionList );
+}
+
+// Scaled primal and dual residuals (OSQP criteria). Returns true on convergence, otherwise proposes a balancing step size
+static bool CheckResiduals( QuadraticProgram problem, double* newRho )
+{
+  size_t variablesNumber = problem->variablesNumber, constraintsNumber = problem->constraintsNumber;
+  double* solutionList = Mat_GetColumn( problem->solution, 0, problem->solutionList );
+  
+  // Primal: A x - z and x - z_b
+  double primalResidual = 0.0, primalScale = 0.0;
+  if( constraintsNumber > 0 )
+  {
+    Mat_Dot( problem->constraints, MATRIX_KEEP, problem->solution, MATRIX_KEEP, problem->auxConstraints );
+    double* productList = Mat_GetColumn( problem->auxConstraints, 0, problem->auxConstraintsList );
+    for( size_t row = 0; row < constraintsNumber; row++ )
+    {
+      double value = problem->constraintsValuesList[ row ];
+      primalScale = fmax( primalScale, fmax( fabs( productList[ row ] ), fabs( value ) ) );
+      primalResidual = fmax( primalResidual, fabs( productList[ row ] - value ) );
+    }
+  }
+  for( size_t variable = 0; variable < variablesNumber; variable++ )
+  {
+    double value = problem->boundsValuesList[ variable ];
+    primalScale = fmax( primalScale, fmax( fabs( solutionList[ variable ] ), fabs( value ) ) );
+    primalResidual = fmax( primalResidual, fabs( solutionList[ variable ] - value ) );
+  }
+  
+  // Dual: P x + q + A^T y + y_b (solutionTilde is free until next iteration)
+  double* hessianProductList = problem->auxVariablesList;
+  double* constraintsProductList = problem->solutionTildeList;
+  Mat_Dot( problem->hessian, MATRIX_KEEP, problem->solution, MATRIX_KEEP, problem->auxVariables );
+  Mat_GetColumn( problem->auxVariables, 0, hessianProductList );
+  if( constraintsNumber > 0 )
+  {
+    Mat_SetColumn( problem->auxConstraints, 0, problem->constraintsDualsList );
+    Mat_Dot( problem->constraints, MATRIX_TRANSPOSE, problem->auxConstraints, MATRIX_KEEP, problem->solutionTilde );
+    Mat_GetColumn( problem->solutionTilde, 0, constraintsProductList );
+  }
+  else memset( constraintsProductList, 0, variablesNumber * sizeof(double) );
+  double dualResidual = 0.0, dualScale = 0.0;
+  for( size_t variable = 0; variable < variablesNumber; variable++ )
+  {
+    double gradient = problem->gradientList[ variable ], boundsDual = problem->boundsDualsList[ variable ];
+    dualScale = fmax( dualScale, fmax( fmax( fabs( hessianProductList[ variable ] ), fabs( gradient ) ), 
+                                       fmax( fabs( boundsDual ), fabs( constraintsProductList[ variable ] ) ) ) );
+    dualResidual = fmax( dualResidual, fabs( hessianProductList[ variable ] + gradient + boundsDual + constraintsProductList[ variable ] ) );
+  }
+  
+  bool isPrimalConverged = ( primalResidual <= problem->absoluteTolerance + problem->relativeTolerance * primalScale );
+  bool isDualConverged = ( dualResidual <= problem->absoluteTolerance + problem->relativeTolerance * dualScale );
+  if( isPrimalConverged && isDualConverged ) return true;
+  
+  double normalizedPrimal = primalResidual / fmax( primalScale, DBL_MIN );
+  double normalizedDual = dualResidual / fmax( dualScale, DBL_MIN );
+  *newRho = ClipValue( problem->rho * sqrt( normalizedPrimal / fmax( normalizedDual, DBL_MIN ) ), RHO_MIN, RHO_MAX );
+  
+  return false;
+}
+
+bool QuadraticProgram_Solve( QuadraticProgram problem, Matrix solution )
+{
+  if( problem == NULL || solution == NULL ) return false;
+  
+  if( !IsVector( solution, problem->variablesNumber ) ) return false;
+  
+  problem->iterationsNumber = 0;
+  
+  if( !problem->isFactorUpdated )
+  {
+    if( !UpdateFactor( problem ) ) return false;
+  }
+  
+  bool isConverged = false;
+  while( !isConverged && problem->iterationsNumber < problem->iterationsMax )
+  {
+    IterateADMM( problem );
+    problem->iterationsNumber++;
+    
+    if( problem->iterationsNumber % CHECK_INTERVAL == 0 || problem->iterationsNumber == problem->iterationsMax )
+    {
+      double newRho = problem->rho;
+      isConverged = CheckResiduals( problem, &newRho );
+      // Only large step size imbalances are worth a new factorization
+      if( !isConverged && ( newRho > RHO_ADAPTATION_RATIO * problem->rho || newRho < problem->rho / RHO_ADAPTATION_RATIO ) )
+      {
+        SetRho( problem, newRho );
+        if( !UpdateFactor( problem ) ) return false;
+      }
+    }
+  }
+  
+  // Row and column vectors share the same raw data order, so the caller vector is not reshaped
+  Mat_SetData( solution, Mat_GetColumn( problem->solution, 0, problem->solutionList ) );
+  
+  return isConverged;
+}
+
+size_t QuadraticProgram_GetIterationsNumber( QuadraticProgram problem )
+{
+  if( problem == NULL ) return 0;
+  
+  return problem->iterationsNumber;
+}
@@ -0,0 +1,98 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file quadratic_program.h
+/// @brief Allocation-free dense convex quadratic program solver (ADMM operator splitting, OSQP-like), for repeated solves of small problems (e.g. MPC)
+
+#ifndef QUADRATIC_PROGRAM_H
+#define QUADRATIC_PROGRAM_H
+
+#include "matrix.h"
+
+typedef struct _QuadraticProgramData QuadraticProgramData;    ///< Quadratic program internal data structure
+typedef QuadraticProgramData* QuadraticProgram;               ///< Opaque reference to quadratic program data structure
+
+
+/// @brief Creates quadratic program minimize 0.5 x^T P x + q^T x, subject to l <= A x <= u and lb <= x <= ub, allocating all solver workspace
+/// @param[in] variablesNumber number of optimization variables n
+/// @param[in] constraintsNumber number of linear constraints m (rows of A. Can be 0)
+/// @return reference/pointer to allocated quadratic program, with zeroed cost and unbounded constraints (NULL on errors or if n x n or m x n exceed MATRIX_SIZE_MAX)
+QuadraticProgram QuadraticProgram_Create( size_t variablesNumber, size_t constraintsNumber );
+
+/// @brief Destroys/deallocates memory of quadratic program
+/// @param[in] problem reference to quadratic program to be destroyed/deallocated
+void QuadraticProgram_Discard( QuadraticProgram problem );
+
+/// @brief Defines solver parameters (defaults: rho = 0.1, relaxation = 1.6, tolerances = 1e-4, 4000 iterations)
+/// @param[in] problem reference to quadratic program
+/// @param[in] rho initial (positive) ADMM step size, adapted during solution
+/// @param[in] relaxation over-relaxation factor (between 0 and 2)
+/// @param[in] absoluteTolerance absolute residuals tolerance for convergence
+/// @param[in] relativeTolerance relative residuals tolerance for convergence
+/// @param[in] iterationsMax maximum number of iterations per solve
+/// @return true on success, false on errors or invalid parameters
+bool QuadraticProgram_SetSettings( QuadraticProgram problem, double rho, double relaxation, double absoluteTolerance, double relativeTolerance, size_t iterationsMax );
+
+/// @brief Sets quadratic cost terms. Changing the Hessian requires a refactorization on next solve, changing only the gradient does not
+/// @param[in] problem reference to quadratic program
+/// @param[in] hessian reference to symmetric positive semidefinite nxn matrix P (NULL keeps current one)
+/// @param[in] gradient reference to linear cost vector q, with n elements (NULL keeps current one)
+/// @return true on success, false on errors
+bool QuadraticProgram_SetCost( QuadraticProgram problem, Matrix hessian, Matrix gradient );
+
+/// @brief Sets linear constraints l <= A x <= u (rows with l = u are treated as equalities). Changing A requires a refactorization on next solve
+/// @param[in] problem reference to quadratic program
+/// @param[in] constraints reference to mxn constraints matrix A (NULL keeps current one)
+/// @param[in] lower reference to lower limits vector l, with m elements (may contain -INFINITY. NULL keeps current one)
+/// @param[in] upper reference to upper limits vector u, with m elements (may contain INFINITY. NULL keeps current one)
+/// @return true on success, false on errors or crossed limits
+bool QuadraticProgram_SetConstraints( QuadraticProgram problem, Matrix constraints, Matrix lower, Matrix upper );
+
+/// @brief Sets box constraints (bounds) lb <= x <= ub on variables
+/// @param[in] problem reference to quadratic program
+/// @param[in] lower reference to lower bounds vector lb, with n elements (may contain -INFINITY. NULL keeps current one)
+/// @param[in] upper reference to upper bounds vector ub, with n elements (may contain INFINITY. NULL keeps current one)
+/// @return true on success, false on errors or crossed limits
+bool QuadraticProgram_SetBounds( QuadraticProgram problem, Matrix lower, Matrix upper );
+
+/// @brief Defines starting primal point for next solve (otherwise, the last solution and its dual variables are reused as warm start)
+/// @param[in] problem reference to quadratic program
+/// @param[in] solution reference to initial guess vector, with n elements
+/// @return true on success, false on errors
+bool QuadraticProgram_SetInitialGuess( QuadraticProgram problem, Matrix solution );
+
+/// @brief Clears stored primal and dual variables, for a cold start on next solve
+/// @param[in] problem reference to quadratic program
+void QuadraticProgram_Reset( QuadraticProgram problem );
+
+/// @brief Solves quadratic program, without allocations (KKT factorization is only recomputed when problem matrices or step size change)
+/// @param[in] problem reference to quadratic program
+/// @param[out] solution preallocated vector to store the solution (n elements. Last iterate when not converged)
+/// @return true if converged within the iterations limit, false otherwise or on errors
+bool QuadraticProgram_Solve( QuadraticProgram problem, Matrix solution );
+
+/// @brief Gets number of iterations performed on last solve
+/// @param[in] problem reference to quadratic program
+/// @return iterations number (0 on errors)
+size_t QuadraticProgram_GetIterationsNumber( QuadraticProgram problem );
+
+#endif // QUADRATIC_PROGRAM_H
@@ -0,0 +1,500 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include "structured_matrix.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+
+struct _StructuredMatrixData
+{
+  char structure;
+  size_t rowsNumber, columnsNumber;
+  double* valuesList;                         // Generating sequence s (m + n - 1): A[ i ][ j ] = s[ n - 1 + i - j ] (Toeplitz/circulant) or s[ i + j ] (Hankel)
+  size_t transformLength;                     // Power of 2 FFT length L >= m + n - 1, so that circular convolutions do not alias
+  double* cosinesList;                        // Twiddle factors cos( 2 pi k / L ), for k < L/2
+  double* sinesList;
+  double* spectrumReal;                       // FFT of zero padded generating sequence
+  double* spectrumImag;
+  double* workReal;                           // FFT buffers (L)
+  double* workImag;
+  double* chirpReal;                          // Circulant only: Bluestein chirp w[ j ] = exp( i pi j² / n )
+  double* chirpImag;
+  double* chirpSpectrumReal;                  // Circulant only: FFT of chirp convolution kernel
+  double* chirpSpectrumImag;
+  double* eigenvaluesReal;                    // Circulant only: eigenvalues (size n DFT of first column)
+  double* eigenvaluesImag;
+  double* forwardArray;                       // Levinson recursion forward/backward vectors
+  double* backwardArray;
+  double* columnArray;                        // Current input/output column
+  double* resultArray;
+};
+
+
+// Iterative radix-2 (Cooley-Tukey) FFT in place, over precomputed twiddle factors (inverse transform is not scaled)
+static void TransformFourier( StructuredMatrix matrix, double* real, double* imag, bool isInverse )
+{
+  size_t length = matrix->transformLength;
+  
+  for( size_t index = 1, reversedIndex = 0; index < length; index++ )
+  {
+    size_t bit = length >> 1;
+    for( ; reversedIndex & bit; bit >>= 1 )
+      reversedIndex ^= bit;
+    reversedIndex ^= bit;
+    
+    if( index < reversedIndex )
+    {
+      double swapReal = real[ index ], swapImag = imag[ index ];
+      real[ index ] = real[ reversedIndex ]; imag[ index ] = imag[ reversedIndex ];
+      real[ reversedIndex ] = swapReal; imag[ reversedIndex ] = swapImag;
+    }
+  }
+  
+  for( size_t halfSize = 1; halfSize < length; halfSize *= 2 )
+  {
+    size_t twiddleStep = length / ( 2 * halfSize );
+    for( size_t start = 0; start < length; start += 2 * halfSize )
+    {
+      for( size_t offset = 0; offset < halfSize; offset++ )
+      {
+        double cosine = matrix->cosinesList[ offset * twiddleStep ];
+        double sine = isInverse ? matrix->sinesList[ offset * twiddleStep ] : -matrix->sinesList[ offset * twiddleStep ];
+        size_t evenIndex = start + offset, oddIndex = evenIndex + halfSize;
+        double oddReal = real[ oddIndex ] * cosine - imag[ oddIndex ] * sine;
+        double oddImag = real[ oddIndex ] * sine + imag[ oddIndex ] * cosine;
+        real[ oddIndex ] = real[ evenIndex ] - oddReal;
+        imag[ oddIndex ] = imag[ evenIndex ] - oddImag;
+        real[ evenIndex ] += oddReal;
+        imag[ evenIndex ] += oddImag;
+      }
+    }
+  }
+}
+
+// Size n DFT in place for circulant matrices (any n), as a chirp convolution of length L (Bluestein algorithm):
+// X[ k ] = conj( w[ k ] ) x sum_j ( x[ j ] conj( w[ j ] ) ) w[ k - j ]
+static void TransformFourierChirp( StructuredMatrix matrix, double* real, double* imag )
+{
+  size_t size = matrix->rowsNumber, length = matrix->transformLength;
+  const double* chirpReal = matrix->chirpReal;
+  const double* chirpImag = matrix->chirpImag;
+  
+  memset( matrix->workReal, 0, length * sizeof(double) );
+  memset( matrix->workImag, 0, length * sizeof(double) );
+  for( size_t index = 0; index < size; index++ )
+  {
+    matrix->workReal[ index ] = real[ index ] * chirpReal[ index ] + imag[ index ] * chirpImag[ index ];
+    matrix->workImag[ index ] = imag[ index ] * chirpReal[ index ] - real[ index ] * chirpImag[ index ];
+  }
+  
+  TransformFourier( matrix, matrix->workReal, matrix->workImag, false );
+  for( size_t index = 0; index < length; index++ )
+  {
+    double workReal = matrix->workReal[ index ], workImag = matrix->workImag[ index ];
+    matrix->workReal[ index ] = workReal * matrix->chirpSpectrumReal[ index ] - workImag * matrix->chirpSpectrumImag[ index ];
+    matrix->workImag[ index ] = workReal * matrix->chirpSpectrumImag[ index ] + workImag * matrix->chirpSpectrumReal[ index ];
+  }
+  TransformFourier( matrix, matrix->workReal, matrix->workImag, true );
+  
+  for( size_t index = 0; index < size; index++ )
+  {
+    double convolutionReal = matrix->workReal[ index ] / length, convolutionImag = matrix->workImag[ index ] / length;
+    real[ index ] = convolutionReal * chirpReal[ index ] + convolutionImag * chirpImag[ index ];
+    imag[ index ] = convolutionImag * chirpReal[ index ] - convolutionReal * chirpImag[ index ];
+  }
+}
+
+StructuredMatrix StructuredMatrix_Create( char structure, size_t rowsNumber, size_t columnsNumber )
+{
+  if( structure != STRUCTURE_TOEPLITZ && structure != STRUCTURE_CIRCULANT && structure != STRUCTURE_HANKEL ) return NULL;
+  if( rowsNumber == 0 || columnsNumber == 0 || rowsNumber > MATRIX_SIZE_MAX || columnsNumber > MATRIX_SIZE_MAX ) return NULL;
+  if( structure == STRUCTURE_CIRCULANT && rowsNumber != columnsNumber ) return NULL;
+  
+  StructuredMatrix newMatrix = (StructuredMatrix) calloc( 1, sizeof(StructuredMatrixData) );
+  if( newMatrix == NULL ) return NULL;
+  
+  newMatrix->structure = structure;
+  newMatrix->rowsNumber = rowsNumber;
+  newMatrix->columnsNumber = columnsNumber;
+  
+  size_t valuesNumber = rowsNumber + columnsNumber - 1;
+  size_t maxLength = ( rowsNumber > columnsNumber ) ? rowsNumber : columnsNumber;
+  newMatrix->transformLength = 1;
+  while( newMatrix->transformLength < valuesNumber ) 
+    newMatrix->transformLength *= 2;
+  size_t transformLength = newMatrix->transformLength;
+  
+  newMatrix->valuesList = (double*) calloc( valuesNumber, sizeof(double) );
+  newMatrix->cosinesList = (double*) malloc( ( transformLength / 2 + 1 ) * sizeof(double) );
+  newMatrix->sinesList = (double*) malloc( ( transformLength / 2 + 1 ) * sizeof(double) );
+  newMatrix->spectrumReal = (double*) calloc( transformLength, sizeof(double) );
+  newMatrix->spectrumImag = (double*) calloc( transformLength, sizeof(double) );
+  newMatrix->workReal = (double*) malloc( transformLength * sizeof(double) );
+  newMatrix->workImag = (double*) malloc( transformLength * sizeof(double) );
+  newMatrix->forwardArray = (double*) malloc( maxLength * sizeof(double) );
+  newMatrix->backwardArray = (double*) malloc( maxLength * sizeof(double) );
+  newMatrix->columnArray = (double*) malloc( maxLength * sizeof(double) );
+  newMatrix->resultArray = (double*) malloc( maxLength * sizeof(double) );
+  
+  if( newMatrix->valuesList == NULL || newMatrix->cosinesList == NULL || newMatrix->sinesList == NULL 
+      || newMatrix->spectrumReal == NULL || newMatrix->spectrumImag == NULL || newMatrix->workReal == NULL || newMatrix->workImag == NULL 
+      || newMatrix->forwardArray == NULL || newMatrix->backwardArray == NULL || newMatrix->columnArray == NULL || newMatrix->resultArray == NULL )
+  {
+    StructuredMatrix_Discard( newMatrix );
+    return NULL;
+  }
+  
+  for( size_t index = 0; index <= transformLength / 2; index++ )
+  {
+    newMatrix->cosinesList[ index ] = cos( 2.0 * M_PI * index / transformLength );
+    newMatrix->sinesList[ index ] = sin( 2.0 * M_PI * index / transformLength );
+  }
+  
+  if( structure == STRUCTURE_CIRCULANT )
+  {
+    newMatrix->chirpReal = (double*) malloc( rowsNumber * sizeof(double) );
+    newMatrix->chirpImag = (double*) malloc( rowsNumber * sizeof(double) );
+    newMatrix->chirpSpectrumReal = (double*) calloc( transformLength, sizeof(double) );
+    newMatrix->chirpSpectrumImag = (double*) calloc( transformLength, sizeof(double) );
+    newMatrix->eigenvaluesReal = (double*) calloc( rowsNumber, sizeof(double) );
+    newMatrix->eigenvaluesImag = (double*) calloc( rowsNumber, sizeof(double) );
+    
+    if( newMatrix->chirpReal == NULL || newMatrix->chirpImag == NULL || newMatrix->chirpSpectrumReal == NULL || newMatrix->chirpSpectrumImag == NULL 
+        || newMatrix->eigenvaluesReal == NULL || newMatrix->eigenvaluesImag == NULL )
+    {
+      StructuredMatrix_Discard( newMatrix );
+      return NULL;
+    }
+    
+    // Chirp kernel w[ k - j ] for k - j in ( -n, n ), wrapped around L >= 2n - 1 (j² taken modulo 2n to keep phases accurate)
+    for( size_t index = 0; index < rowsNumber; index++ )
+    {
+      double phase = M_PI * (double) ( ( index * index ) % ( 2 * rowsNumber ) ) / rowsNumber;
+      newMatrix->chirpReal[ index ] = cos( phase );
+      newMatrix->chirpImag[ index ] = sin( phase );
+      newMatrix->chirpSpectrumReal[ index ] = newMatrix->chirpReal[ index ];
+      newMatrix->chirpSpectrumImag[ index ] = newMatrix->chirpImag[ index ];
+      if( index > 0 )
+      {
+        newMatrix->chirpSpectrumReal[ transformLength - index ] = newMatrix->chirpReal[ index ];
+        newMatrix->chirpSpectrumImag[ transformLength - index ] = newMatrix->chirpImag[ index ];
+      }
+    }
+    TransformFourier( newMatrix, newMatrix->chirpSpectrumReal, newMatrix->chirpSpectrumImag, false );
+  }
+  
+  return newMatrix;
+}
+
+void StructuredMatrix_Discard( StructuredMatrix matrix )
+{
+  if( matrix == NULL ) return;
+  
+  free( matrix->valuesList );
+  free( matrix->cosinesList );
+  free( matrix->sinesList );
+  free( matrix->spectrumReal );
+  free( matrix->spectrumImag );
+  free( matrix->workReal );
+  free( matrix->workImag );
+  free( matrix->chirpReal );
+  free( matrix->chirpImag );
+  free( matrix->chirpSpectrumReal );
+  free( matrix->chirpSpectrumImag );
+  free( matrix->eigenvaluesReal );
+  free( matrix->eigenvaluesImag );
+  free( matrix->forwardArray );
+  free( matrix->backwardArray );
+  free( matrix->columnArray );
+  free( matrix->resultArray );
+  
+  free( matrix );
+}
+
+bool StructuredMatrix_SetValues( StructuredMatrix matrix, double* columnValues, double* rowValues )
+{
+  if( matrix == NULL || columnValues == NULL ) return false;
+  if( matrix->structure != STRUCTURE_CIRCULANT && rowValues == NULL ) return false;
+  
+  size_t rowsNumber = matrix->rowsNumber, columnsNumber = matrix->columnsNumber;
+  double* valuesList = matrix->valuesList;
+  
+  if( matrix->structure == STRUCTURE_HANKEL )
+  {
+    memcpy( valuesList, columnValues, rowsNumber * sizeof(double) );
+    memcpy( valuesList + rowsNumber, rowValues + 1, ( columnsNumber - 1 ) * sizeof(double) );
+  }
+  else
+  {
+    // Sequence is ordered from the top right corner (t[ 1 - n ]) to the bottom left one (t[ m - 1 ])
+    for( size_t column = 1; column < columnsNumber; column++ )
+      valuesList[ columnsNumber - 1 - column ] = ( matrix->structure == STRUCTURE_CIRCULANT ) ? columnValues[ rowsNumber - column ] : rowValues[ column ];
+    memcpy( valuesList + columnsNumber - 1, columnValues, rowsNumber * sizeof(double) );
+  }
+  
+  size_t valuesNumber = rowsNumber + columnsNumber - 1;
+  memcpy( matrix->spectrumReal, valuesList, valuesNumber * sizeof(double) );
+  memset( matrix->spectrumReal + valuesNumber, 0, ( matrix->transformLength - valuesNumber ) * sizeof(double) );
+  memset( matrix->spectrumImag, 0, matrix->transformLength * sizeof(double) );
+  TransformFourier( matrix, matrix->spectrumReal, matrix->spectrumImag, false );
+  
+  if( matrix->structure == STRUCTURE_CIRCULANT )
+  {
+    memcpy( matrix->eigenvaluesReal, columnValues, rowsNumber * sizeof(double) );
+    memset( matrix->eigenvaluesImag, 0, rowsNumber * sizeof(double) );
+    TransformFourierChirp( matrix, matrix->eigenvaluesReal, matrix->eigenvaluesImag );
+  }
+  
+  return true;
+}
+
+size_t StructuredMatrix_GetHeight( StructuredMatrix matrix )
+{
+  if( matrix == NULL ) return 0;
+  
+  return matrix->rowsNumber;
+}
+
+size_t StructuredMatrix_GetWidth( StructuredMatrix matrix )
+{
+  if( matrix == NULL ) return 0;
+  
+  return matrix->columnsNumber;
+}
+
+double StructuredMatrix_GetElement( StructuredMatrix matrix, size_t row, size_t column )
+{
+  if( matrix == NULL ) return 0.0;
+  
+  if( row >= matrix->rowsNumber || column >= matrix->columnsNumber ) return 0.0;
+  
+  if( matrix->structure == STRUCTURE_HANKEL ) return matrix->valuesList[ row + column ];
+  
+  return matrix->valuesList[ matrix->columnsNumber - 1 + row - column ];
+}
+
+Matrix StructuredMatrix_ToDense( StructuredMatrix matrix, Matrix result )
+{
+  if( matrix == NULL || result == NULL ) return NULL;
+  
+  if( Mat_GetHeight( result ) != matrix->rowsNumber || Mat_GetWidth( result ) != matrix->columnsNumber ) return NULL;
+  
+  for( size_t column = 0; column < matrix->columnsNumber; column++ )
+  {
+    for( size_t row = 0; row < matrix->rowsNumber; row++ )
+      matrix->resultArray[ row ] = StructuredMatrix_GetElement( matrix, row, column );
+    Mat_SetColumn( result, column, matrix->resultArray );
+  }
+  
+  return result;
+}
+
+// Products are (circular) convolutions or correlations of the zero padded input with the generating sequence:
+// (A x)[ i ] = sum_j s[ n - 1 + i - j ] x[ j ] for Toeplitz/circulant matrices, and correlations r[ k ] = sum_j x[ j ] s[ j + k ] give
+// (A^T x)[ j ] = r[ n - 1 - j ] for them or (A x)[ i ] = r[ i ] and (A^T x)[ j ] = r[ j ] for Hankel ones (no wrap-around, as L >= m + n - 1)
+static void MultiplyColumn( StructuredMatrix matrix, bool isTransposed, const double* input, double* output )
+{
+  size_t inputLength = isTransposed ? matrix->rowsNumber : matrix->columnsNumber;
+  size_t outputLength = isTransposed ? matrix->columnsNumber : matrix->rowsNumber;
+  size_t length = matrix->transformLength;
+  double* workReal = matrix->workReal;
+  double* workImag = matrix->workImag;
+  
+  memcpy( workReal, input, inputLength * sizeof(double) );
+  memset( workReal + inputLength, 0, ( length - inputLength ) * sizeof(double) );
+  memset( workImag, 0, length * sizeof(double) );
+  
+  TransformFourier( matrix, workReal, workImag, false );
+  
+  bool isConvolution = ( matrix->structure != STRUCTURE_HANKEL && !isTransposed );
+  for( size_t index = 0; index < length; index++ )
+  {
+    double inputReal = workReal[ index ], inputImag = isConvolution ? workImag[ index ] : -workImag[ index ];
+    workReal[ index ] = inputReal * matrix->spectrumReal[ index ] - inputImag * matrix->spectrumImag[ index ];
+    workImag[ index ] = inputReal * matrix->spectrumImag[ index ] + inputImag * matrix->spectrumReal[ index ];
+  }
+  
+  TransformFourier( matrix, workReal, workImag, true );
+  
+  size_t columnsNumber = matrix->columnsNumber;
+  for( size_t index = 0; index < outputLength; index++ )
+  {
+    size_t sequenceIndex = index;
+    if( matrix->structure != STRUCTURE_HANKEL ) sequenceIndex = isTransposed ? columnsNumber - 1 - index : columnsNumber - 1 + index;
+    output[ index ] = workReal[ sequenceIndex ] / length;
+  }
+}
+
+Matrix StructuredMatrix_Dot( StructuredMatrix matrix, char transpose, Matrix input, Matrix result )
+{
+  if( matrix == NULL || input == NULL || result == NULL ) return NULL;
+  
+  bool isTransposed = ( transpose == MATRIX_TRANSPOSE );
+  size_t inputLength = isTransposed ? matrix->rowsNumber : matrix->columnsNumber;
+  size_t outputLength = isTransposed ? matrix->columnsNumber : matrix->rowsNumber;
+  if( Mat_GetHeight( input ) != inputLength ) return NULL;
+  if( Mat_GetHeight( result ) != outputLength || Mat_GetWidth( result ) != Mat_GetWidth( input ) ) return NULL;
+  
+  for( size_t column = 0; column < Mat_GetWidth( input ); column++ )
+  {
+    Mat_GetColumn( input, column, matrix->columnArray );
+    MultiplyColumn( matrix, isTransposed, matrix->columnArray, matrix->resultArray );
+    Mat_SetColumn( result, column, matrix->resultArray );
+  }
+  
+  return result;
+}
+
+// General (nonsymmetric) Levinson recursion for Toeplitz system with A[ i ][ j ] = t[ i - j ] = s[ n - 1 + direction x ( i - j ) ]: 
+// forward and backward vectors solving leading subsystems for first and last unit vectors are grown one order at a time
+static bool SolveLevinson( StructuredMatrix matrix, int direction, const double* input, double* output )
+{
+  size_t size = matrix->rowsNumber;
+  const double* diagonalsList = matrix->valuesList + size - 1;
+  double* forwardList = matrix->forwardArray;
+  double* backwardList = matrix->backwardArray;
+  
+  if( diagonalsList[ 0 ] == 0.0 ) return false;
+  
+  forwardList[ 0 ] = backwardList[ 0 ] = 1.0 / diagonalsList[ 0 ];
+  output[ 0 ] = input[ 0 ] / diagonalsList[ 0 ];
+  
+  for( size_t order = 1; order < size; order++ )
+  {
+    double forwardError = 0.0, backwardError = 0.0, solutionError = 0.0;
+    for( size_t index = 0; index < order; index++ )
+    {
+      double lastRowValue = diagonalsList[ direction * (ptrdiff_t) ( order - index ) ];
+      forwardError += lastRowValue * forwardList[ index ];
+      solutionError += lastRowValue * output[ index ];
+      backwardError += diagonalsList[ -direction * (ptrdiff_t) ( index + 1 ) ] * backwardList[ index ];
+    }
+    
+    double denominator = 1.0 - forwardError * backwardError;
+    if( fabs( denominator ) < DBL_EPSILON ) return false;
+    
+    // Backward vector is shifted down, so update goes from last to first element
+    for( size_t index = order + 1; index-- > 0; )
+    {
+      double forwardValue = ( index < order ) ? forwardList[ index ] : 0.0;
+      double backwardValue = ( index > 0 ) ? backwardList[ index - 1 ] : 0.0;
+      forwardList[ index ] = ( forwardValue - forwardError * backwardValue ) / denominator;
+      backwardList[ index ] = ( backwardValue - backwardError * forwardValue ) / denominator;
+    }
+    
+    double correction = input[ order ] - solutionError;
+    output[ order ] = 0.0;
+    for( size_t index = 0; index <= order; index++ )
+      output[ index ] += correction * backwardList[ index ];
+  }
+  
+  return true;
+}
+
+// Circulant matrices are diagonalized by the DFT: x = IDFT( DFT( b ) / lambda ), with conjugate eigenvalues for the transpose
+static bool SolveCirculant( StructuredMatrix matrix, bool isTransposed, double* real, double* imag )
+{
+  size_t size = matrix->rowsNumber;
+  const double* eigenvaluesReal = matrix->eigenvaluesReal;
+  const double* eigenvaluesImag = matrix->eigenvaluesImag;
+  
+  double magnitudeMax = 0.0;
+  for( size_t index = 0; index < size; index++ )
+    magnitudeMax = fmax( magnitudeMax, hypot( eigenvaluesReal[ index ], eigenvaluesImag[ index ] ) );
+  
+  memset( imag, 0, size * sizeof(double) );
+  TransformFourierChirp( matrix, real, imag );
+  
+  for( size_t index = 0; index < size; index++ )
+  {
+    double eigenvalueReal = eigenvaluesReal[ index ];
+    double eigenvalueImag = isTransposed ? -eigenvaluesImag[ index ] : eigenvaluesImag[ index ];
+    double squaredMagnitude = eigenvalueReal * eigenvalueReal + eigenvalueImag * eigenvalueImag;
+    if( sqrt( squaredMagnitude ) <= DBL_EPSILON * size * magnitudeMax ) return false;
+    
+    // Division by eigenvalue, conjugating afterwards for the inverse transform: IDFT( X ) = conj( DFT( conj( X ) ) ) / n
+    double quotientReal = ( real[ index ] * eigenvalueReal + imag[ index ] * eigenvalueImag ) / squaredMagnitude;
+    double quotientImag = ( imag[ index ] * eigenvalueReal - real[ index ] * eigenvalueImag ) / squaredMagnitude;
+    real[ index ] = quotientReal;
+    imag[ index ] = -quotientImag;
+  }
+  
+  TransformFourierChirp( matrix, real, imag );
+  
+  for( size_t index = 0; index < size; index++ )
+    real[ index ] /= size;
+  
+  return true;
+}
+
+Matrix StructuredMatrix_Solve( StructuredMatrix matrix, char transpose, Matrix input, Matrix result )
+{
+  if( matrix == NULL || input == NULL || result == NULL ) return NULL;
+  
+  size_t size = matrix->rowsNumber;
+  if( matrix->columnsNumber != size ) return NULL;
+  if( Mat_GetHeight( input ) != size || Mat_GetHeight( result ) != size || Mat_GetWidth( result ) != Mat_GetWidth( input ) ) return NULL;
+  
+  bool isTransposed = ( transpose == MATRIX_TRANSPOSE );
+  
+  for( size_t column = 0; column < Mat_GetWidth( input ); column++ )
+  {
+    Mat_GetColumn( input, column, matrix->columnArray );
+    
+    bool isSolved = false;
+    if( matrix->structure == STRUCTURE_CIRCULANT )
+    {
+      isSolved = SolveCirculant( matrix, isTransposed, matrix->columnArray, matrix->resultArray );
+      memcpy( matrix->resultArray, matrix->columnArray, size * sizeof(double) );
+    }
+    else if( matrix->structure == STRUCTURE_HANKEL )
+    {
+      // Square Hankel matrices are symmetric, and reversing their rows gives Toeplitz matrix with t[ d ] = s[ n - 1 - d ]
+      for( size_t index = 0; index < size / 2; index++ )
+      {
+        double swapValue = matrix->columnArray[ index ];
+        matrix->columnArray[ index ] = matrix->columnArray[ size - 1 - index ];
+        matrix->columnArray[ size - 1 - index ] = swapValue;
+      }
+      isSolved = SolveLevinson( matrix, -1, matrix->columnArray, matrix->resultArray );
+    }
+    else
+    {
+      isSolved = SolveLevinson( matrix, isTransposed ? -1 : 1, matrix->columnArray, matrix->resultArray );
+    }
+    
+    if( !isSolved ) return NULL;
+    
+    Mat_SetColumn( result, column, matrix->resultArray );
+  }
+  
+  return result;
+}
@@ -0,0 +1,98 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+
+/// @file structured_matrix.h
+/// @brief Toeplitz, circulant and Hankel matrices stored by their generating values, with FFT based products and fast solves
+
+#ifndef STRUCTURED_MATRIX_H
+#define STRUCTURED_MATRIX_H
+
+#include "matrix.h"
+
+#define STRUCTURE_TOEPLITZ 'T'      ///< Constant diagonals: A[ i ][ j ] = t[ i - j ]
+#define STRUCTURE_CIRCULANT 'C'     ///< Square Toeplitz matrix with cyclically shifted columns: A[ i ][ j ] = c[ ( i - j ) mod n ]
+#define STRUCTURE_HANKEL 'H'        ///< Constant anti-diagonals: A[ i ][ j ] = h[ i + j ]
+
+typedef struct _StructuredMatrixData StructuredMatrixData;    ///< Structured matrix internal data structure
+typedef StructuredMatrixData* StructuredMatrix;               ///< Opaque reference to structured matrix data structure
+
+
+/// @brief Creates structured matrix of given dimensions, with all generating values zeroed and all product/solve workspace preallocated
+/// @param[in] structure type of matrix structure (STRUCTURE_TOEPLITZ, STRUCTURE_CIRCULANT or STRUCTURE_HANKEL)
+/// @param[in] rowsNumber number of matrix rows
+/// @param[in] columnsNumber number of matrix columns (must be equal to rows number for circulant matrices)
+/// @return reference/pointer to allocated structured matrix (NULL on errors or if rows or columns number is greater than MATRIX_SIZE_MAX)
+StructuredMatrix StructuredMatrix_Create( char structure, size_t rowsNumber, size_t columnsNumber );
+
+/// @brief Destroys/deallocates memory of structured matrix
+/// @param[in] matrix reference to structured matrix to be destroyed/deallocated
+void StructuredMatrix_Discard( StructuredMatrix matrix );
+
+/// @brief Sets generating values of structured matrix, updating their cached spectrum (no allocations, O((m + n) log(m + n)) cost)
+/// @param[in] matrix reference to structured matrix
+/// @param[in] columnValues array with first column values (rows number elements)
+/// @param[in] rowValues array with first row (Toeplitz) or last row (Hankel) values (columns number elements, first one ignored, NULL for circulant matrices)
+/// @return true on success, false on errors
+bool StructuredMatrix_SetValues( StructuredMatrix matrix, double* columnValues, double* rowValues );
+
+/// @brief Gets number of rows of structured matrix
+/// @param[in] matrix reference to structured matrix
+/// @return number of rows (0 on errors)
+size_t StructuredMatrix_GetHeight( StructuredMatrix matrix );
+
+/// @brief Gets number of columns of structured matrix
+/// @param[in] matrix reference to structured matrix
+/// @return number of columns (0 on errors)
+size_t StructuredMatrix_GetWidth( StructuredMatrix matrix );
+
+/// @brief Gets value of single element of structured matrix
+/// @param[in] matrix reference to structured matrix
+/// @param[in] row element row index
+/// @param[in] column element column index
+/// @return element value (0.0 on errors)
+double StructuredMatrix_GetElement( StructuredMatrix matrix, size_t row, size_t column );
+
+/// @brief Materializes structured matrix into dense storage (only for when a dense operator is really needed)
+/// @param[in] matrix reference to structured matrix
+/// @param[out] result reference to matrix with same dimensions, to hold all elements
+/// @return reference/pointer to @a result matrix (NULL on errors)
+Matrix StructuredMatrix_ToDense( StructuredMatrix matrix, Matrix result );
+
+/// @brief Multiplies structured matrix by dense matrix, one column at a time, through fast convolution (O((m + n) log(m + n)) per column)
+/// @param[in] matrix reference to structured matrix A
+/// @param[in] transpose defines transformation applied to A (MATRIX_TRANSPOSE or MATRIX_KEEP)
+/// @param[in] input reference to dense matrix B, with rows number equal to A (or A^T) columns number
+/// @param[out] result reference to matrix to hold A x B (or A^T x B) (can be the same as @a input, for square A)
+/// @return reference/pointer to @a result matrix (NULL on errors)
+Matrix StructuredMatrix_Dot( StructuredMatrix matrix, char transpose, Matrix input, Matrix result );
+
+/// @brief Solves linear system A x X = B (or A^T x X = B) for square structured matrix, one column at a time, 
+/// through Levinson recursion (Toeplitz/Hankel, O(n²) per column) or spectrum division (circulant, O(n log n) per column)
+/// @param[in] matrix reference to square structured matrix A (Toeplitz/Hankel with nonsingular leading principal submatrices, after row reversal for Hankel)
+/// @param[in] transpose defines transformation applied to A (MATRIX_TRANSPOSE or MATRIX_KEEP)
+/// @param[in] input reference to dense right-hand side matrix B
+/// @param[out] result reference to matrix to hold solution X (can be the same as @a input)
+/// @return reference/pointer to @a result matrix (NULL on errors or singular systems)
+Matrix StructuredMatrix_Solve( StructuredMatrix matrix, char transpose, Matrix input, Matrix result );
+
+#endif // STRUCTURED_MATRIX_H
@@ -0,0 +1,135 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include "test_utils.h"
+#include "filter_bank.h"
+
+
+#define TOLERANCE 1e-10
+#define CHANNELS_NUMBER 3
+#define SAMPLES_NUMBER 40
+#define BLOCK_LENGTH 15
+
+// Dense lower triangular Toeplitz operator of a causal impulse response, so that y = T x (samples x samples)
+static Matrix CreateConvolution( double* responseList, size_t responseLength )
+{
+  Matrix convolution = Mat_Create( NULL, SAMPLES_NUMBER, SAMPLES_NUMBER );
+  for( size_t row = 0; row < SAMPLES_NUMBER; row++ )
+  {
+    for( size_t delay = 0; delay < responseLength && delay <= row; delay++ )
+      Mat_SetElement( convolution, row, row - delay, responseList[ delay ] );
+  }
+  return convolution;
+}
+
+// Filters all samples with 2 blocks of different lengths, checking state continuity between calls
+static void ProcessInBlocks( FilterBank filterBank, Matrix input, Matrix output )
+{
+  Matrix inputBlock = Mat_Create( NULL, BLOCK_LENGTH, CHANNELS_NUMBER );
+  Matrix outputBlock = Mat_Create( NULL, BLOCK_LENGTH, CHANNELS_NUMBER );
+  
+  for( size_t firstSample = 0; firstSample < SAMPLES_NUMBER; firstSample += BLOCK_LENGTH )
+  {
+    size_t blockLength = ( SAMPLES_NUMBER - firstSample < BLOCK_LENGTH ) ? SAMPLES_NUMBER - firstSample : BLOCK_LENGTH;
+    Mat_Resize( inputBlock, blockLength, CHANNELS_NUMBER );
+    Mat_Resize( outputBlock, blockLength, CHANNELS_NUMBER );
+    for( size_t sample = 0; sample < blockLength; sample++ )
+    {
+      for( size_t channel = 0; channel < CHANNELS_NUMBER; channel++ )
+        Mat_SetElement( inputBlock, sample, channel, Mat_GetElement( input, firstSample + sample, channel ) );
+    }
+    TEST_CHECK( FilterBank_Process( filterBank, inputBlock, MATRIX_ALONG_COLUMNS, outputBlock ) != NULL );
+    for( size_t sample = 0; sample < blockLength; sample++ )
+    {
+      for( size_t channel = 0; channel < CHANNELS_NUMBER; channel++ )
+        Mat_SetElement( output, firstSample + sample, channel, Mat_GetElement( outputBlock, sample, channel ) );
+    }
+  }
+  
+  Mat_Discard( inputBlock );
+  Mat_Discard( outputBlock );
+}
+
+static void TestFIR( void )
+{
+  double coefficientsList[ 5 ] = { 0.5, -0.25, 0.125, 1.0, -0.75 };
+  Matrix input = Test_FillRandom( Mat_Create( NULL, SAMPLES_NUMBER, CHANNELS_NUMBER ), 1.0 );
+  Matrix output = Mat_Create( NULL, SAMPLES_NUMBER, CHANNELS_NUMBER ), reference = Mat_Create( NULL, SAMPLES_NUMBER, CHANNELS_NUMBER );
+  Matrix convolution = CreateConvolution( coefficientsList, 5 );
+  FilterBank filterBank = FilterBank_CreateFIR( CHANNELS_NUMBER, coefficientsList, 5 );
+  
+  TEST_CHECK( filterBank != NULL );
+  ProcessInBlocks( filterBank, input, output );
+  Mat_Dot( convolution, MATRIX_KEEP, input, MATRIX_KEEP, reference );
+  TEST_CHECK_CLOSE( Mat_MaxAbsDiff( output, reference ), 0.0, TOLERANCE );
+  
+  // Channels along rows, after clearing state
+  Matrix transposedInput = Mat_Transpose( input, Mat_Create( NULL, CHANNELS_NUMBER, SAMPLES_NUMBER ) );
+  Matrix transposedOutput = Mat_Create( NULL, CHANNELS_NUMBER, SAMPLES_NUMBER );
+  FilterBank_Reset( filterBank );
+  TEST_CHECK( FilterBank_Process( filterBank, transposedInput, MATRIX_ALONG_ROWS, transposedOutput ) != NULL );
+  Mat_Transpose( transposedOutput, output );
+  TEST_CHECK_CLOSE( Mat_MaxAbsDiff( output, reference ), 0.0, TOLERANCE );
+  
+  Mat_Discard( input ); Mat_Discard( output ); Mat_Discard( reference ); Mat_Discard( convolution );
+  Mat_Discard( transposedInput ); Mat_Discard( transposedOutput );
+  FilterBank_Discard( filterBank );
+}
+
+// Each section is A y = B x, with lower triangular Toeplitz A and B, solved densely
+static void TestBiquad( void )
+{
+  double coefficientsList[ 10 ] = { 0.2, 0.4, 0.2, -0.5, 0.3,   1.0, -1.2, 0.5, 0.1, -0.2 };
+  Matrix input = Test_FillRandom( Mat_Create( NULL, SAMPLES_NUMBER, CHANNELS_NUMBER ), 1.0 );
+  Matrix output = Mat_Create( NULL, SAMPLES_NUMBER, CHANNELS_NUMBER ), reference = Mat_Copy( input, Mat_Create( NULL, SAMPLES_NUMBER, CHANNELS_NUMBER ) );
+  Matrix product = Mat_Create( NULL, SAMPLES_NUMBER, CHANNELS_NUMBER );
+  FilterBank filterBank = FilterBank_CreateBiquad( CHANNELS_NUMBER, coefficientsList, 2 );
+  
+  TEST_CHECK( filterBank != NULL );
+  ProcessInBlocks( filterBank, input, output );
+  for( size_t section = 0; section < 2; section++ )
+  {
+    double* sectionList = coefficientsList + 5 * section;
+    Matrix numerator = CreateConvolution( sectionList, 3 );
+    Matrix denominator = CreateConvolution( (double[ 3 ]){ 1.0, sectionList[ 3 ], sectionList[ 4 ] }, 3 );
+    Mat_Dot( numerator, MATRIX_KEEP, reference, MATRIX_KEEP, product );
+    Mat_TriangularSolve( denominator, MATRIX_LOWER, MATRIX_KEEP, MATRIX_UNIT_DIAGONAL, product );
+    Mat_Copy( product, reference );
+    Mat_Discard( numerator );
+    Mat_Discard( denominator );
+  }
+  TEST_CHECK_CLOSE( Mat_MaxAbsDiff( output, reference ), 0.0, TOLERANCE );
+  
+  Mat_Discard( input ); Mat_Discard( output ); Mat_Discard( reference ); Mat_Discard( product );
+  FilterBank_Discard( filterBank );
+}
+
+int main( void )
+{
+  srand( 1 );
+  
+  TestFIR();
+  TestBiquad();
+  
+  return Test_GetResult( "filter_bank" );
+}
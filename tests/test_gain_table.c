@@ -0,0 +1,137 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include "test_utils.h"
+#include "gain_table.h"
+
+
+#define TOLERANCE 1e-12
+#define ROWS_NUMBER 2
+#define COLUMNS_NUMBER 3
+
+// Bilinear reference, from explicit weighted sum of cell corner matrices
+static void TestBilinear( void )
+{
+  size_t pointsNumbersList[ 2 ] = { 3, 4 };
+  double breakpointsList[ 2 ][ 4 ] = { { -1.0, 0.5, 2.0 }, { 0.0, 1.0, 1.5, 4.0 } };
+  Matrix gainsList[ 3 ][ 4 ];
+  
+  GainTable table = GainTable_Create( ROWS_NUMBER, COLUMNS_NUMBER, 2, pointsNumbersList );
+  TEST_CHECK( table != NULL );
+  for( size_t dimension = 0; dimension < 2; dimension++ )
+    TEST_CHECK( GainTable_SetBreakpoints( table, dimension, breakpointsList[ dimension ] ) );
+  for( size_t first = 0; first < pointsNumbersList[ 0 ]; first++ )
+  {
+    for( size_t second = 0; second < pointsNumbersList[ 1 ]; second++ )
+    {
+      gainsList[ first ][ second ] = Test_FillRandom( Mat_Create( NULL, ROWS_NUMBER, COLUMNS_NUMBER ), 1.0 );
+      TEST_CHECK( GainTable_SetGain( table, (size_t[ 2 ]){ first, second }, gainsList[ first ][ second ] ) );
+    }
+  }
+  
+  Matrix result = Mat_Create( NULL, ROWS_NUMBER, COLUMNS_NUMBER ), reference = Mat_Create( NULL, ROWS_NUMBER, COLUMNS_NUMBER );
+  // Inside cell ( 1, 1 ), at grid point ( 2, 3 ) and outside grid (clamped to ( 0, 2 ) edge)
+  double operatingPointsList[ 3 ][ 2 ] = { { 1.25, 1.2 }, { 2.0, 4.0 }, { -3.0, 1.25 } };
+  size_t cellsList[ 3 ][ 2 ] = { { 1, 1 }, { 1, 2 }, { 0, 1 } };
+  double weightsList[ 3 ][ 2 ] = { { 0.5, 0.4 }, { 1.0, 1.0 }, { 0.0, 0.5 } };
+  for( size_t point = 0; point < 3; point++ )
+  {
+    size_t first = cellsList[ point ][ 0 ], second = cellsList[ point ][ 1 ];
+    double firstWeight = weightsList[ point ][ 0 ], secondWeight = weightsList[ point ][ 1 ];
+    Mat_Scale( gainsList[ first ][ second ], ( 1.0 - firstWeight ) * ( 1.0 - secondWeight ), reference );
+    Mat_Sum( reference, 1.0, gainsList[ first + 1 ][ second ], firstWeight * ( 1.0 - secondWeight ), reference );
+    Mat_Sum( reference, 1.0, gainsList[ first ][ second + 1 ], ( 1.0 - firstWeight ) * secondWeight, reference );
+    Mat_Sum( reference, 1.0, gainsList[ first + 1 ][ second + 1 ], firstWeight * secondWeight, reference );
+    TEST_CHECK( GainTable_GetGain( table, operatingPointsList[ point ], result ) != NULL );
+    TEST_CHECK_CLOSE( Mat_MaxAbsDiff( result, reference ), 0.0, TOLERANCE );
+  }
+  
+  // Wrong dimensions and unordered breakpoints
+  Matrix transposed = Mat_Create( NULL, COLUMNS_NUMBER, ROWS_NUMBER );
+  TEST_CHECK( GainTable_GetGain( table, operatingPointsList[ 0 ], transposed ) == NULL );
+  TEST_CHECK( !GainTable_SetGain( table, (size_t[ 2 ]){ 0, 0 }, transposed ) );
+  TEST_CHECK( !GainTable_SetGain( table, (size_t[ 2 ]){ 3, 0 }, result ) );
+  TEST_CHECK( !GainTable_SetBreakpoints( table, 0, (double[ 3 ]){ 0.0, 2.0, 1.0 } ) );
+  
+  for( size_t first = 0; first < pointsNumbersList[ 0 ]; first++ )
+  {
+    for( size_t second = 0; second < pointsNumbersList[ 1 ]; second++ )
+      Mat_Discard( gainsList[ first ][ second ] );
+  }
+  Mat_Discard( result ); Mat_Discard( reference ); Mat_Discard( transposed );
+  GainTable_Discard( table );
+}
+
+// Trilinear interpolation reproduces gains affine on scheduling variables: G = G0 + x G1 + y G2 + z G3
+static void TestTrilinear( void )
+{
+  size_t pointsNumbersList[ 3 ] = { 2, 3, 2 };
+  double breakpointsList[ 3 ][ 3 ] = { { 0.0, 1.0 }, { -2.0, 0.0, 3.0 }, { 1.0, 5.0 } };
+  Matrix basesList[ 4 ];
+  for( size_t base = 0; base < 4; base++ )
+    basesList[ base ] = Test_FillRandom( Mat_Create( NULL, ROWS_NUMBER, COLUMNS_NUMBER ), 1.0 );
+  Matrix gain = Mat_Create( NULL, ROWS_NUMBER, COLUMNS_NUMBER ), result = Mat_Create( NULL, ROWS_NUMBER, COLUMNS_NUMBER );
+  
+  GainTable table = GainTable_Create( ROWS_NUMBER, COLUMNS_NUMBER, 3, pointsNumbersList );
+  TEST_CHECK( table != NULL );
+  for( size_t dimension = 0; dimension < 3; dimension++ )
+    TEST_CHECK( GainTable_SetBreakpoints( table, dimension, breakpointsList[ dimension ] ) );
+  for( size_t first = 0; first < pointsNumbersList[ 0 ]; first++ )
+  {
+    for( size_t second = 0; second < pointsNumbersList[ 1 ]; second++ )
+    {
+      for( size_t third = 0; third < pointsNumbersList[ 2 ]; third++ )
+      {
+        Mat_Copy( basesList[ 0 ], gain );
+        Mat_Sum( gain, 1.0, basesList[ 1 ], breakpointsList[ 0 ][ first ], gain );
+        Mat_Sum( gain, 1.0, basesList[ 2 ], breakpointsList[ 1 ][ second ], gain );
+        Mat_Sum( gain, 1.0, basesList[ 3 ], breakpointsList[ 2 ][ third ], gain );
+        TEST_CHECK( GainTable_SetGain( table, (size_t[ 3 ]){ first, second, third }, gain ) );
+      }
+    }
+  }
+  
+  double operatingPoint[ 3 ] = { 0.3, 1.7, 2.5 };
+  Mat_Copy( basesList[ 0 ], gain );
+  for( size_t dimension = 0; dimension < 3; dimension++ )
+    Mat_Sum( gain, 1.0, basesList[ dimension + 1 ], operatingPoint[ dimension ], gain );
+  TEST_CHECK( GainTable_GetGain( table, operatingPoint, result ) != NULL );
+  TEST_CHECK_CLOSE( Mat_MaxAbsDiff( result, gain ), 0.0, TOLERANCE );
+  
+  for( size_t base = 0; base < 4; base++ )
+    Mat_Discard( basesList[ base ] );
+  Mat_Discard( gain ); Mat_Discard( result );
+  GainTable_Discard( table );
+}
+
+int main( void )
+{
+  srand( 1 );
+  
+  TestBilinear();
+  TestTrilinear();
+  
+  TEST_CHECK( GainTable_Create( ROWS_NUMBER, COLUMNS_NUMBER, GAIN_TABLE_DIMENSIONS_MAX + 1, (size_t[ 4 ]){ 2, 2, 2, 2 } ) == NULL );
+  
+  return Test_GetResult( "gain_table" );
+}
@@ -0,0 +1,168 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include "test_utils.h"
+#include "gaussian_process.h"
+
+
+#define TOLERANCE 1e-8
+#define SPARSE_TOLERANCE 1e-6          // Explicit difference of inverses in the DTC reference loses some digits
+#define INPUTS_NUMBER 2
+#define POINTS_NUMBER 14
+#define STORED_POINTS_NUMBER 8
+#define QUERIES_NUMBER 5
+#define LENGTH_SCALE 0.7
+#define VARIANCE 1.5
+#define NOISE_VARIANCE 0.01
+
+static Matrix GetKernel( Matrix points_1, Matrix points_2 )
+{
+  Matrix kernel = Mat_Create( NULL, Mat_GetWidth( points_1 ), Mat_GetWidth( points_2 ) );
+  return Mat_Kernel( points_1, points_2, MATRIX_KERNEL_GAUSSIAN, LENGTH_SCALE, VARIANCE, kernel );
+}
+
+static Matrix GetFirstColumns( Matrix matrix, size_t columnsNumber )
+{
+  Matrix result = Mat_Create( NULL, Mat_GetHeight( matrix ), columnsNumber );
+  double columnList[ POINTS_NUMBER ];
+  for( size_t column = 0; column < columnsNumber; column++ )
+    Mat_SetColumn( result, column, Mat_GetColumn( matrix, column, columnList ) );
+  return result;
+}
+
+// Exact posterior: mean = k^T ( K + s² I )^-1 y, variance = k(x,x) - k^T ( K + s² I )^-1 k
+static void GetExactReference( Matrix inputs, Matrix outputs, Matrix queries, Matrix means, Matrix variances )
+{
+  size_t pointsNumber = Mat_GetWidth( inputs );
+  Matrix kernel = GetKernel( inputs, inputs ), crossKernel = GetKernel( inputs, queries );
+  for( size_t point = 0; point < pointsNumber; point++ )
+    Mat_SetElement( kernel, point, point, Mat_GetElement( kernel, point, point ) + NOISE_VARIANCE );
+  Mat_Inverse( kernel, kernel );
+  Matrix weights = Mat_Dot( kernel, MATRIX_KEEP, crossKernel, MATRIX_KEEP, Mat_Create( NULL, pointsNumber, QUERIES_NUMBER ) );
+  
+  for( size_t query = 0; query < QUERIES_NUMBER; query++ )
+  {
+    double mean = 0.0, variance = VARIANCE;
+    for( size_t point = 0; point < pointsNumber; point++ )
+    {
+      mean += Mat_GetElement( weights, point, query ) * Mat_GetElement( outputs, point, 0 );
+      variance -= Mat_GetElement( weights, point, query ) * Mat_GetElement( crossKernel, point, query );
+    }
+    Mat_SetElement( means, query, 0, mean );
+    Mat_SetElement( variances, query, 0, variance );
+  }
+  
+  Mat_Discard( kernel ); Mat_Discard( crossKernel ); Mat_Discard( weights );
+}
+
+// DTC approximation over inducing points Z: S = Kzz + Kzx Kxz / s², mean = k^T S^-1 Kzx y / s², variance = k(x,x) - k^T ( Kzz^-1 - S^-1 ) k
+static void GetSparseReference( Matrix inducingPoints, Matrix inputs, Matrix outputs, Matrix queries, Matrix means, Matrix variances )
+{
+  size_t inducingNumber = Mat_GetWidth( inducingPoints );
+  Matrix inducingKernel = GetKernel( inducingPoints, inducingPoints ), inputsKernel = GetKernel( inducingPoints, inputs );
+  Matrix crossKernel = GetKernel( inducingPoints, queries );
+  Matrix system = Mat_Dot( inputsKernel, MATRIX_KEEP, inputsKernel, MATRIX_TRANSPOSE, Mat_Create( NULL, inducingNumber, inducingNumber ) );
+  Mat_Sum( inducingKernel, 1.0, system, 1.0 / NOISE_VARIANCE, system );
+  Matrix projection = Mat_Dot( inputsKernel, MATRIX_KEEP, outputs, MATRIX_KEEP, Mat_Create( NULL, inducingNumber, 1 ) );
+  Mat_Inverse( system, system );
+  Mat_Inverse( inducingKernel, inducingKernel );
+  Mat_Sum( inducingKernel, 1.0, system, -1.0, inducingKernel );
+  Matrix weights = Mat_Dot( system, MATRIX_KEEP, projection, MATRIX_KEEP, Mat_Create( NULL, inducingNumber, 1 ) );
+  Matrix correction = Mat_Dot( inducingKernel, MATRIX_KEEP, crossKernel, MATRIX_KEEP, Mat_Create( NULL, inducingNumber, QUERIES_NUMBER ) );
+  
+  for( size_t query = 0; query < QUERIES_NUMBER; query++ )
+  {
+    double mean = 0.0, variance = VARIANCE;
+    for( size_t point = 0; point < inducingNumber; point++ )
+    {
+      mean += Mat_GetElement( crossKernel, point, query ) * Mat_GetElement( weights, point, 0 ) / NOISE_VARIANCE;
+      variance -= Mat_GetElement( crossKernel, point, query ) * Mat_GetElement( correction, point, query );
+    }
+    Mat_SetElement( means, query, 0, mean );
+    Mat_SetElement( variances, query, 0, variance );
+  }
+  
+  Mat_Discard( inducingKernel ); Mat_Discard( inputsKernel ); Mat_Discard( crossKernel ); Mat_Discard( system );
+  Mat_Discard( projection ); Mat_Discard( weights ); Mat_Discard( correction );
+}
+
+// Predictions into row vectors, compared to column vector references
+static void CheckPrediction( GaussianProcess model, Matrix queries, Matrix referenceMeans, Matrix referenceVariances, double tolerance )
+{
+  Matrix means = Mat_Create( NULL, 1, QUERIES_NUMBER ), variances = Mat_Create( NULL, 1, QUERIES_NUMBER );
+  
+  TEST_CHECK( GaussianProcess_Predict( model, queries, means, variances ) );
+  TEST_CHECK( Mat_GetHeight( means ) == 1 && Mat_GetHeight( variances ) == 1 );
+  for( size_t query = 0; query < QUERIES_NUMBER; query++ )
+  {
+    TEST_CHECK_CLOSE( Mat_GetElement( means, 0, query ), Mat_GetElement( referenceMeans, query, 0 ), tolerance );
+    TEST_CHECK_CLOSE( Mat_GetElement( variances, 0, query ), Mat_GetElement( referenceVariances, query, 0 ), tolerance );
+  }
+  
+  Mat_Discard( means ); Mat_Discard( variances );
+}
+
+int main( void )
+{
+  srand( 1 );
+  
+  Matrix inputs = Test_FillRandom( Mat_Create( NULL, INPUTS_NUMBER, POINTS_NUMBER ), 1.5 );
+  Matrix queries = Test_FillRandom( Mat_Create( NULL, INPUTS_NUMBER, QUERIES_NUMBER ), 1.5 );
+  Matrix outputs = Mat_Create( NULL, POINTS_NUMBER, 1 );
+  for( size_t point = 0; point < POINTS_NUMBER; point++ )
+    Mat_SetElement( outputs, point, 0, sin( Mat_GetElement( inputs, 0, point ) ) + cos( Mat_GetElement( inputs, 1, point ) ) );
+  Matrix storedInputs = GetFirstColumns( inputs, STORED_POINTS_NUMBER );
+  Matrix storedOutputs = Mat_Resize( Mat_Copy( outputs, Mat_Create( NULL, POINTS_NUMBER, 1 ) ), STORED_POINTS_NUMBER, 1 );
+  Matrix means = Mat_Create( NULL, QUERIES_NUMBER, 1 ), variances = Mat_Create( NULL, QUERIES_NUMBER, 1 );
+  
+  GaussianProcess incrementalModel = GaussianProcess_Create( INPUTS_NUMBER, STORED_POINTS_NUMBER, MATRIX_KERNEL_GAUSSIAN, LENGTH_SCALE, VARIANCE, NOISE_VARIANCE );
+  GaussianProcess batchModel = GaussianProcess_Create( INPUTS_NUMBER, STORED_POINTS_NUMBER, MATRIX_KERNEL_GAUSSIAN, LENGTH_SCALE, VARIANCE, NOISE_VARIANCE );
+  TEST_CHECK( incrementalModel != NULL && batchModel != NULL );
+  
+  // Exact model: points added one by one or fitted at once
+  double inputList[ INPUTS_NUMBER ];
+  for( size_t point = 0; point < STORED_POINTS_NUMBER; point++ )
+    TEST_CHECK( GaussianProcess_AddPoint( incrementalModel, Mat_GetColumn( inputs, point, inputList ), Mat_GetElement( outputs, point, 0 ) ) );
+  TEST_CHECK( GaussianProcess_Fit( batchModel, storedInputs, storedOutputs ) );
+  TEST_CHECK( !GaussianProcess_IsSparse( incrementalModel ) && !GaussianProcess_IsSparse( batchModel ) );
+  GetExactReference( storedInputs, storedOutputs, queries, means, variances );
+  CheckPrediction( incrementalModel, queries, means, variances, TOLERANCE );
+  CheckPrediction( batchModel, queries, means, variances, TOLERANCE );
+  
+  // Sparse model, with stored points as inducing ones
+  for( size_t point = STORED_POINTS_NUMBER; point < POINTS_NUMBER; point++ )
+    TEST_CHECK( GaussianProcess_AddPoint( incrementalModel, Mat_GetColumn( inputs, point, inputList ), Mat_GetElement( outputs, point, 0 ) ) );
+  TEST_CHECK( GaussianProcess_Fit( batchModel, inputs, outputs ) );
+  TEST_CHECK( GaussianProcess_IsSparse( incrementalModel ) && GaussianProcess_IsSparse( batchModel ) );
+  TEST_CHECK( GaussianProcess_GetPointsNumber( incrementalModel ) == POINTS_NUMBER );
+  GetSparseReference( storedInputs, inputs, outputs, queries, means, variances );
+  CheckPrediction( incrementalModel, queries, means, variances, SPARSE_TOLERANCE );
+  CheckPrediction( batchModel, queries, means, variances, SPARSE_TOLERANCE );
+  
+  Mat_Discard( inputs ); Mat_Discard( queries ); Mat_Discard( outputs ); Mat_Discard( storedInputs ); Mat_Discard( storedOutputs );
+  Mat_Discard( means ); Mat_Discard( variances );
+  GaussianProcess_Discard( incrementalModel );
+  GaussianProcess_Discard( batchModel );
+  
+  return Test_GetResult( "gaussian_process" );
+}
@@ -0,0 +1,121 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include "test_utils.h"
+#include "lbfgs.h"
+
+
+#define TOLERANCE 1e-7
+#define PARAMETERS_NUMBER 8
+#define MEMORY_LENGTH 5
+#define LARGE_PARAMETERS_NUMBER ( 2 * MATRIX_SIZE_MAX )
+
+typedef struct _QuadraticProblem { double hessianList[ PARAMETERS_NUMBER * PARAMETERS_NUMBER ], offsetList[ PARAMETERS_NUMBER ]; } QuadraticProblem;
+
+// f = 0.5 x^T A x - b^T x, with column-major A
+static bool EvaluateQuadratic( double* parametersList, double* gradientList, double* value, void* userData )
+{
+  QuadraticProblem* problem = (QuadraticProblem*) userData;
+  *value = 0.0;
+  for( size_t row = 0; row < PARAMETERS_NUMBER; row++ )
+  {
+    gradientList[ row ] = -problem->offsetList[ row ];
+    for( size_t column = 0; column < PARAMETERS_NUMBER; column++ )
+      gradientList[ row ] += problem->hessianList[ column * PARAMETERS_NUMBER + row ] * parametersList[ column ];
+    *value += 0.5 * parametersList[ row ] * ( gradientList[ row ] - problem->offsetList[ row ] );
+  }
+  return true;
+}
+
+// Reference: dense solution of A x = b
+static void TestQuadratic( void )
+{
+  QuadraticProblem problem;
+  Matrix hessian = Test_FillPositiveDefinite( Mat_Create( NULL, PARAMETERS_NUMBER, PARAMETERS_NUMBER ), 0.5 );
+  Matrix offset = Test_FillRandom( Mat_Create( NULL, PARAMETERS_NUMBER, 1 ), 1.0 );
+  // Symmetric, so row-major data is the same
+  Mat_GetData( hessian, problem.hessianList );
+  Mat_GetColumn( offset, 0, problem.offsetList );
+  Matrix inverse = Mat_Inverse( hessian, Mat_Create( NULL, PARAMETERS_NUMBER, PARAMETERS_NUMBER ) );
+  Matrix reference = Mat_Dot( inverse, MATRIX_KEEP, offset, MATRIX_KEEP, Mat_Create( NULL, PARAMETERS_NUMBER, 1 ) );
+  
+  LBFGS minimizer = LBFGS_Create( PARAMETERS_NUMBER, MEMORY_LENGTH, EvaluateQuadratic, &problem );
+  TEST_CHECK( minimizer != NULL );
+  TEST_CHECK( LBFGS_SetSettings( minimizer, 1000, 1e-10, 0.0 ) );
+  double parametersList[ PARAMETERS_NUMBER ] = { 0.0 };
+  TEST_CHECK( LBFGS_Minimize( minimizer, parametersList ) );
+  double referenceValue = 0.0;
+  for( size_t parameter = 0; parameter < PARAMETERS_NUMBER; parameter++ )
+  {
+    TEST_CHECK_CLOSE( parametersList[ parameter ], Mat_GetElement( reference, parameter, 0 ), TOLERANCE );
+    referenceValue -= 0.5 * problem.offsetList[ parameter ] * Mat_GetElement( reference, parameter, 0 );
+  }
+  TEST_CHECK_CLOSE( LBFGS_GetValue( minimizer ), referenceValue, TOLERANCE );
+  TEST_CHECK( LBFGS_GetIterationsNumber( minimizer ) > 0 );
+  
+  Mat_Discard( hessian ); Mat_Discard( offset ); Mat_Discard( inverse ); Mat_Discard( reference );
+  LBFGS_Discard( minimizer );
+}
+
+// f = sum( ( i + 1 ) ( x[ i ] - 1 )^2 ), beyond matrix size limit
+static bool EvaluateSeparable( double* parametersList, double* gradientList, double* value, void* userData )
+{
+  (void) userData;
+  *value = 0.0;
+  for( size_t parameter = 0; parameter < LARGE_PARAMETERS_NUMBER; parameter++ )
+  {
+    double weight = 1.0 + parameter % 10, error = parametersList[ parameter ] - 1.0;
+    gradientList[ parameter ] = 2.0 * weight * error;
+    *value += weight * error * error;
+  }
+  return true;
+}
+
+static void TestLarge( void )
+{
+  double* parametersList = (double*) calloc( LARGE_PARAMETERS_NUMBER, sizeof(double) );
+  
+  LBFGS minimizer = LBFGS_Create( LARGE_PARAMETERS_NUMBER, MEMORY_LENGTH, EvaluateSeparable, NULL );
+  TEST_CHECK( minimizer != NULL );
+  TEST_CHECK( LBFGS_SetSettings( minimizer, 1000, 1e-8, 0.0 ) );
+  TEST_CHECK( LBFGS_Minimize( minimizer, parametersList ) );
+  double errorMax = 0.0;
+  for( size_t parameter = 0; parameter < LARGE_PARAMETERS_NUMBER; parameter++ )
+    errorMax = fmax( errorMax, fabs( parametersList[ parameter ] - 1.0 ) );
+  TEST_CHECK_CLOSE( errorMax, 0.0, TOLERANCE );
+  
+  LBFGS_Discard( minimizer );
+  free( parametersList );
+}
+
+int main( void )
+{
+  srand( 1 );
+  
+  TestQuadratic();
+  TestLarge();
+  
+  TEST_CHECK( LBFGS_Create( PARAMETERS_NUMBER, MEMORY_LENGTH, NULL, NULL ) == NULL );
+  
+  return Test_GetResult( "lbfgs" );
+}
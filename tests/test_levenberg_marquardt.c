@@ -0,0 +1,121 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include "test_utils.h"
+#include "levenberg_marquardt.h"
+
+
+#define TOLERANCE 1e-6
+#define PARAMETERS_NUMBER 3
+#define RESIDUALS_NUMBER 12
+
+typedef struct _LinearProblem { Matrix design, targets; } LinearProblem;
+
+// r = A p - b
+static bool EvaluateLinearResiduals( Matrix parameters, Matrix residuals, void* userData )
+{
+  LinearProblem* problem = (LinearProblem*) userData;
+  Mat_Dot( problem->design, MATRIX_KEEP, parameters, MATRIX_KEEP, residuals );
+  Mat_Sum( residuals, 1.0, problem->targets, -1.0, residuals );
+  return true;
+}
+
+static bool EvaluateLinearJacobian( Matrix parameters, Matrix jacobian, void* userData )
+{
+  (void) parameters;
+  LinearProblem* problem = (LinearProblem*) userData;
+  Mat_Copy( problem->design, jacobian );
+  return true;
+}
+
+// Reference: dense normal equations solution ( A^T A )^-1 A^T b
+static void TestLinear( void )
+{
+  LinearProblem problem;
+  problem.design = Test_FillRandom( Mat_Create( NULL, RESIDUALS_NUMBER, PARAMETERS_NUMBER ), 1.0 );
+  problem.targets = Test_FillRandom( Mat_Create( NULL, RESIDUALS_NUMBER, 1 ), 1.0 );
+  Matrix normalMatrix = Mat_Dot( problem.design, MATRIX_TRANSPOSE, problem.design, MATRIX_KEEP, Mat_Create( NULL, PARAMETERS_NUMBER, PARAMETERS_NUMBER ) );
+  Matrix projection = Mat_Dot( problem.design, MATRIX_TRANSPOSE, problem.targets, MATRIX_KEEP, Mat_Create( NULL, PARAMETERS_NUMBER, 1 ) );
+  Mat_Inverse( normalMatrix, normalMatrix );
+  Matrix reference = Mat_Dot( normalMatrix, MATRIX_KEEP, projection, MATRIX_KEEP, Mat_Create( NULL, PARAMETERS_NUMBER, 1 ) );
+  Matrix parameters = Mat_Create( NULL, 1, PARAMETERS_NUMBER );
+  
+  // Analytical and finite differences Jacobians
+  for( size_t hasJacobian = 0; hasJacobian < 2; hasJacobian++ )
+  {
+    LevenbergMarquardt solver = LevenbergMarquardt_Create( PARAMETERS_NUMBER, RESIDUALS_NUMBER, EvaluateLinearResiduals, 
+                                                           hasJacobian ? EvaluateLinearJacobian : NULL, &problem );
+    TEST_CHECK( solver != NULL );
+    Mat_Clear( parameters );
+    TEST_CHECK( LevenbergMarquardt_Solve( solver, parameters ) );
+    TEST_CHECK( Mat_GetHeight( parameters ) == 1 );
+    for( size_t parameter = 0; parameter < PARAMETERS_NUMBER; parameter++ )
+      TEST_CHECK_CLOSE( Mat_GetElement( parameters, 0, parameter ), Mat_GetElement( reference, parameter, 0 ), TOLERANCE );
+    LevenbergMarquardt_Discard( solver );
+  }
+  
+  Mat_Discard( problem.design ); Mat_Discard( problem.targets ); Mat_Discard( normalMatrix ); Mat_Discard( projection );
+  Mat_Discard( reference ); Mat_Discard( parameters );
+}
+
+// r[ i ] = a exp( -b t[ i ] ) + c - y[ i ], with exact data
+static bool EvaluateExponentialResiduals( Matrix parameters, Matrix residuals, void* userData )
+{
+  double* targetsList = (double*) userData;
+  for( size_t sample = 0; sample < RESIDUALS_NUMBER; sample++ )
+  {
+    double time = 0.25 * sample;
+    double model = Mat_GetElement( parameters, 0, 0 ) * exp( -Mat_GetElement( parameters, 1, 0 ) * time ) + Mat_GetElement( parameters, 2, 0 );
+    Mat_SetElement( residuals, sample, 0, model - targetsList[ sample ] );
+  }
+  return true;
+}
+
+static void TestExponential( void )
+{
+  double referenceList[ PARAMETERS_NUMBER ] = { 3.0, 0.7, 0.5 };
+  double targetsList[ RESIDUALS_NUMBER ];
+  for( size_t sample = 0; sample < RESIDUALS_NUMBER; sample++ )
+    targetsList[ sample ] = referenceList[ 0 ] * exp( -referenceList[ 1 ] * 0.25 * sample ) + referenceList[ 2 ];
+  Matrix parameters = Mat_Create( (double[ PARAMETERS_NUMBER ]){ 1.0, 0.1, 0.0 }, PARAMETERS_NUMBER, 1 );
+  
+  LevenbergMarquardt solver = LevenbergMarquardt_Create( PARAMETERS_NUMBER, RESIDUALS_NUMBER, EvaluateExponentialResiduals, NULL, targetsList );
+  TEST_CHECK( solver != NULL );
+  TEST_CHECK( LevenbergMarquardt_Solve( solver, parameters ) );
+  for( size_t parameter = 0; parameter < PARAMETERS_NUMBER; parameter++ )
+    TEST_CHECK_CLOSE( Mat_GetElement( parameters, parameter, 0 ), referenceList[ parameter ], TOLERANCE );
+  TEST_CHECK_CLOSE( LevenbergMarquardt_GetCost( solver ), 0.0, TOLERANCE );
+  
+  Mat_Discard( parameters );
+  LevenbergMarquardt_Discard( solver );
+}
+
+int main( void )
+{
+  srand( 1 );
+  
+  TestLinear();
+  TestExponential();
+  
+  return Test_GetResult( "levenberg_marquardt" );
+}
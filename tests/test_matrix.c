@@ -0,0 +1,840 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <stdint.h>
+#include <string.h>
+
+#include "test_utils.h"
+
+
+#define TOLERANCE 1e-9
+
+// Reference: matrix created from the same values in row-major order
+static void TestCreationModes( void )
+{
+  double rowMajorList[ 6 ] = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+  double columnMajorList[ 6 ] = { 1.0, 4.0, 2.0, 5.0, 3.0, 6.0 };
+  Matrix reference = Mat_Create( rowMajorList, 2, 3 );
+  Matrix matrix = Mat_CreateFromColumnMajor( columnMajorList, 2, 3 );
+  
+  TEST_CHECK( matrix != NULL );
+  TEST_CHECK_CLOSE( Test_GetMaxDifference( matrix, reference ), 0.0, 0.0 );
+  
+  Matrix like = Mat_CreateLike( reference );
+  TEST_CHECK( like != NULL && Mat_GetHeight( like ) == 2 && Mat_GetWidth( like ) == 3 );
+  Matrix uninitialized = Mat_CreateUninitialized( 3, 2 );
+  TEST_CHECK( uninitialized != NULL && Mat_GetHeight( uninitialized ) == 3 && Mat_GetWidth( uninitialized ) == 2 );
+  
+  TEST_CHECK( Mat_CreateFromColumnMajor( NULL, 2, 3 ) == NULL );
+  TEST_CHECK( Mat_CreateLike( NULL ) == NULL );
+  TEST_CHECK( Mat_CreateUninitialized( MATRIX_SIZE_MAX + 1, 1 ) == NULL );
+  
+  Mat_Discard( reference ); Mat_Discard( matrix ); Mat_Discard( like ); Mat_Discard( uninitialized );
+}
+
+// White box access: matrix headers start with their data buffer pointer (struct _MatrixData in matrix.c)
+static uintptr_t GetDataAddress( Matrix matrix )
+{
+  return (uintptr_t) *( (double**) matrix );
+}
+
+// Reference: buffers packed one after another, each starting at the next cache line, in the requested order
+static void TestGroups( void )
+{
+  const uintptr_t cacheLineSize = 64;
+  MatrixShape shapes[ 3 ] = { { 2, 2 }, { 3, 1 }, { 4, 4 } };
+  size_t orderLists[ 2 ][ 3 ] = { { 0, 1, 2 }, { 2, 0, 1 } };
+  Matrix groupList[ 3 ];
+  
+  for( size_t orderIndex = 0; orderIndex < 2; orderIndex++ )
+  {
+    size_t* order = orderLists[ orderIndex ];
+    // List order is the default one
+    TEST_CHECK( Mat_CreateGroup( 3, shapes, ( orderIndex > 0 ) ? order : NULL, groupList ) == groupList );
+    uintptr_t nextAddress = GetDataAddress( groupList[ order[ 0 ] ] );
+    for( size_t position = 0; position < 3; position++ )
+    {
+      Matrix member = groupList[ order[ position ] ];
+      uintptr_t address = GetDataAddress( member );
+      TEST_CHECK( address % cacheLineSize == 0 );
+      TEST_CHECK( address == ( ( nextAddress + cacheLineSize - 1 ) & ~( cacheLineSize - 1 ) ) );
+      nextAddress = address + Mat_GetHeight( member ) * Mat_GetWidth( member ) * sizeof(double);
+      TEST_CHECK( Mat_GetHeight( member ) == shapes[ order[ position ] ].rowsNumber && Mat_GetWidth( member ) == shapes[ order[ position ] ].columnsNumber );
+      TEST_CHECK_CLOSE( Mat_GetElement( member, 0, 0 ), 0.0, 0.0 );
+    }
+    
+    // Copies must fit the allocated space of a member, without spilling into the next one
+    Matrix large = Test_FillRandom( Mat_Create( NULL, 4, 4 ), 1.0 ), small = Test_FillRandom( Mat_Create( NULL, 1, 3 ), 1.0 );
+    Mat_SetElement( groupList[ 1 ], 0, 0, 1.0 );
+    TEST_CHECK( Mat_Copy( large, groupList[ 0 ] ) == NULL );
+    TEST_CHECK( Mat_Copy( small, groupList[ 0 ] ) == groupList[ 0 ] );
+    TEST_CHECK_CLOSE( Test_GetMaxDifference( groupList[ 0 ], small ), 0.0, 0.0 );
+    TEST_CHECK_CLOSE( Mat_GetElement( groupList[ 1 ], 0, 0 ), 1.0, 0.0 );
+    
+    Mat_DiscardGroup( groupList[ 1 ] );
+    Mat_Discard( large ); Mat_Discard( small );
+  }
+  
+  // Access orders must be permutations of list indexes
+  TEST_CHECK( Mat_CreateGroup( 3, shapes, (size_t[]){ 0, 2, 0 }, groupList ) == NULL );
+  TEST_CHECK( Mat_CreateGroup( 3, shapes, (size_t[]){ 0, 1, 3 }, groupList ) == NULL );
+  TEST_CHECK( Mat_CreateGroup( 0, shapes, NULL, groupList ) == NULL );
+}
+
+// Reference: contents before locking and growing (lock checks are skipped where memory locking is not permitted)
+static void TestLocking( void )
+{
+  Matrix matrix = Test_FillRandom( Mat_Create( NULL, 3, 4 ), 1.0 );
+  Matrix reference = Mat_Copy( matrix, Mat_Create( NULL, 3, 4 ) );
+  
+  if( !Mat_Lock( matrix ) ) 
+  {
+    printf( "matrix: memory locking not permitted, skipping lock checks\n" );
+    Mat_Discard( matrix ); Mat_Discard( reference );
+    return;
+  }
+  TEST_CHECK_CLOSE( Test_GetMaxDifference( matrix, reference ), 0.0, 0.0 );
+  
+  // Growing matrix is moved to a new (locked) buffer, keeping old values and zeroing new ones
+  TEST_CHECK( Mat_Resize( matrix, 5, 6 ) == matrix );
+  TEST_CHECK( Mat_GetHeight( matrix ) == 5 && Mat_GetWidth( matrix ) == 6 );
+  for( size_t row = 0; row < 5; row++ )
+  {
+    for( size_t column = 0; column < 6; column++ )
+    {
+      double value = ( row < 3 && column < 4 ) ? Mat_GetElement( reference, row, column ) : 0.0;
+      TEST_CHECK_CLOSE( Mat_GetElement( matrix, row, column ), value, 0.0 );
+    }
+  }
+  Mat_Unlock( matrix );
+  Mat_Unlock( matrix );
+  
+  // Group members share their block lock
+  Matrix groupList[ 2 ];
+  TEST_CHECK( Mat_CreateGroup( 2, (MatrixShape[]){ { 2, 2 }, { 3, 3 } }, NULL, groupList ) != NULL );
+  TEST_CHECK( Mat_Lock( groupList[ 0 ] ) && Mat_Lock( groupList[ 1 ] ) );
+  Mat_Unlock( groupList[ 0 ] );
+  Mat_SetElement( groupList[ 1 ], 2, 2, 1.0 );
+  TEST_CHECK_CLOSE( Mat_GetElement( groupList[ 1 ], 2, 2 ), 1.0, 0.0 );
+  Mat_DiscardGroup( groupList[ 0 ] );
+  
+  Mat_Discard( matrix ); Mat_Discard( reference );
+}
+
+// Reference: element by element reads
+static void TestRowsColumns( void )
+{
+  const size_t rowsNumber = 4, columnsNumber = 3;
+  double rowArray[ 3 ], columnArray[ 4 ];
+  Matrix matrix = Test_FillRandom( Mat_Create( NULL, rowsNumber, columnsNumber ), 1.0 );
+  Matrix reference = Mat_Copy( matrix, Mat_Create( NULL, rowsNumber, columnsNumber ) );
+  
+  TEST_CHECK( Mat_GetRow( matrix, 2, rowArray ) == rowArray );
+  for( size_t column = 0; column < columnsNumber; column++ )
+    TEST_CHECK_CLOSE( rowArray[ column ], Mat_GetElement( reference, 2, column ), 0.0 );
+  TEST_CHECK( Mat_GetColumn( matrix, 1, columnArray ) == columnArray );
+  for( size_t row = 0; row < rowsNumber; row++ )
+    TEST_CHECK_CLOSE( columnArray[ row ], Mat_GetElement( reference, row, 1 ), 0.0 );
+  
+  // Round trips through other positions
+  Mat_SetRow( matrix, 0, rowArray );
+  Mat_SetColumn( matrix, 2, columnArray );
+  for( size_t column = 0; column < 2; column++ )
+    TEST_CHECK_CLOSE( Mat_GetElement( matrix, 0, column ), Mat_GetElement( reference, 2, column ), 0.0 );
+  for( size_t row = 0; row < rowsNumber; row++ )
+    TEST_CHECK_CLOSE( Mat_GetElement( matrix, row, 2 ), Mat_GetElement( reference, row, 1 ), 0.0 );
+  
+  Mat_Copy( reference, matrix );
+  TEST_CHECK( Mat_SwapRows( matrix, 0, 3 ) == matrix );
+  TEST_CHECK( Mat_SwapColumns( matrix, 0, 2 ) == matrix );
+  for( size_t row = 0; row < rowsNumber; row++ )
+  {
+    size_t referenceRow = ( row == 0 ) ? 3 : ( ( row == 3 ) ? 0 : row );
+    for( size_t column = 0; column < columnsNumber; column++ )
+      TEST_CHECK_CLOSE( Mat_GetElement( matrix, row, column ), Mat_GetElement( reference, referenceRow, columnsNumber - 1 - column ), 0.0 );
+  }
+  // Swapping twice restores the original, and swapping a line with itself changes nothing
+  Mat_SwapRows( matrix, 3, 0 );
+  Mat_SwapColumns( matrix, 2, 0 );
+  Mat_SwapRows( matrix, 1, 1 );
+  TEST_CHECK_CLOSE( Test_GetMaxDifference( matrix, reference ), 0.0, 0.0 );
+  
+  TEST_CHECK( Mat_GetRow( matrix, rowsNumber, rowArray ) == NULL );
+  TEST_CHECK( Mat_SwapRows( matrix, 0, rowsNumber ) == NULL );
+  TEST_CHECK( Mat_SwapColumns( matrix, columnsNumber, 0 ) == NULL );
+  
+  Mat_Discard( matrix ); Mat_Discard( reference );
+}
+
+// Reference: element by element indexing
+static void TestGatherScatter( void )
+{
+  const size_t rowsNumber = 4, columnsNumber = 5;
+  size_t rowIndexes[ 3 ] = { 3, 0, 3 }, columnIndexes[ 2 ] = { 4, 1 };
+  Matrix matrix = Test_FillRandom( Mat_Create( NULL, rowsNumber, columnsNumber ), 1.0 );
+  Matrix reference = Mat_Copy( matrix, Mat_Create( NULL, rowsNumber, columnsNumber ) );
+  Matrix result = Mat_Create( NULL, rowsNumber, columnsNumber );
+  
+  // Result is reshaped to gathered dimensions, and NULL lists take all lines in order
+  TEST_CHECK( Mat_Gather( matrix, rowIndexes, 3, columnIndexes, 2, result ) == result );
+  TEST_CHECK( Mat_GetHeight( result ) == 3 && Mat_GetWidth( result ) == 2 );
+  for( size_t row = 0; row < 3; row++ )
+  {
+    for( size_t column = 0; column < 2; column++ )
+      TEST_CHECK_CLOSE( Mat_GetElement( result, row, column ), Mat_GetElement( reference, rowIndexes[ row ], columnIndexes[ column ] ), 0.0 );
+  }
+  TEST_CHECK( Mat_Gather( matrix, NULL, 0, columnIndexes, 2, result ) == result );
+  TEST_CHECK( Mat_GetHeight( result ) == rowsNumber && Mat_GetWidth( result ) == 2 );
+  for( size_t row = 0; row < rowsNumber; row++ )
+    TEST_CHECK_CLOSE( Mat_GetElement( result, row, 1 ), Mat_GetElement( reference, row, 1 ), 0.0 );
+  
+  // In place gather
+  TEST_CHECK( Mat_Gather( matrix, rowIndexes, 3, NULL, 0, matrix ) == matrix );
+  TEST_CHECK( Mat_GetHeight( matrix ) == 3 && Mat_GetWidth( matrix ) == columnsNumber );
+  for( size_t row = 0; row < 3; row++ )
+  {
+    for( size_t column = 0; column < columnsNumber; column++ )
+      TEST_CHECK_CLOSE( Mat_GetElement( matrix, row, column ), Mat_GetElement( reference, rowIndexes[ row ], column ), 0.0 );
+  }
+  
+  // Out of range indexes are rejected without changing the result
+  Mat_Copy( reference, result );
+  TEST_CHECK( Mat_Gather( reference, (size_t[]){ 0, rowsNumber }, 2, NULL, 0, result ) == NULL );
+  TEST_CHECK_CLOSE( Test_GetMaxDifference( result, reference ), 0.0, 0.0 );
+  
+  // Scatter overwrites (last write wins on repeated indexes), while scatter-add accumulates every contribution
+  Matrix source = Test_FillRandom( Mat_Create( NULL, 3, 2 ), 1.0 );
+  TEST_CHECK( Mat_Scatter( source, rowIndexes, columnIndexes, result ) == result );
+  TEST_CHECK_CLOSE( Mat_GetElement( result, 0, 4 ), Mat_GetElement( source, 1, 0 ), 0.0 );
+  TEST_CHECK_CLOSE( Mat_GetElement( result, 3, 1 ), Mat_GetElement( source, 2, 1 ), 0.0 );
+  TEST_CHECK_CLOSE( Mat_GetElement( result, 1, 1 ), Mat_GetElement( reference, 1, 1 ), 0.0 );
+  Mat_Copy( reference, result );
+  TEST_CHECK( Mat_ScatterAdd( source, rowIndexes, columnIndexes, result ) == result );
+  for( size_t column = 0; column < 2; column++ )
+  {
+    size_t targetColumn = columnIndexes[ column ];
+    double sum = Mat_GetElement( reference, 3, targetColumn ) + Mat_GetElement( source, 0, column ) + Mat_GetElement( source, 2, column );
+    TEST_CHECK_CLOSE( Mat_GetElement( result, 3, targetColumn ), sum, TOLERANCE );
+    TEST_CHECK_CLOSE( Mat_GetElement( result, 0, targetColumn ), Mat_GetElement( reference, 0, targetColumn ) + Mat_GetElement( source, 1, column ), TOLERANCE );
+  }
+  TEST_CHECK( Mat_ScatterAdd( source, (size_t[]){ 0, 1, rowsNumber }, NULL, result ) == NULL );
+  TEST_CHECK( Mat_Scatter( result, NULL, NULL, result ) == NULL );
+  
+  Mat_Discard( matrix ); Mat_Discard( reference ); Mat_Discard( result ); Mat_Discard( source );
+}
+
+// Reference: P A = L U, rebuilt from the packed factors
+static void TestLU( void )
+{
+  const size_t size = 6;
+  Matrix matrix = Test_FillRandom( Mat_Create( NULL, size, size ), 1.0 );
+  Matrix factors = Mat_Create( NULL, size, size ), lower = Mat_CreateSquare( size, 'I' ), upper = Mat_Create( NULL, size, size );
+  Matrix product = Mat_Create( NULL, size, size ), permuted = Mat_Create( NULL, size, size );
+  Permutation permutation = Mat_CreatePermutation( size );
+  
+  TEST_CHECK( Mat_DecomposeLU( matrix, permutation, factors ) != NULL );
+  for( size_t row = 0; row < size; row++ )
+  {
+    for( size_t column = 0; column < size; column++ )
+    {
+      if( row > column ) Mat_SetElement( lower, row, column, Mat_GetElement( factors, row, column ) );
+      else Mat_SetElement( upper, row, column, Mat_GetElement( factors, row, column ) );
+    }
+  }
+  Mat_Dot( lower, MATRIX_KEEP, upper, MATRIX_KEEP, product );
+  Mat_PermuteRows( matrix, permutation, permuted );
+  TEST_CHECK_CLOSE( Test_GetMaxDifference( product, permuted ), 0.0, TOLERANCE );
+  
+  // det( A ) det( A^-1 ) = 1, and a single row exchange flips the sign
+  Matrix inverse = Mat_Inverse( matrix, Mat_Create( NULL, size, size ) );
+  TEST_CHECK_CLOSE( Mat_Determinant( matrix ) * Mat_Determinant( inverse ), 1.0, TOLERANCE );
+  Matrix exchange = Mat_Create( (double[]){ 0.0, 1.0, 1.0, 0.0 }, 2, 2 );
+  TEST_CHECK_CLOSE( Mat_Determinant( exchange ), -1.0, TOLERANCE );
+  
+  Mat_Discard( matrix ); Mat_Discard( factors ); Mat_Discard( lower ); Mat_Discard( upper );
+  Mat_Discard( product ); Mat_Discard( permuted ); Mat_Discard( inverse ); Mat_Discard( exchange );
+  Mat_DiscardPermutation( permutation );
+}
+
+// Reference: element by element differences, and hashes of modified copies
+static void TestComparison( void )
+{
+  Matrix matrix = Test_FillRandom( Mat_Create( NULL, 3, 4 ), 1.0 );
+  Matrix copy = Mat_Copy( matrix, Mat_Create( NULL, 3, 4 ) );
+  Matrix reshaped = Mat_Create( NULL, 4, 3 );
+  
+  TEST_CHECK( Mat_ApproxEqual( matrix, copy, 0.0, 0.0 ) );
+  TEST_CHECK_CLOSE( Mat_MaxAbsDiff( matrix, copy ), 0.0, 0.0 );
+  TEST_CHECK( Mat_GetFingerprint( matrix ) == Mat_GetFingerprint( copy ) );
+  
+  // Absolute and relative tolerances: |a - b| <= absolute + relative * max( |a|, |b| )
+  Mat_SetElement( copy, 1, 2, Mat_GetElement( matrix, 1, 2 ) + 1e-6 );
+  TEST_CHECK_CLOSE( Mat_MaxAbsDiff( matrix, copy ), Test_GetMaxDifference( matrix, copy ), 0.0 );
+  TEST_CHECK( !Mat_ApproxEqual( matrix, copy, 1e-7, 0.0 ) );
+  TEST_CHECK( Mat_ApproxEqual( matrix, copy, 2e-6, 0.0 ) );
+  Mat_SetElement( matrix, 1, 2, 1000.0 ); Mat_SetElement( copy, 1, 2, 1000.001 );
+  TEST_CHECK( Mat_ApproxEqual( matrix, copy, 0.0, 2e-6 ) && !Mat_ApproxEqual( matrix, copy, 0.0, 5e-7 ) );
+  TEST_CHECK( Mat_GetFingerprint( matrix ) != Mat_GetFingerprint( copy ) );
+  
+  // Same contents (in storage order) with a different shape
+  for( size_t index = 0; index < 12; index++ )
+    Mat_SetElement( reshaped, index % 4, index / 4, Mat_GetElement( matrix, index % 3, index / 3 ) );
+  TEST_CHECK( Mat_GetFingerprint( reshaped ) != Mat_GetFingerprint( matrix ) );
+  TEST_CHECK( !Mat_ApproxEqual( matrix, reshaped, INFINITY, 0.0 ) );
+  TEST_CHECK( Mat_MaxAbsDiff( matrix, reshaped ) == INFINITY );
+  
+  // NaN never compares equal, while infinities only match themselves
+  TEST_CHECK( !Mat_HasNonFinite( matrix ) );
+  Mat_Copy( matrix, copy );
+  Mat_SetElement( copy, 2, 3, NAN );
+  TEST_CHECK( Mat_HasNonFinite( copy ) );
+  TEST_CHECK( !Mat_ApproxEqual( copy, copy, INFINITY, 0.0 ) );
+  TEST_CHECK( isnan( Mat_MaxAbsDiff( matrix, copy ) ) );
+  Mat_SetElement( copy, 2, 3, -INFINITY );
+  TEST_CHECK( Mat_HasNonFinite( copy ) );
+  TEST_CHECK( !Mat_ApproxEqual( matrix, copy, 1.0, 0.0 ) );
+  
+  TEST_CHECK( !Mat_ApproxEqual( matrix, NULL, 1.0, 1.0 ) );
+  TEST_CHECK( Mat_GetFingerprint( NULL ) == 0 );
+  
+  Mat_Discard( matrix ); Mat_Discard( copy ); Mat_Discard( reshaped );
+}
+
+// Checks that 2 matrices have bitwise identical elements
+static bool HasSameBits( Matrix matrix, Matrix reference, size_t rowsNumber, size_t columnsNumber )
+{
+  for( size_t row = 0; row < rowsNumber; row++ )
+  {
+    for( size_t column = 0; column < columnsNumber; column++ )
+    {
+      double value = Mat_GetElement( matrix, row, column ), referenceValue = Mat_GetElement( reference, row, column );
+      if( memcmp( &value, &referenceValue, sizeof(double) ) != 0 ) return false;
+    }
+  }
+  return true;
+}
+
+// Reference: bits of the same reproducible product, repeated and from differently stored/padded operands (crossing tile edges)
+static void TestReproducible( void )
+{
+  const size_t rowsNumber = 33, couplingLength = 66, columnsNumber = 9, padding = 2;
+  Matrix left = Test_FillRandom( Mat_Create( NULL, rowsNumber, couplingLength ), 1.0 ), right = Test_FillRandom( Mat_Create( NULL, couplingLength, columnsNumber ), 1.0 );
+  Matrix leftTransposed = Mat_Create( NULL, couplingLength, rowsNumber );
+  Matrix leftPadded = Mat_Create( NULL, rowsNumber + padding, couplingLength + padding );
+  Matrix rightPadded = Mat_Create( NULL, couplingLength + padding, columnsNumber + padding );
+  Matrix result = Mat_Create( NULL, rowsNumber, columnsNumber ), repeated = Mat_Create( NULL, rowsNumber, columnsNumber );
+  Matrix reference = Mat_Create( NULL, rowsNumber, columnsNumber ), padded = Mat_Create( NULL, rowsNumber + padding, columnsNumber + padding );
+  
+  Mat_Dot( left, MATRIX_KEEP, right, MATRIX_KEEP, reference );
+  Mat_SetReproducible( true );
+  TEST_CHECK( Mat_Dot( left, MATRIX_KEEP, right, MATRIX_KEEP, result ) == result );
+  TEST_CHECK( Mat_ApproxEqual( result, reference, TOLERANCE, TOLERANCE ) );
+  Mat_Dot( left, MATRIX_KEEP, right, MATRIX_KEEP, repeated );
+  TEST_CHECK( HasSameBits( repeated, result, rowsNumber, columnsNumber ) );
+  
+  for( size_t row = 0; row < rowsNumber; row++ )
+  {
+    for( size_t index = 0; index < couplingLength; index++ )
+      Mat_SetElement( leftTransposed, index, row, Mat_GetElement( left, row, index ) );
+  }
+  Mat_Dot( leftTransposed, MATRIX_TRANSPOSE, right, MATRIX_KEEP, repeated );
+  TEST_CHECK( HasSameBits( repeated, result, rowsNumber, columnsNumber ) );
+  
+  // Operands with extra zero rows/columns: trailing zero products don't change the sums, while tiles and edge blocks move
+  for( size_t index = 0; index < couplingLength; index++ )
+  {
+    for( size_t row = 0; row < rowsNumber; row++ )
+      Mat_SetElement( leftPadded, row, index, Mat_GetElement( left, row, index ) );
+    for( size_t column = 0; column < columnsNumber; column++ )
+      Mat_SetElement( rightPadded, index, column, Mat_GetElement( right, index, column ) );
+  }
+  Mat_Dot( leftPadded, MATRIX_KEEP, rightPadded, MATRIX_KEEP, padded );
+  TEST_CHECK( HasSameBits( padded, result, rowsNumber, columnsNumber ) );
+  Mat_SetReproducible( false );
+  
+  // Reductions: repeated calls, and the same elements in another shape
+  Matrix vector = Mat_Create( NULL, rowsNumber * columnsNumber, 1 );
+  for( size_t column = 0; column < columnsNumber; column++ )
+  {
+    for( size_t row = 0; row < rowsNumber; row++ )
+      Mat_SetElement( vector, column * rowsNumber + row, 0, Mat_GetElement( result, row, column ) );
+  }
+  double sum = Mat_SumElements( result ), norm = Mat_Norm( result );
+  double sumsList[ 3 ] = { sum, Mat_SumElements( result ), Mat_SumElements( vector ) };
+  double normsList[ 3 ] = { norm, Mat_Norm( result ), Mat_Norm( vector ) };
+  for( size_t index = 1; index < 3; index++ )
+  {
+    TEST_CHECK( memcmp( &(sumsList[ index ]), &sum, sizeof(double) ) == 0 );
+    TEST_CHECK( memcmp( &(normsList[ index ]), &norm, sizeof(double) ) == 0 );
+  }
+  TEST_CHECK_CLOSE( norm * norm, Mat_InnerProduct( result, result ), TOLERANCE );
+  
+  Mat_Discard( left ); Mat_Discard( right ); Mat_Discard( leftTransposed ); Mat_Discard( leftPadded ); Mat_Discard( rightPadded );
+  Mat_Discard( result ); Mat_Discard( repeated ); Mat_Discard( reference ); Mat_Discard( padded ); Mat_Discard( vector );
+}
+
+static size_t shadowCallsNumber = 0;
+
+// Records mismatches reported by shadow verification
+static void CountMismatch( const char* operationName, Matrix* inputsList, size_t inputsNumber, Matrix fastResult, Matrix referenceResult, double maxDifference )
+{
+  shadowCallsNumber++;
+  TEST_CHECK( strncmp( operationName, "Dot(", 4 ) == 0 );
+  TEST_CHECK( inputsNumber == 2 && inputsList[ 0 ] != NULL && inputsList[ 1 ] != NULL );
+  TEST_CHECK( Mat_MaxAbsDiff( fastResult, referenceResult ) == maxDifference || isnan( maxDifference ) );
+}
+
+// Reference: sampled calls counted by the sampling credit, and mismatches reported through the callback
+static void TestShadowVerification( void )
+{
+  const size_t size = 24;
+  Matrix left = Test_FillRandom( Mat_Create( NULL, size, size ), 1.0 ), right = Test_FillRandom( Mat_Create( NULL, size, size ), 1.0 );
+  Matrix result = Mat_Create( NULL, size, size );
+  size_t checksNumber;
+  
+  // Fast paths are only taken (and verified) in reproducible mode
+  Mat_SetReproducible( true );
+  Mat_SetShadowVerification( 0.5, 1e-9, CountMismatch );
+  for( size_t callIndex = 0; callIndex < 10; callIndex++ )
+    Mat_Dot( left, MATRIX_KEEP, right, MATRIX_TRANSPOSE, result );
+  TEST_CHECK( Mat_GetShadowMismatches( &checksNumber ) == 0 );
+  TEST_CHECK( checksNumber == 5 );
+  TEST_CHECK( shadowCallsNumber == 0 );
+  
+  // A tolerance below rounding differences reports any result not bitwise equal to the BLAS one
+  Mat_SetShadowVerification( 1.0, 1e-300, CountMismatch );
+  TEST_CHECK( Mat_GetShadowMismatches( &checksNumber ) == 0 && checksNumber == 0 );
+  for( size_t callIndex = 0; callIndex < 4; callIndex++ )
+    Mat_Dot( left, MATRIX_TRANSPOSE, right, MATRIX_KEEP, result );
+  TEST_CHECK( Mat_GetShadowMismatches( &checksNumber ) == shadowCallsNumber );
+  TEST_CHECK( checksNumber == 4 );
+  
+  // NaN results never match, whatever the tolerance
+  size_t mismatchesNumber = Mat_GetShadowMismatches( NULL );
+  Mat_SetElement( left, 0, 0, NAN );
+  Mat_Dot( left, MATRIX_KEEP, right, MATRIX_KEEP, result );
+  TEST_CHECK( Mat_GetShadowMismatches( NULL ) == mismatchesNumber + 1 );
+  TEST_CHECK( shadowCallsNumber == mismatchesNumber + 1 );
+  
+  // Disabled verification
+  Mat_SetShadowVerification( 0.0, 1e-9, NULL );
+  Mat_Dot( left, MATRIX_KEEP, right, MATRIX_KEEP, result );
+  TEST_CHECK( Mat_GetShadowMismatches( &checksNumber ) == 0 && checksNumber == 0 );
+  Mat_SetReproducible( false );
+  
+  Mat_Discard( left ); Mat_Discard( right ); Mat_Discard( result );
+}
+
+// Reference: dense products with explicit op(T), whose ignored triangle and (unit) diagonal are filled with other values
+static void TestTriangular( void )
+{
+  const size_t sizesList[ 7 ] = { 1, 3, 4, 7, 8, 9, 12 }, columnsNumber = 3;
+  const char upperLowerList[ 2 ] = { MATRIX_LOWER, MATRIX_UPPER }, transposeList[ 2 ] = { MATRIX_KEEP, MATRIX_TRANSPOSE };
+  const char diagonalList[ 2 ] = { MATRIX_NON_UNIT_DIAGONAL, MATRIX_UNIT_DIAGONAL };
+  
+  for( size_t sizeIndex = 0; sizeIndex < 7; sizeIndex++ )
+  {
+    size_t size = sizesList[ sizeIndex ];
+    Matrix triangular = Test_FillRandom( Mat_Create( NULL, size, size ), 1.0 ), dense = Mat_Create( NULL, size, size );
+    Matrix input = Test_FillRandom( Mat_Create( NULL, size, columnsNumber ), 1.0 );
+    Matrix result = Mat_Create( NULL, size, columnsNumber ), reference = Mat_Create( NULL, size, columnsNumber );
+    for( size_t line = 0; line < size; line++ )
+      Mat_SetElement( triangular, line, line, 4.0 + line );
+    for( size_t variant = 0; variant < 8; variant++ )
+    {
+      char upperLower = upperLowerList[ variant % 2 ], transpose = transposeList[ ( variant / 2 ) % 2 ], diagonal = diagonalList[ variant / 4 ];
+      for( size_t row = 0; row < size; row++ )
+      {
+        for( size_t column = 0; column < size; column++ )
+        {
+          bool isInTriangle = ( upperLower == MATRIX_LOWER ) ? ( row >= column ) : ( row <= column );
+          double value = isInTriangle ? Mat_GetElement( triangular, row, column ) : 0.0;
+          if( row == column && diagonal == MATRIX_UNIT_DIAGONAL ) value = 1.0;
+          Mat_SetElement( dense, row, column, value );
+        }
+      }
+      
+      Mat_Copy( input, result );
+      TEST_CHECK( Mat_TriangularMultiply( triangular, upperLower, transpose, diagonal, result ) == result );
+      Mat_Dot( dense, transpose, input, MATRIX_KEEP, reference );
+      TEST_CHECK_CLOSE( Mat_MaxAbsDiff( result, reference ), 0.0, TOLERANCE );
+      
+      // op(T) X = B, checked through its residual
+      Mat_Copy( input, result );
+      TEST_CHECK( Mat_TriangularSolve( triangular, upperLower, transpose, diagonal, result ) == result );
+      Mat_Dot( dense, transpose, result, MATRIX_KEEP, reference );
+      TEST_CHECK_CLOSE( Mat_MaxAbsDiff( reference, input ), 0.0, TOLERANCE );
+    }
+    
+    TEST_CHECK( Mat_TriangularSolve( triangular, MATRIX_LOWER, MATRIX_KEEP, MATRIX_NON_UNIT_DIAGONAL, triangular ) == NULL );
+    Mat_Discard( triangular ); Mat_Discard( dense ); Mat_Discard( input ); Mat_Discard( result ); Mat_Discard( reference );
+  }
+}
+
+// Reference: LU based inverse of a symmetric indefinite (KKT like) matrix
+static void TestLDLT( void )
+{
+  const size_t size = 6, constraintsNumber = 2;
+  Matrix matrix = Mat_Create( NULL, size, size );
+  Matrix block = Test_FillPositiveDefinite( Mat_Create( NULL, size - constraintsNumber, size - constraintsNumber ), 1.0 );
+  for( size_t row = 0; row < size; row++ )
+  {
+    for( size_t column = 0; column <= row; column++ )
+    {
+      double value = 0.0;
+      if( row < size - constraintsNumber ) value = Mat_GetElement( block, row, column );
+      else if( column < size - constraintsNumber ) value = 2.0 * rand() / RAND_MAX - 1.0;
+      Mat_SetElement( matrix, row, column, value );
+      Mat_SetElement( matrix, column, row, value );
+    }
+  }
+  Matrix input = Test_FillRandom( Mat_Create( NULL, size, 2 ), 1.0 );
+  Matrix solution = Mat_Copy( input, Mat_Create( NULL, size, 2 ) );
+  Matrix reference = Mat_Create( NULL, size, 2 );
+  Matrix inverse = Mat_Inverse( matrix, Mat_Create( NULL, size, size ) );
+  LDLTFactorization factorization = Mat_CreateLDLT( size );
+  
+  TEST_CHECK( Mat_DecomposeLDLT( matrix, factorization ) != NULL );
+  TEST_CHECK( Mat_SolveLDLT( factorization, solution ) != NULL );
+  Mat_Dot( inverse, MATRIX_KEEP, input, MATRIX_KEEP, reference );
+  TEST_CHECK_CLOSE( Mat_MaxAbsDiff( solution, reference ), 0.0, TOLERANCE );
+  
+  size_t positivesNumber, negativesNumber, zerosNumber;
+  TEST_CHECK( Mat_GetLDLTInertia( factorization, &positivesNumber, &negativesNumber, &zerosNumber ) );
+  TEST_CHECK( positivesNumber == size - constraintsNumber && negativesNumber == constraintsNumber && zerosNumber == 0 );
+  
+  Mat_Discard( matrix ); Mat_Discard( block ); Mat_Discard( input ); Mat_Discard( solution ); Mat_Discard( reference ); Mat_Discard( inverse );
+  Mat_DiscardLDLT( factorization );
+}
+
+// Reference: product of known rank factors, annihilated by the null space basis
+static void TestQRPivoted( void )
+{
+  const size_t rowsNumber = 8, columnsNumber = 6, rank = 3;
+  Matrix left = Test_FillRandom( Mat_Create( NULL, rowsNumber, rank ), 1.0 ), right = Test_FillRandom( Mat_Create( NULL, rank, columnsNumber ), 1.0 );
+  Matrix matrix = Mat_Dot( left, MATRIX_KEEP, right, MATRIX_KEEP, Mat_Create( NULL, rowsNumber, columnsNumber ) );
+  Matrix factor = Mat_Create( NULL, columnsNumber, columnsNumber );
+  Matrix nullSpace = Mat_Create( NULL, columnsNumber, columnsNumber - rank );
+  Matrix product = Mat_Create( NULL, rowsNumber, columnsNumber - rank );
+  Permutation permutation = Mat_CreatePermutation( columnsNumber );
+  
+  TEST_CHECK( Mat_DecomposeQRPivoted( matrix, 1e-10, false, permutation, factor ) == rank );
+  TEST_CHECK( Mat_GetNullSpace( factor, rank, permutation, nullSpace ) != NULL );
+  Mat_Dot( matrix, MATRIX_KEEP, nullSpace, MATRIX_KEEP, product );
+  TEST_CHECK_CLOSE( Mat_Norm( product ), 0.0, TOLERANCE );
+  
+  Mat_Discard( left ); Mat_Discard( right ); Mat_Discard( matrix ); Mat_Discard( factor ); Mat_Discard( nullSpace ); Mat_Discard( product );
+  Mat_DiscardPermutation( permutation );
+}
+
+// Reference: K v = lambda M v, and eigenvalues sum equal to trace( M^-1 K )
+static void TestGeneralizedEigen( void )
+{
+  const size_t size = 5;
+  Matrix stiffness = Test_FillPositiveDefinite( Mat_Create( NULL, size, size ), 0.5 );
+  Matrix mass = Test_FillPositiveDefinite( Mat_Create( NULL, size, size ), 2.0 );
+  Matrix values = Mat_Create( NULL, size, 1 ), vectors = Mat_Create( NULL, size, size );
+  Matrix stiffnessProduct = Mat_Create( NULL, size, size ), massProduct = Mat_Create( NULL, size, size );
+  Matrix inverse = Mat_Inverse( mass, Mat_Create( NULL, size, size ) );
+  Matrix reference = Mat_Dot( inverse, MATRIX_KEEP, stiffness, MATRIX_KEEP, Mat_Create( NULL, size, size ) );
+  MassFactorization factorization = Mat_CreateMassFactorization( size );
+  
+  TEST_CHECK( Mat_DecomposeMass( mass, factorization ) != NULL );
+  TEST_CHECK( Mat_GeneralizedEigen( stiffness, factorization, 0, values, vectors ) != NULL );
+  Mat_Dot( stiffness, MATRIX_KEEP, vectors, MATRIX_KEEP, stiffnessProduct );
+  Mat_Dot( mass, MATRIX_KEEP, vectors, MATRIX_KEEP, massProduct );
+  double residual = 0.0, trace = 0.0;
+  for( size_t mode = 0; mode < size; mode++ )
+  {
+    double value = Mat_GetElement( values, mode, 0 );
+    for( size_t row = 0; row < size; row++ )
+      residual = fmax( residual, fabs( Mat_GetElement( stiffnessProduct, row, mode ) - value * Mat_GetElement( massProduct, row, mode ) ) );
+    trace += Mat_GetElement( reference, mode, mode );
+    if( mode > 0 ) TEST_CHECK( value >= Mat_GetElement( values, mode - 1, 0 ) );
+  }
+  TEST_CHECK_CLOSE( residual, 0.0, TOLERANCE );
+  TEST_CHECK_CLOSE( Mat_SumElements( values ), trace, TOLERANCE );
+  
+  Mat_Discard( stiffness ); Mat_Discard( mass ); Mat_Discard( values ); Mat_Discard( vectors ); Mat_Discard( stiffnessProduct ); 
+  Mat_Discard( massProduct ); Mat_Discard( inverse ); Mat_Discard( reference );
+  Mat_DiscardMassFactorization( factorization );
+}
+
+// Reference: repeated dense products
+static void TestPolynomial( void )
+{
+  const size_t size = 6, coefficientsNumber = 9;
+  double coefficientsList[ 9 ] = { 1.0, -0.5, 0.25, 2.0, -1.0, 0.125, 0.5, -0.25, 1.5 };
+  Matrix matrix = Test_FillRandom( Mat_Create( NULL, size, size ), 0.5 );
+  Matrix power = Mat_CreateSquare( size, 'I' ), reference = Mat_Create( NULL, size, size );
+  Matrix result = Mat_Create( NULL, size, size ), product = Mat_Create( NULL, size, size );
+  
+  for( size_t exponent = 0; exponent < coefficientsNumber; exponent++ )
+  {
+    Mat_Sum( reference, 1.0, power, coefficientsList[ exponent ], reference );
+    TEST_CHECK( Mat_Power( matrix, exponent, result ) != NULL );
+    TEST_CHECK_CLOSE( Mat_MaxAbsDiff( result, power ), 0.0, TOLERANCE );
+    Mat_Dot( power, MATRIX_KEEP, matrix, MATRIX_KEEP, product );
+    Mat_Copy( product, power );
+  }
+  TEST_CHECK( Mat_Polynomial( coefficientsList, coefficientsNumber, matrix, result ) != NULL );
+  TEST_CHECK_CLOSE( Mat_MaxAbsDiff( result, reference ), 0.0, TOLERANCE );
+  
+  Mat_Discard( matrix ); Mat_Discard( power ); Mat_Discard( reference ); Mat_Discard( result ); Mat_Discard( product );
+}
+
+// Reference: direct sums, exact integrals of polynomials (t^2 + t for trapezoids over 2t + 1, t^3 / 3 for Simpson over t^2) and direct differences
+static void TestScans( void )
+{
+  const size_t samplesNumber = 7, linesNumber = 3;
+  const double timeStep = 0.25;
+  const char axesList[ 2 ] = { MATRIX_ALONG_COLUMNS, MATRIX_ALONG_ROWS };
+  
+  for( size_t axisIndex = 0; axisIndex < 2; axisIndex++ )
+  {
+    char axis = axesList[ axisIndex ];
+    bool isAlongColumns = ( axis == MATRIX_ALONG_COLUMNS );
+    // Even and odd samples numbers take different Simpson paths for the last interval
+    for( size_t length = samplesNumber - 1; length <= samplesNumber; length++ )
+    {
+      size_t rowsNumber = isAlongColumns ? length : linesNumber, columnsNumber = isAlongColumns ? linesNumber : length;
+      Matrix matrix = Test_FillRandom( Mat_Create( NULL, rowsNumber, columnsNumber ), 1.0 );
+      Matrix result = Mat_Create( NULL, rowsNumber, columnsNumber ), inPlace = Mat_Create( NULL, rowsNumber, columnsNumber );
+      Matrix linear = Mat_Create( NULL, rowsNumber, columnsNumber ), quadratic = Mat_Create( NULL, rowsNumber, columnsNumber );
+      for( size_t line = 0; line < linesNumber; line++ )
+      {
+        for( size_t position = 0; position < length; position++ )
+        {
+          double time = position * timeStep;
+          Mat_SetElement( linear, isAlongColumns ? position : line, isAlongColumns ? line : position, 2.0 * time + 1.0 + line );
+          Mat_SetElement( quadratic, isAlongColumns ? position : line, isAlongColumns ? line : position, time * time * ( line + 1 ) );
+        }
+      }
+      
+      TEST_CHECK( Mat_CumulativeSum( matrix, axis, result ) == result );
+      Mat_Copy( matrix, inPlace );
+      TEST_CHECK( Mat_CumulativeSum( inPlace, axis, inPlace ) == inPlace );
+      TEST_CHECK_CLOSE( Mat_MaxAbsDiff( inPlace, result ), 0.0, 0.0 );
+      for( size_t line = 0; line < linesNumber; line++ )
+      {
+        double sum = 0.0;
+        for( size_t position = 0; position < length; position++ )
+        {
+          size_t row = isAlongColumns ? position : line, column = isAlongColumns ? line : position;
+          sum += Mat_GetElement( matrix, row, column );
+          TEST_CHECK_CLOSE( Mat_GetElement( result, row, column ), sum, TOLERANCE );
+        }
+      }
+      
+      TEST_CHECK( Mat_Integrate( linear, timeStep, MATRIX_TRAPEZOIDAL_RULE, axis, result ) == result );
+      TEST_CHECK( Mat_Integrate( quadratic, timeStep, MATRIX_SIMPSON_RULE, axis, quadratic ) == quadratic );
+      for( size_t line = 0; line < linesNumber; line++ )
+      {
+        for( size_t position = 0; position < length; position++ )
+        {
+          size_t row = isAlongColumns ? position : line, column = isAlongColumns ? line : position;
+          double time = position * timeStep;
+          TEST_CHECK_CLOSE( Mat_GetElement( result, row, column ), time * time + ( 1.0 + line ) * time, TOLERANCE );
+          TEST_CHECK_CLOSE( Mat_GetElement( quadratic, row, column ), time * time * time / 3.0 * ( line + 1 ), TOLERANCE );
+        }
+      }
+      
+      TEST_CHECK( Mat_Difference( matrix, axis, result ) == result );
+      TEST_CHECK( Mat_GetHeight( result ) == rowsNumber - ( isAlongColumns ? 1 : 0 ) && Mat_GetWidth( result ) == columnsNumber - ( isAlongColumns ? 0 : 1 ) );
+      Mat_Copy( matrix, inPlace );
+      TEST_CHECK( Mat_Difference( inPlace, axis, inPlace ) == inPlace );
+      TEST_CHECK_CLOSE( Mat_MaxAbsDiff( inPlace, result ), 0.0, 0.0 );
+      for( size_t line = 0; line < linesNumber; line++ )
+      {
+        for( size_t position = 0; position + 1 < length; position++ )
+        {
+          size_t row = isAlongColumns ? position : line, column = isAlongColumns ? line : position;
+          double difference = isAlongColumns ? Mat_GetElement( matrix, row + 1, column ) - Mat_GetElement( matrix, row, column )
+                                             : Mat_GetElement( matrix, row, column + 1 ) - Mat_GetElement( matrix, row, column );
+          TEST_CHECK_CLOSE( Mat_GetElement( result, row, column ), difference, 0.0 );
+        }
+      }
+      
+      Mat_Discard( matrix ); Mat_Discard( result ); Mat_Discard( inPlace ); Mat_Discard( linear ); Mat_Discard( quadratic );
+    }
+  }
+  
+  Matrix matrix = Mat_Create( NULL, 2, 2 );
+  TEST_CHECK( Mat_CumulativeSum( matrix, 'X', matrix ) == NULL );
+  TEST_CHECK( Mat_Integrate( matrix, 1.0, 'X', MATRIX_ALONG_ROWS, matrix ) == NULL );
+  Mat_Discard( matrix );
+}
+
+// Reference: direct differences
+static void TestPairwiseSqDist( void )
+{
+  const size_t dimensionsNumber = 3, pointsNumber_1 = 5, pointsNumber_2 = 4;
+  Matrix points_1 = Test_FillRandom( Mat_Create( NULL, dimensionsNumber, pointsNumber_1 ), 2.0 );
+  Matrix points_2 = Test_FillRandom( Mat_Create( NULL, dimensionsNumber, pointsNumber_2 ), 2.0 );
+  Matrix distances = Mat_Create( NULL, pointsNumber_1, pointsNumber_2 );
+  
+  TEST_CHECK( Mat_PairwiseSqDist( points_1, points_2, distances ) != NULL );
+  for( size_t point_1 = 0; point_1 < pointsNumber_1; point_1++ )
+  {
+    for( size_t point_2 = 0; point_2 < pointsNumber_2; point_2++ )
+    {
+      double squaredDistance = 0.0;
+      for( size_t dimension = 0; dimension < dimensionsNumber; dimension++ )
+      {
+        double difference = Mat_GetElement( points_1, dimension, point_1 ) - Mat_GetElement( points_2, dimension, point_2 );
+        squaredDistance += difference * difference;
+      }
+      TEST_CHECK_CLOSE( Mat_GetElement( distances, point_1, point_2 ), squaredDistance, TOLERANCE );
+    }
+  }
+  
+  Mat_Discard( points_1 ); Mat_Discard( points_2 ); Mat_Discard( distances );
+}
+
+// Reference: reflector applied to the original vector gives [ beta; 0 ], with |beta| = ||x||
+static void TestHouseholder( void )
+{
+  const size_t size = 6;
+  Matrix matrix = Test_FillRandom( Mat_Create( NULL, size, 2 ), 1.0 );
+  MatrixBlock vector = { 0, 0, size, 1 }, target = { 0, 1, size, 1 };
+  
+  Mat_SetColumn( matrix, 1, Mat_GetColumn( matrix, 0, (double[ 6 ]){ 0.0 } ) );
+  double norm = sqrt( Mat_InnerProduct( matrix, matrix ) / 2.0 );
+  double tau = Mat_GenerateHouseholder( matrix, vector );
+  TEST_CHECK( Mat_ApplyHouseholder( matrix, vector, tau, MATRIX_FROM_LEFT, matrix, target ) != NULL );
+  TEST_CHECK_CLOSE( fabs( Mat_GetElement( matrix, 0, 1 ) ), norm, TOLERANCE );
+  TEST_CHECK_CLOSE( Mat_GetElement( matrix, 0, 1 ), Mat_GetElement( matrix, 0, 0 ), TOLERANCE );
+  for( size_t row = 1; row < size; row++ )
+    TEST_CHECK_CLOSE( Mat_GetElement( matrix, row, 1 ), 0.0, TOLERANCE );
+  
+  TEST_CHECK( Mat_GenerateHouseholder( NULL, vector ) == 0.0 );
+  
+  Mat_Discard( matrix );
+}
+
+// Reference: the same reflectors applied one by one (H = H_1 H_2 ... H_k), on both sides, with and without transposition
+static void TestHouseholderBlock( void )
+{
+  const size_t size = 6, reflectorsNumber = 3;
+  double tausList[ 3 ];
+  const char sidesList[ 2 ] = { MATRIX_FROM_LEFT, MATRIX_FROM_RIGHT }, transposeList[ 2 ] = { MATRIX_KEEP, MATRIX_TRANSPOSE };
+  // Vectors stored from an offset, as in a factorization of a trailing block
+  Matrix reflectors = Test_FillRandom( Mat_Create( NULL, size + 1, reflectorsNumber + 1 ), 1.0 );
+  MatrixBlock vectors = { 1, 1, size, reflectorsNumber };
+  for( size_t index = 0; index < reflectorsNumber; index++ )
+    tausList[ index ] = Mat_GenerateHouseholder( reflectors, (MatrixBlock){ 1 + index, 1 + index, size - index, 1 } );
+  
+  for( size_t variant = 0; variant < 4; variant++ )
+  {
+    char side = sidesList[ variant % 2 ], transpose = transposeList[ variant / 2 ];
+    bool isLeft = ( side == MATRIX_FROM_LEFT );
+    Matrix matrix = Test_FillRandom( Mat_Create( NULL, size + 2, size + 2 ), 1.0 );
+    Matrix reference = Mat_Copy( matrix, Mat_Create( NULL, size + 2, size + 2 ) );
+    MatrixBlock target = isLeft ? (MatrixBlock){ 2, 1, size, 4 } : (MatrixBlock){ 1, 2, 5, size };
+    
+    TEST_CHECK( Mat_ApplyHouseholderBlock( reflectors, vectors, tausList, side, transpose, matrix, target ) == matrix );
+    // H x B and B x H^T apply H_k first, H^T x B and B x H apply H_1 first
+    bool isLastFirst = ( isLeft == ( transpose == MATRIX_KEEP ) );
+    for( size_t step = 0; step < reflectorsNumber; step++ )
+    {
+      size_t index = isLastFirst ? reflectorsNumber - 1 - step : step;
+      MatrixBlock vector = { 1 + index, 1 + index, size - index, 1 };
+      MatrixBlock block = isLeft ? (MatrixBlock){ target.firstRow + index, target.firstColumn, size - index, target.columnsNumber }
+                                 : (MatrixBlock){ target.firstRow, target.firstColumn + index, target.rowsNumber, size - index };
+      Mat_ApplyHouseholder( reflectors, vector, tausList[ index ], side, reference, block );
+    }
+    TEST_CHECK_CLOSE( Mat_MaxAbsDiff( matrix, reference ), 0.0, TOLERANCE );
+    
+    Mat_Discard( matrix ); Mat_Discard( reference );
+  }
+  
+  Mat_Discard( reflectors );
+}
+
+// Reference: known 3-4-5 rotation, and sequences of explicit single rotations
+static void TestGivens( void )
+{
+  const size_t rotationsNumber = 4;
+  double cosine, sine, radius;
+  double cosinesList[ 4 ], sinesList[ 4 ];
+  const char sidesList[ 2 ] = { MATRIX_FROM_LEFT, MATRIX_FROM_RIGHT };
+  
+  Mat_GenerateGivens( 3.0, 4.0, &cosine, &sine, &radius );
+  TEST_CHECK_CLOSE( cosine, 0.6, TOLERANCE );
+  TEST_CHECK_CLOSE( sine, 0.8, TOLERANCE );
+  TEST_CHECK_CLOSE( radius, 5.0, TOLERANCE );
+  Matrix vector = Mat_Create( (double[]){ 3.0, 4.0 }, 2, 1 );
+  TEST_CHECK( Mat_ApplyGivens( vector, (MatrixBlock){ 0, 0, 2, 1 }, MATRIX_FROM_LEFT, 0, 1, cosine, sine ) == vector );
+  TEST_CHECK_CLOSE( Mat_GetElement( vector, 0, 0 ), 5.0, TOLERANCE );
+  TEST_CHECK_CLOSE( Mat_GetElement( vector, 1, 0 ), 0.0, TOLERANCE );
+  
+  for( size_t index = 0; index < rotationsNumber; index++ )
+    Mat_GenerateGivens( 2.0 * rand() / RAND_MAX - 1.0, 2.0 * rand() / RAND_MAX - 1.0, &(cosinesList[ index ]), &(sinesList[ index ]), NULL );
+  for( size_t variant = 0; variant < 4; variant++ )
+  {
+    char side = sidesList[ variant % 2 ];
+    bool isBackward = ( variant >= 2 );
+    Matrix matrix = Test_FillRandom( Mat_Create( NULL, rotationsNumber + 3, rotationsNumber + 3 ), 1.0 );
+    Matrix reference = Mat_Copy( matrix, Mat_Create( NULL, rotationsNumber + 3, rotationsNumber + 3 ) );
+    MatrixBlock target = ( side == MATRIX_FROM_LEFT ) ? (MatrixBlock){ 1, 2, rotationsNumber + 1, 3 } : (MatrixBlock){ 2, 1, 3, rotationsNumber + 1 };
+    
+    TEST_CHECK( Mat_ApplyGivensSequence( matrix, target, side, cosinesList, sinesList, isBackward ) == matrix );
+    for( size_t step = 0; step < rotationsNumber; step++ )
+    {
+      size_t index = isBackward ? rotationsNumber - 1 - step : step;
+      Mat_ApplyGivens( reference, target, side, index, index + 1, cosinesList[ index ], sinesList[ index ] );
+    }
+    TEST_CHECK_CLOSE( Mat_MaxAbsDiff( matrix, reference ), 0.0, TOLERANCE );
+    
+    Mat_Discard( matrix ); Mat_Discard( reference );
+  }
+  
+  Mat_Discard( vector );
+}
+
+int main( void )
+{
+  srand( 1 );
+  
+  TestCreationModes();
+  TestGroups();
+  TestLocking();
+  TestRowsColumns();
+  TestGatherScatter();
+  TestLU();
+  TestComparison();
+  TestReproducible();
+  TestShadowVerification();
+  TestTriangular();
+  TestLDLT();
+  TestQRPivoted();
+  TestGeneralizedEigen();
+  TestPolynomial();
+  TestScans();
+  TestPairwiseSqDist();
+  TestHouseholder();
+  TestHouseholderBlock();
+  TestGivens();
+  
+  return Test_GetResult( "matrix" );
+}
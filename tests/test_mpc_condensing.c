@@ -0,0 +1,131 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include "test_utils.h"
+#include "mpc_condensing.h"
+
+
+#define TOLERANCE 1e-9
+#define STATES_NUMBER 3
+#define INPUTS_NUMBER 2
+#define HORIZON_LENGTH 5
+
+#define STACKED_STATES_NUMBER ( HORIZON_LENGTH * STATES_NUMBER )
+#define STACKED_INPUTS_NUMBER ( HORIZON_LENGTH * INPUTS_NUMBER )
+
+static void SetBlock( Matrix matrix, size_t firstRow, size_t firstColumn, Matrix block )
+{
+  for( size_t row = 0; row < Mat_GetHeight( block ); row++ )
+  {
+    for( size_t column = 0; column < Mat_GetWidth( block ); column++ )
+      Mat_SetElement( matrix, firstRow + row, firstColumn + column, Mat_GetElement( block, row, column ) );
+  }
+}
+
+// Dense references: Phi and Gamma blocks from explicit powers, block diagonal weights, and condensed cost matrices from them
+static void GetReferences( Matrix dynamics, Matrix inputGain, Matrix stateWeight, Matrix terminalWeight, Matrix inputWeight, 
+                           Matrix freeResponse, Matrix forcedResponse, Matrix hessianReference, Matrix gradientReference )
+{
+  Matrix stateWeights = Mat_Create( NULL, STACKED_STATES_NUMBER, STACKED_STATES_NUMBER );
+  Matrix inputWeights = Mat_Create( NULL, STACKED_INPUTS_NUMBER, STACKED_INPUTS_NUMBER );
+  Matrix power = Mat_Create( NULL, STATES_NUMBER, STATES_NUMBER ), powerGain = Mat_Create( NULL, STATES_NUMBER, INPUTS_NUMBER );
+  for( size_t step = 0; step < HORIZON_LENGTH; step++ )
+  {
+    SetBlock( freeResponse, step * STATES_NUMBER, 0, Mat_Power( dynamics, step + 1, power ) );
+    Mat_Dot( Mat_Power( dynamics, step, power ), MATRIX_KEEP, inputGain, MATRIX_KEEP, powerGain );
+    for( size_t input = 0; input + step < HORIZON_LENGTH; input++ )
+      SetBlock( forcedResponse, ( input + step ) * STATES_NUMBER, input * INPUTS_NUMBER, powerGain );
+    SetBlock( stateWeights, step * STATES_NUMBER, step * STATES_NUMBER, ( step == HORIZON_LENGTH - 1 ) ? terminalWeight : stateWeight );
+    SetBlock( inputWeights, step * INPUTS_NUMBER, step * INPUTS_NUMBER, inputWeight );
+  }
+  Matrix weightedResponse = Mat_Dot( stateWeights, MATRIX_KEEP, forcedResponse, MATRIX_KEEP, Mat_Create( NULL, STACKED_STATES_NUMBER, STACKED_INPUTS_NUMBER ) );
+  Mat_Dot( forcedResponse, MATRIX_TRANSPOSE, weightedResponse, MATRIX_KEEP, hessianReference );
+  Mat_Sum( hessianReference, 1.0, inputWeights, 1.0, hessianReference );
+  Mat_Dot( weightedResponse, MATRIX_TRANSPOSE, freeResponse, MATRIX_KEEP, gradientReference );
+  
+  Mat_Discard( stateWeights ); Mat_Discard( inputWeights ); Mat_Discard( power ); Mat_Discard( powerGain ); Mat_Discard( weightedResponse );
+}
+
+int main( void )
+{
+  srand( 1 );
+  
+  Matrix dynamics = Test_FillRandom( Mat_Create( NULL, STATES_NUMBER, STATES_NUMBER ), 0.6 );
+  Matrix inputGain = Test_FillRandom( Mat_Create( NULL, STATES_NUMBER, INPUTS_NUMBER ), 1.0 );
+  Matrix stateWeight = Test_FillPositiveDefinite( Mat_Create( NULL, STATES_NUMBER, STATES_NUMBER ), 0.1 );
+  Matrix terminalWeight = Test_FillPositiveDefinite( Mat_Create( NULL, STATES_NUMBER, STATES_NUMBER ), 1.0 );
+  Matrix inputWeight = Test_FillPositiveDefinite( Mat_Create( NULL, INPUTS_NUMBER, INPUTS_NUMBER ), 0.5 );
+  
+  Matrix freeResponse = Mat_Create( NULL, STACKED_STATES_NUMBER, STATES_NUMBER );
+  Matrix forcedResponse = Mat_Create( NULL, STACKED_STATES_NUMBER, STACKED_INPUTS_NUMBER );
+  Matrix hessianReference = Mat_Create( NULL, STACKED_INPUTS_NUMBER, STACKED_INPUTS_NUMBER );
+  Matrix gradientReference = Mat_Create( NULL, STACKED_INPUTS_NUMBER, STATES_NUMBER );
+  GetReferences( dynamics, inputGain, stateWeight, terminalWeight, inputWeight, freeResponse, forcedResponse, hessianReference, gradientReference );
+  
+  MPCCondensing condensing = MPCCondensing_Create( STATES_NUMBER, INPUTS_NUMBER, HORIZON_LENGTH );
+  TEST_CHECK( condensing != NULL );
+  TEST_CHECK( MPCCondensing_SetModel( condensing, dynamics, inputGain ) );
+  TEST_CHECK( MPCCondensing_SetStateWeights( condensing, stateWeight, terminalWeight ) );
+  TEST_CHECK( MPCCondensing_SetInputWeight( condensing, inputWeight ) );
+  
+  Matrix freeResult = Mat_Create( NULL, STACKED_STATES_NUMBER, STATES_NUMBER );
+  Matrix forcedResult = Mat_Create( NULL, STACKED_STATES_NUMBER, STACKED_INPUTS_NUMBER );
+  Matrix hessian = Mat_Create( NULL, STACKED_INPUTS_NUMBER, STACKED_INPUTS_NUMBER );
+  Matrix gradientMatrix = Mat_Create( NULL, STACKED_INPUTS_NUMBER, STATES_NUMBER );
+  TEST_CHECK( MPCCondensing_GetPrediction( condensing, freeResult, forcedResult ) );
+  TEST_CHECK_CLOSE( Mat_MaxAbsDiff( freeResult, freeResponse ), 0.0, TOLERANCE );
+  TEST_CHECK_CLOSE( Mat_MaxAbsDiff( forcedResult, forcedResponse ), 0.0, TOLERANCE );
+  TEST_CHECK( MPCCondensing_GetHessian( condensing, hessian ) != NULL );
+  TEST_CHECK_CLOSE( Mat_MaxAbsDiff( hessian, hessianReference ), 0.0, TOLERANCE );
+  TEST_CHECK( MPCCondensing_GetGradientMatrix( condensing, gradientMatrix ) != NULL );
+  TEST_CHECK_CLOSE( Mat_MaxAbsDiff( gradientMatrix, gradientReference ), 0.0, TOLERANCE );
+  
+  // Incremental updates after the first requests: a new input weight (only Hessian diagonal blocks change), 
+  // then new state weights (with the stage weight taken as terminal one), each against references rebuilt from scratch
+  Test_FillPositiveDefinite( inputWeight, 2.0 );
+  TEST_CHECK( MPCCondensing_SetInputWeight( condensing, inputWeight ) );
+  GetReferences( dynamics, inputGain, stateWeight, terminalWeight, inputWeight, freeResponse, forcedResponse, hessianReference, gradientReference );
+  TEST_CHECK( MPCCondensing_GetHessian( condensing, hessian ) != NULL );
+  TEST_CHECK_CLOSE( Mat_MaxAbsDiff( hessian, hessianReference ), 0.0, TOLERANCE );
+  TEST_CHECK( MPCCondensing_GetGradientMatrix( condensing, gradientMatrix ) != NULL );
+  TEST_CHECK_CLOSE( Mat_MaxAbsDiff( gradientMatrix, gradientReference ), 0.0, TOLERANCE );
+  Test_FillPositiveDefinite( stateWeight, 0.3 );
+  TEST_CHECK( MPCCondensing_SetStateWeights( condensing, stateWeight, NULL ) );
+  GetReferences( dynamics, inputGain, stateWeight, stateWeight, inputWeight, freeResponse, forcedResponse, hessianReference, gradientReference );
+  TEST_CHECK( MPCCondensing_GetHessian( condensing, hessian ) != NULL );
+  TEST_CHECK_CLOSE( Mat_MaxAbsDiff( hessian, hessianReference ), 0.0, TOLERANCE );
+  TEST_CHECK( MPCCondensing_GetGradientMatrix( condensing, gradientMatrix ) != NULL );
+  TEST_CHECK_CLOSE( Mat_MaxAbsDiff( gradientMatrix, gradientReference ), 0.0, TOLERANCE );
+  
+  // Wrong result dimensions and indefinite weights are rejected
+  TEST_CHECK( MPCCondensing_GetHessian( condensing, gradientMatrix ) == NULL );
+  Mat_SetElement( stateWeight, 0, 0, -1.0 );
+  TEST_CHECK( !MPCCondensing_SetStateWeights( condensing, stateWeight, NULL ) );
+  
+  Mat_Discard( dynamics ); Mat_Discard( inputGain ); Mat_Discard( stateWeight ); Mat_Discard( terminalWeight ); Mat_Discard( inputWeight );
+  Mat_Discard( freeResponse ); Mat_Discard( forcedResponse ); Mat_Discard( hessianReference ); Mat_Discard( gradientReference );
+  Mat_Discard( freeResult ); Mat_Discard( forcedResult ); Mat_Discard( hessian ); Mat_Discard( gradientMatrix );
+  MPCCondensing_Discard( condensing );
+  
+  return Test_GetResult( "mpc_condensing" );
+}
@@ -0,0 +1,120 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include "test_utils.h"
+#include "quadratic_program.h"
+
+
+#define TOLERANCE 1e-5                  // ADMM iterates are only converged up to the solver tolerances
+#define SOLVER_TOLERANCE 1e-9
+#define VARIABLES_NUMBER 6
+#define CONSTRAINTS_NUMBER 2
+
+// Reference: equality constrained minimum from the dense KKT system [ P A^T; A 0 ] [ x; y ] = [ -q; b ]
+static void TestEqualityConstrained( void )
+{
+  const size_t kktSize = VARIABLES_NUMBER + CONSTRAINTS_NUMBER;
+  Matrix hessian = Test_FillPositiveDefinite( Mat_Create( NULL, VARIABLES_NUMBER, VARIABLES_NUMBER ), 0.5 );
+  Matrix gradient = Test_FillRandom( Mat_Create( NULL, VARIABLES_NUMBER, 1 ), 2.0 );
+  Matrix constraints = Test_FillRandom( Mat_Create( NULL, CONSTRAINTS_NUMBER, VARIABLES_NUMBER ), 1.0 );
+  Matrix limits = Test_FillRandom( Mat_Create( NULL, CONSTRAINTS_NUMBER, 1 ), 1.0 );
+  Matrix kkt = Mat_Create( NULL, kktSize, kktSize ), rhs = Mat_Create( NULL, kktSize, 1 ), kktSolution = Mat_Create( NULL, kktSize, 1 );
+  Matrix solution = Mat_Create( NULL, 1, VARIABLES_NUMBER );
+  
+  for( size_t row = 0; row < VARIABLES_NUMBER; row++ )
+  {
+    for( size_t column = 0; column < VARIABLES_NUMBER; column++ )
+      Mat_SetElement( kkt, row, column, Mat_GetElement( hessian, row, column ) );
+    for( size_t constraint = 0; constraint < CONSTRAINTS_NUMBER; constraint++ )
+    {
+      Mat_SetElement( kkt, row, VARIABLES_NUMBER + constraint, Mat_GetElement( constraints, constraint, row ) );
+      Mat_SetElement( kkt, VARIABLES_NUMBER + constraint, row, Mat_GetElement( constraints, constraint, row ) );
+    }
+    Mat_SetElement( rhs, row, 0, -Mat_GetElement( gradient, row, 0 ) );
+  }
+  for( size_t constraint = 0; constraint < CONSTRAINTS_NUMBER; constraint++ )
+    Mat_SetElement( rhs, VARIABLES_NUMBER + constraint, 0, Mat_GetElement( limits, constraint, 0 ) );
+  Mat_Inverse( kkt, kkt );
+  Mat_Dot( kkt, MATRIX_KEEP, rhs, MATRIX_KEEP, kktSolution );
+  
+  QuadraticProgram problem = QuadraticProgram_Create( VARIABLES_NUMBER, CONSTRAINTS_NUMBER );
+  TEST_CHECK( problem != NULL );
+  TEST_CHECK( QuadraticProgram_SetSettings( problem, 0.1, 1.6, SOLVER_TOLERANCE, SOLVER_TOLERANCE, 20000 ) );
+  TEST_CHECK( QuadraticProgram_SetCost( problem, hessian, gradient ) );
+  TEST_CHECK( QuadraticProgram_SetConstraints( problem, constraints, limits, limits ) );
+  TEST_CHECK( QuadraticProgram_Solve( problem, solution ) );
+  TEST_CHECK( Mat_GetHeight( solution ) == 1 );
+  for( size_t variable = 0; variable < VARIABLES_NUMBER; variable++ )
+    TEST_CHECK_CLOSE( Mat_GetElement( solution, 0, variable ), Mat_GetElement( kktSolution, variable, 0 ), TOLERANCE );
+  
+  // Warm started solve of the same problem stays at the solution
+  TEST_CHECK( QuadraticProgram_Solve( problem, solution ) );
+  TEST_CHECK( QuadraticProgram_GetIterationsNumber( problem ) <= 5 );
+  
+  Mat_Discard( hessian ); Mat_Discard( gradient ); Mat_Discard( constraints ); Mat_Discard( limits );
+  Mat_Discard( kkt ); Mat_Discard( rhs ); Mat_Discard( kktSolution ); Mat_Discard( solution );
+  QuadraticProgram_Discard( problem );
+}
+
+// Reference: separable cost, whose bounded minimum is the clipped unconstrained one
+static void TestBounded( void )
+{
+  double curvaturesList[ VARIABLES_NUMBER ] = { 1.0, 2.0, 0.5, 4.0, 1.5, 3.0 };
+  double gradientList[ VARIABLES_NUMBER ] = { -3.0, 1.0, 0.2, -0.5, 2.5, -6.0 };
+  Matrix hessian = Mat_Create( NULL, VARIABLES_NUMBER, VARIABLES_NUMBER );
+  Matrix gradient = Mat_Create( gradientList, VARIABLES_NUMBER, 1 );
+  Matrix lower = Mat_Create( NULL, VARIABLES_NUMBER, 1 ), upper = Mat_Create( NULL, VARIABLES_NUMBER, 1 );
+  Matrix solution = Mat_Create( NULL, VARIABLES_NUMBER, 1 );
+  for( size_t variable = 0; variable < VARIABLES_NUMBER; variable++ )
+  {
+    Mat_SetElement( hessian, variable, variable, curvaturesList[ variable ] );
+    Mat_SetElement( lower, variable, 0, -1.0 );
+    Mat_SetElement( upper, variable, 0, 1.0 );
+  }
+  
+  QuadraticProgram problem = QuadraticProgram_Create( VARIABLES_NUMBER, 0 );
+  TEST_CHECK( problem != NULL );
+  TEST_CHECK( QuadraticProgram_SetSettings( problem, 0.1, 1.6, SOLVER_TOLERANCE, SOLVER_TOLERANCE, 20000 ) );
+  TEST_CHECK( QuadraticProgram_SetCost( problem, hessian, gradient ) );
+  TEST_CHECK( QuadraticProgram_SetBounds( problem, lower, upper ) );
+  TEST_CHECK( !QuadraticProgram_SetBounds( problem, upper, lower ) );
+  TEST_CHECK( QuadraticProgram_Solve( problem, solution ) );
+  for( size_t variable = 0; variable < VARIABLES_NUMBER; variable++ )
+  {
+    double reference = fmin( fmax( -gradientList[ variable ] / curvaturesList[ variable ], -1.0 ), 1.0 );
+    TEST_CHECK_CLOSE( Mat_GetElement( solution, variable, 0 ), reference, TOLERANCE );
+  }
+  
+  Mat_Discard( hessian ); Mat_Discard( gradient ); Mat_Discard( lower ); Mat_Discard( upper ); Mat_Discard( solution );
+  QuadraticProgram_Discard( problem );
+}
+
+int main( void )
+{
+  srand( 1 );
+  
+  TestEqualityConstrained();
+  TestBounded();
+  
+  return Test_GetResult( "quadratic_program" );
+}
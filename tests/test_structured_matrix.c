@@ -0,0 +1,121 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include "test_utils.h"
+#include "structured_matrix.h"
+
+
+#define TOLERANCE 1e-9
+#define SIZE 9
+#define RECTANGULAR_ROWS_NUMBER 7
+#define RIGHT_SIDES_NUMBER 3
+
+// Structure definitions, from generating values
+static double GetReferenceElement( char structure, double* columnValues, double* rowValues, size_t rowsNumber, size_t row, size_t column )
+{
+  if( structure == STRUCTURE_TOEPLITZ ) return ( row >= column ) ? columnValues[ row - column ] : rowValues[ column - row ];
+  else if( structure == STRUCTURE_CIRCULANT ) return columnValues[ ( row + rowsNumber - column ) % rowsNumber ];
+  // Hankel: h[ k ] is first column for k < m and last row (from its first element) for k >= m - 1
+  return ( row + column < rowsNumber ) ? columnValues[ row + column ] : rowValues[ row + column - ( rowsNumber - 1 ) ];
+}
+
+static void TestStructure( char structure, size_t rowsNumber, size_t columnsNumber )
+{
+  double columnValues[ SIZE ], rowValues[ SIZE ];
+  for( size_t index = 0; index < SIZE; index++ )
+  {
+    columnValues[ index ] = 2.0 * rand() / RAND_MAX - 1.0;
+    rowValues[ index ] = 2.0 * rand() / RAND_MAX - 1.0;
+  }
+  // Dominant (anti-)diagonal, for well conditioned leading principal submatrices
+  if( structure == STRUCTURE_HANKEL ) columnValues[ rowsNumber - 1 ] = rowValues[ 0 ] = 2.0 * SIZE;
+  else columnValues[ 0 ] = rowValues[ 0 ] = 2.0 * SIZE;
+  
+  StructuredMatrix matrix = StructuredMatrix_Create( structure, rowsNumber, columnsNumber );
+  TEST_CHECK( matrix != NULL );
+  TEST_CHECK( StructuredMatrix_SetValues( matrix, columnValues, ( structure == STRUCTURE_CIRCULANT ) ? NULL : rowValues ) );
+  TEST_CHECK( StructuredMatrix_GetHeight( matrix ) == rowsNumber && StructuredMatrix_GetWidth( matrix ) == columnsNumber );
+  
+  Matrix dense = StructuredMatrix_ToDense( matrix, Mat_Create( NULL, rowsNumber, columnsNumber ) );
+  TEST_CHECK( dense != NULL );
+  for( size_t row = 0; row < rowsNumber; row++ )
+  {
+    for( size_t column = 0; column < columnsNumber; column++ )
+    {
+      double reference = GetReferenceElement( structure, columnValues, rowValues, rowsNumber, row, column );
+      TEST_CHECK_CLOSE( Mat_GetElement( dense, row, column ), reference, 0.0 );
+      TEST_CHECK_CLOSE( StructuredMatrix_GetElement( matrix, row, column ), reference, 0.0 );
+    }
+  }
+  
+  // Fast products against dense products
+  Matrix input = Test_FillRandom( Mat_Create( NULL, columnsNumber, RIGHT_SIDES_NUMBER ), 1.0 );
+  Matrix result = Mat_Create( NULL, rowsNumber, RIGHT_SIDES_NUMBER ), reference = Mat_Create( NULL, rowsNumber, RIGHT_SIDES_NUMBER );
+  TEST_CHECK( StructuredMatrix_Dot( matrix, MATRIX_KEEP, input, result ) != NULL );
+  Mat_Dot( dense, MATRIX_KEEP, input, MATRIX_KEEP, reference );
+  TEST_CHECK_CLOSE( Mat_MaxAbsDiff( result, reference ), 0.0, TOLERANCE );
+  Matrix transposedInput = Test_FillRandom( Mat_Create( NULL, rowsNumber, RIGHT_SIDES_NUMBER ), 1.0 );
+  Matrix transposedResult = Mat_Create( NULL, columnsNumber, RIGHT_SIDES_NUMBER ), transposedReference = Mat_Create( NULL, columnsNumber, RIGHT_SIDES_NUMBER );
+  TEST_CHECK( StructuredMatrix_Dot( matrix, MATRIX_TRANSPOSE, transposedInput, transposedResult ) != NULL );
+  Mat_Dot( dense, MATRIX_TRANSPOSE, transposedInput, MATRIX_KEEP, transposedReference );
+  TEST_CHECK_CLOSE( Mat_MaxAbsDiff( transposedResult, transposedReference ), 0.0, TOLERANCE );
+  
+  // Fast solves against dense inverse (square matrices only)
+  if( rowsNumber == columnsNumber )
+  {
+    Matrix inverse = Mat_Inverse( dense, Mat_Create( NULL, rowsNumber, rowsNumber ) );
+    TEST_CHECK( StructuredMatrix_Solve( matrix, MATRIX_KEEP, input, result ) != NULL );
+    Mat_Dot( inverse, MATRIX_KEEP, input, MATRIX_KEEP, reference );
+    TEST_CHECK_CLOSE( Mat_MaxAbsDiff( result, reference ), 0.0, TOLERANCE );
+    TEST_CHECK( StructuredMatrix_Solve( matrix, MATRIX_TRANSPOSE, input, result ) != NULL );
+    Mat_Dot( inverse, MATRIX_TRANSPOSE, input, MATRIX_KEEP, reference );
+    TEST_CHECK_CLOSE( Mat_MaxAbsDiff( result, reference ), 0.0, TOLERANCE );
+    // In place solve
+    Mat_Copy( input, result );
+    TEST_CHECK( StructuredMatrix_Solve( matrix, MATRIX_KEEP, result, result ) != NULL );
+    Mat_Dot( dense, MATRIX_KEEP, result, MATRIX_KEEP, reference );
+    TEST_CHECK_CLOSE( Mat_MaxAbsDiff( input, reference ), 0.0, TOLERANCE );
+    Mat_Discard( inverse );
+  }
+  else TEST_CHECK( StructuredMatrix_Solve( matrix, MATRIX_KEEP, input, result ) == NULL );
+  
+  Mat_Discard( dense ); Mat_Discard( input ); Mat_Discard( result ); Mat_Discard( reference );
+  Mat_Discard( transposedInput ); Mat_Discard( transposedResult ); Mat_Discard( transposedReference );
+  StructuredMatrix_Discard( matrix );
+}
+
+int main( void )
+{
+  srand( 1 );
+  
+  TestStructure( STRUCTURE_TOEPLITZ, SIZE, SIZE );
+  TestStructure( STRUCTURE_TOEPLITZ, RECTANGULAR_ROWS_NUMBER, SIZE );
+  TestStructure( STRUCTURE_TOEPLITZ, SIZE, RECTANGULAR_ROWS_NUMBER );
+  TestStructure( STRUCTURE_CIRCULANT, SIZE, SIZE );
+  TestStructure( STRUCTURE_HANKEL, SIZE, SIZE );
+  TestStructure( STRUCTURE_HANKEL, RECTANGULAR_ROWS_NUMBER, SIZE );
+  
+  TEST_CHECK( StructuredMatrix_Create( STRUCTURE_CIRCULANT, SIZE, RECTANGULAR_ROWS_NUMBER ) == NULL );
+  
+  return Test_GetResult( "structured_matrix" );
+}
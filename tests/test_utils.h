@@ -0,0 +1,95 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//                                                                                  //
+//  Copyright (c) 2016-2019 Leonardo Consoni <leonardojc@protonmail.com>            //
+//                                                                                  //
+//  This file is part of Simple Matrix.                                             //
+//                                                                                  //
+//  Simple Matrix is free software: you can redistribute it and/or modify           //
+//  it under the terms of the GNU Lesser General Public License as published        //
+//  by the Free Software Foundation, either version 3 of the License, or            //
+//  (at your option) any later version.                                             //
+//                                                                                  //
+//  Simple Matrix is distributed in the hope that it will be useful,                //
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                    //
+//  GNU Lesser General Public License for more details.                             //
+//                                                                                  //
+//  You should have received a copy of the GNU Lesser General Public License        //
+//  along with Simple Matrix. If not, see <http://www.gnu.org/licenses/>.           //
+//                                                                                  //
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+
+/// @file test_utils.h
+/// @brief Minimal checks shared by module tests, which compare module results against dense (BLAS/LAPACK based) reference computations
+
+#ifndef TEST_UTILS_H
+#define TEST_UTILS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "matrix.h"
+
+static size_t testFailuresNumber = 0;
+
+/// Reports failed condition, with its source location, and keeps running the remaining checks
+#define TEST_CHECK( condition ) \
+  do { if( !( condition ) ) { fprintf( stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition ); testFailuresNumber++; } } while( 0 )
+
+/// Reports difference beyond given absolute tolerance (non-finite values always fail)
+#define TEST_CHECK_CLOSE( value, reference, tolerance ) \
+  do { double _difference = fabs( (double) ( value ) - (double) ( reference ) ); \
+       if( !( _difference <= ( tolerance ) ) ) { fprintf( stderr, "%s:%d: %s = %g differs from %s = %g by %g\n", __FILE__, __LINE__, \
+                                                          #value, (double) ( value ), #reference, (double) ( reference ), _difference ); \
+                                                 testFailuresNumber++; } } while( 0 )
+
+/// @brief Fills matrix with reproducible pseudo-random values in [ -scale, scale ]
+static inline Matrix Test_FillRandom( Matrix matrix, double scale )
+{
+  for( size_t column = 0; column < Mat_GetWidth( matrix ); column++ )
+  {
+    for( size_t row = 0; row < Mat_GetHeight( matrix ); row++ )
+      Mat_SetElement( matrix, row, column, scale * ( 2.0 * rand() / RAND_MAX - 1.0 ) );
+  }
+  return matrix;
+}
+
+/// @brief Fills square matrix with reproducible symmetric positive definite values (B^T B + shift I)
+static inline Matrix Test_FillPositiveDefinite( Matrix matrix, double shift )
+{
+  size_t size = Mat_GetHeight( matrix );
+  Matrix base = Test_FillRandom( Mat_Create( NULL, size, size ), 1.0 );
+  Mat_Dot( base, MATRIX_TRANSPOSE, base, MATRIX_KEEP, matrix );
+  for( size_t line = 0; line < size; line++ )
+    Mat_SetElement( matrix, line, line, Mat_GetElement( matrix, line, line ) + shift );
+  Mat_Discard( base );
+  return matrix;
+}
+
+/// @brief Gets largest absolute difference between elements of 2 matrices, read one by one (INFINITY if dimensions differ)
+static inline double Test_GetMaxDifference( Matrix matrix, Matrix reference )
+{
+  if( Mat_GetHeight( matrix ) != Mat_GetHeight( reference ) || Mat_GetWidth( matrix ) != Mat_GetWidth( reference ) ) return INFINITY;
+  
+  double maxDifference = 0.0;
+  for( size_t column = 0; column < Mat_GetWidth( matrix ); column++ )
+  {
+    for( size_t row = 0; row < Mat_GetHeight( matrix ); row++ )
+      maxDifference = fmax( maxDifference, fabs( Mat_GetElement( matrix, row, column ) - Mat_GetElement( reference, row, column ) ) );
+  }
+  return maxDifference;
+}
+
+/// @brief Prints summary and gets process exit code
+static inline int Test_GetResult( const char* testName )
+{
+  if( testFailuresNumber > 0 ) fprintf( stderr, "%s: %lu failed checks\n", testName, (unsigned long) testFailuresNumber );
+  else printf( "%s: passed\n", testName );
+  
+  return ( testFailuresNumber > 0 ) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+#endif // TEST_UTILS_H